@@ -0,0 +1,500 @@
+/**
+ * Benchmarks de EmployeeManager con salida JSON
+ * Uso: benchmark [--json salida.json] [--hilos N] [--tiempo-min S] archivo...
+ *
+ * Arnés mínimo al estilo de Google Benchmark: cada caso se repite hasta
+ * superar un tiempo mínimo y se informa el tiempo real y de CPU por
+ * iteración. El JSON usa el mismo esquema ("context" + "benchmarks") para
+ * que las herramientas de comparación de Google Benchmark puedan leerlo.
+ *
+ * Cada archivo de datos se copia a <archivo>.trabajo, así los casos que
+ * guardan o borran no modifican los datos generados.
+ */
+#include "EmployeeManager.h"
+#include "SalaryKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Descarta lo que EmployeeManager escribe por consola durante las mediciones
+class SalidaNula : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+class Silencio {
+public:
+    Silencio() : anteriorOut(std::cout.rdbuf(&nula)), anteriorErr(std::cerr.rdbuf(&nula)) {}
+    ~Silencio() {
+        std::cout.rdbuf(anteriorOut);
+        std::cerr.rdbuf(anteriorErr);
+    }
+
+private:
+    SalidaNula nula;
+    std::streambuf* anteriorOut;
+    std::streambuf* anteriorErr;
+};
+
+/**
+ * Estado de una ejecución, como benchmark::State: el bucle
+ * `while (estado.seguir())` se repite 'iteraciones' veces y solo se mide
+ * desde la primera llamada a seguir(), fuera de pausar()/reanudar().
+ */
+class Estado {
+public:
+    explicit Estado(long long iteraciones) : restantes(iteraciones) {}
+
+    bool seguir() {
+        if (restantes-- > 0) {
+            if (!midiendo) reanudar();
+            return true;
+        }
+        pausar();
+        return false;
+    }
+
+    void pausar() {
+        if (!midiendo) return;
+        real += std::chrono::steady_clock::now() - inicioReal;
+        cpu += std::clock() - inicioCpu;
+        midiendo = false;
+    }
+
+    void reanudar() {
+        inicioReal = std::chrono::steady_clock::now();
+        inicioCpu = std::clock();
+        midiendo = true;
+    }
+
+    void setElementosProcesados(long long n) { elementos = n; }
+
+    double segundosReales() const { return std::chrono::duration<double>(real).count(); }
+    double segundosCpu() const { return static_cast<double>(cpu) / CLOCKS_PER_SEC; }
+    long long getElementos() const { return elementos; }
+
+private:
+    long long restantes;
+    bool midiendo = false;
+    std::chrono::steady_clock::time_point inicioReal;
+    std::chrono::steady_clock::duration real{};
+    std::clock_t inicioCpu = 0;
+    std::clock_t cpu = 0;
+    long long elementos = 0;
+};
+
+struct Resultado {
+    std::string nombre;
+    long long filas;
+    long long iteraciones;
+    double nsRealPorIteracion;
+    double nsCpuPorIteracion;
+    double elementosPorSegundo;
+};
+
+struct Caso {
+    std::string nombre;
+    std::function<void(Estado&)> funcion;
+};
+
+double tiempoMinimo = 0.5;
+
+// Como Google Benchmark: duplica (o más) las iteraciones hasta superar el tiempo mínimo
+Resultado ejecutar(const Caso& caso, long long filas) {
+    long long iteraciones = 1;
+    while (true) {
+        Estado estado(iteraciones);
+        caso.funcion(estado);
+        double segundos = estado.segundosReales();
+        if (segundos >= tiempoMinimo || iteraciones >= 1000000000) {
+            double porIteracion = segundos / iteraciones;
+            return {caso.nombre, filas, iteraciones, porIteracion * 1e9,
+                    estado.segundosCpu() / iteraciones * 1e9,
+                    estado.getElementos() > 0 && segundos > 0 ? estado.getElementos() / segundos : 0.0};
+        }
+        double factor = segundos > 0 ? tiempoMinimo * 1.4 / segundos : 10.0;
+        iteraciones = static_cast<long long>(iteraciones * std::min(std::max(factor, 2.0), 10.0));
+    }
+}
+
+// Generador xorshift64 con semilla fija: todas las ejecuciones usan los mismos IDs
+uint64_t siguienteAleatorio(uint64_t& x) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+}
+
+// IDs pseudoaleatorios reproducibles en [1, maximo], con repeticiones
+std::vector<int> idsAleatorios(std::size_t cantidad, int maximo) {
+    std::vector<int> ids(cantidad);
+    uint64_t x = 88172645463325252ull;
+    for (int& id : ids) {
+        id = 1 + static_cast<int>(siguienteAleatorio(x) % static_cast<uint64_t>(maximo));
+    }
+    return ids;
+}
+
+// 'cantidad' IDs distintos de [1, maximo] (Fisher-Yates parcial)
+std::vector<int> idsDistintos(std::size_t cantidad, int maximo) {
+    std::vector<int> todos(static_cast<std::size_t>(maximo));
+    for (int i = 0; i < maximo; ++i) todos[i] = i + 1;
+    uint64_t x = 88172645463325252ull;
+    for (std::size_t i = 0; i < cantidad; ++i) {
+        std::size_t j = i + siguienteAleatorio(x) % (todos.size() - i);
+        std::swap(todos[i], todos[j]);
+    }
+    todos.resize(cantidad);
+    return todos;
+}
+
+void copiar(const std::string& origen, const std::string& destino) {
+    std::filesystem::copy_file(origen, destino, std::filesystem::copy_options::overwrite_existing);
+}
+
+std::vector<Caso> casosPara(const std::string& datos, const std::string& trabajo, unsigned hilos) {
+    std::vector<Caso> casos;
+
+    casos.push_back({"cargar", [=](Estado& estado) {
+        Silencio silencio;
+        long long filas = 0;
+        while (estado.seguir()) {
+            estado.pausar();
+            copiar(datos, trabajo);
+            estado.reanudar();
+            auto m = std::make_unique<EmployeeManager>(trabajo, hilos);
+            estado.pausar();
+            filas += m->getCantidadEmpleados();
+            m.reset();
+            estado.reanudar();
+        }
+        estado.setElementosProcesados(filas);
+    }});
+
+    casos.push_back({"guardar", [=](Estado& estado) {
+        Silencio silencio;
+        copiar(datos, trabajo);
+        EmployeeManager m(trabajo, hilos);
+        long long filas = 0;
+        while (estado.seguir()) {
+            m.guardarEnArchivo();
+            filas += m.getCantidadEmpleados();
+        }
+        estado.setElementosProcesados(filas);
+    }});
+
+    // Lo que el hilo principal espera al pedir un guardado: solo fijar la versión.
+    // Cada petición es un guardado completo: antes se cambia un salario y se
+    // espera al anterior (sin medir), para que no se combine con él. Los
+    // elementos son guardados pedidos, no filas: las escribe otro hilo
+    casos.push_back({"guardar_segundo_plano", [=](Estado& estado) {
+        Silencio silencio;
+        copiar(datos, trabajo);
+        EmployeeManager m(trabajo, hilos);
+        const std::vector<int> ids = idsDistintos(std::min(1000, m.getCantidadEmpleados()), m.getCantidadEmpleados());
+        long long guardados = 0;
+        while (estado.seguir()) {
+            estado.pausar();
+            m.esperarGuardado();
+            m.salarioSinAviso(ids[guardados % ids.size()], 1000.0 + static_cast<double>(guardados % 7));
+            estado.reanudar();
+            m.guardarEnSegundoPlano();
+            ++guardados;
+        }
+        m.esperarGuardado();
+        estado.setElementosProcesados(guardados);
+    }});
+
+    casos.push_back({"buscar_id", [=](Estado& estado) {
+        Silencio silencio;
+        const std::size_t CONSULTAS = 1 << 20;
+        copiar(datos, trabajo);
+        EmployeeManager m(trabajo, hilos);
+        std::vector<int> ids = idsAleatorios(CONSULTAS, m.getCantidadEmpleados());
+        long long encontrados = 0;
+        long long consultas = 0;
+        while (estado.seguir()) {
+            for (int id : ids) encontrados += m.getEmpleado(id) != nullptr;
+            consultas += CONSULTAS;
+        }
+        estado.setElementosProcesados(consultas);
+        if (encontrados < 0) std::abort();   // evita que el bucle se optimice
+    }});
+
+    casos.push_back({"buscar_nombre", [=](Estado& estado) {
+        Silencio silencio;
+        // Nombres del generador con erratas, sin acentos o con un solo prefijo
+        const char* CONSULTAS[] = {"maria garcia", "Gonzales", "lucia perz", "alvaro", "Hernandes Diaz",
+                                   "jsoe", "mar gar", "Sanches", "pablo muñoz", "irene"};
+        copiar(datos, trabajo);
+        EmployeeManager m(trabajo, hilos);
+        long long encontrados = 0;
+        long long consultas = 0;
+        while (estado.seguir()) {
+            for (const char* consulta : CONSULTAS) encontrados += m.buscarPorNombre(consulta).size();
+            consultas += sizeof(CONSULTAS) / sizeof(CONSULTAS[0]);
+        }
+        estado.setElementosProcesados(consultas);
+        if (encontrados < 0) std::abort();
+    }});
+
+    casos.push_back({"jerarquia", [=](Estado& estado) {
+        Silencio silencio;
+        copiar(datos, trabajo);
+        EmployeeManager m(trabajo, hilos);
+        const int total = m.getCantidadEmpleados();
+        std::vector<int> managers;
+        for (int id = 1; id <= total; ++id) {
+            const Employee* emp = m.getEmpleado(id);
+            if (emp && emp->getComponentesSalario().tipo == TipoEmpleado::Manager) managers.push_back(id);
+        }
+        if (managers.empty()) return;
+        const std::vector<int> ids = idsDistintos(std::min(100000, total), total);
+        // Por cada elemento: la rama de un manager y un cambio de jefe (los que
+        // cerrarían un ciclo se rechazan, pero también recorren la jerarquía)
+        std::string error;
+        double nomina = 0;
+        long long operaciones = 0;
+        std::size_t i = 0;
+        while (estado.seguir()) {
+            for (int k = 0; k < 1000; ++k, ++i) {
+                const int jefe = managers[i % managers.size()];
+                nomina += m.rama(jefe).nomina;
+                m.cambiarJefe(ids[i % ids.size()], jefe, error);
+            }
+            operaciones += 1000;
+        }
+        estado.setElementosProcesados(operaciones);
+        if (nomina < 0) std::abort();
+    }});
+
+    casos.push_back({"eliminar", [=](Estado& estado) {
+        Silencio silencio;
+        long long borrados = 0;
+        while (estado.seguir()) {
+            estado.pausar();
+            copiar(datos, trabajo);
+            auto m = std::make_unique<EmployeeManager>(trabajo, hilos);
+            const std::size_t cantidad = std::min<std::size_t>(100000, m->getCantidadEmpleados() / 2);
+            std::vector<int> ids = idsDistintos(cantidad, m->getCantidadEmpleados());
+            estado.reanudar();
+            for (int id : ids) borrados += m->eliminarEmpleado(id);
+            estado.pausar();
+            m.reset();
+            estado.reanudar();
+        }
+        estado.setElementosProcesados(borrados);
+    }});
+
+    casos.push_back({"nomina_total", [=](Estado& estado) {
+        Silencio silencio;
+        copiar(datos, trabajo);
+        EmployeeManager m(trabajo, hilos);
+        double total = 0;
+        long long filas = 0;
+        while (estado.seguir()) {
+            total += m.recalcularNominaTotal();
+            filas += m.getCantidadEmpleados();
+        }
+        estado.setElementosProcesados(filas);
+        if (total < 0) std::abort();
+    }});
+
+    // Un cambio de salario seguido de la consulta de nómina (total mantenido)
+    casos.push_back({"nomina_tras_cambio", [=](Estado& estado) {
+        Silencio silencio;
+        const std::size_t CAMBIOS = 1 << 16;
+        copiar(datos, trabajo);
+        EmployeeManager m(trabajo, hilos);
+        std::vector<int> ids = idsAleatorios(CAMBIOS, m.getCantidadEmpleados());
+        double total = 0;
+        long long consultas = 0;
+        while (estado.seguir()) {
+            for (std::size_t i = 0; i < ids.size(); ++i) {
+                m.salarioSinAviso(ids[i], 2000.0 + static_cast<double>(i % 4000));
+                total += m.calcularNominaTotal();
+            }
+            consultas += CAMBIOS;
+        }
+        estado.setElementosProcesados(consultas);
+        if (total < 0) std::abort();
+    }});
+
+    casos.push_back({"aumento_masivo", [=](Estado& estado) {
+        Silencio silencio;
+        copiar(datos, trabajo);
+        EmployeeManager m(trabajo, hilos);
+        SeleccionEmpleados seleccion;
+        seleccion.porTipo = true;
+        seleccion.tipo = TipoEmpleado::Developer;
+        CambioMasivo cambio;
+        cambio.valor = 1.0;
+        long long cambios = 0;
+        while (estado.seguir()) {
+            cambios += static_cast<long long>(m.actualizarMasivo(seleccion, cambio));
+        }
+        estado.setElementosProcesados(cambios);
+    }});
+
+    // Cambios mientras un informe retiene una versión: cada bloque tocado se copia una vez
+    casos.push_back({"cambio_con_version_fijada", [=](Estado& estado) {
+        Silencio silencio;
+        const std::size_t CAMBIOS = 1 << 16;
+        copiar(datos, trabajo);
+        EmployeeManager m(trabajo, hilos);
+        std::vector<int> ids = idsAleatorios(CAMBIOS, m.getCantidadEmpleados());
+        long long cambios = 0;
+        while (estado.seguir()) {
+            VersionedStore::Instantanea version = m.fijarVersion();
+            for (std::size_t i = 0; i < ids.size(); ++i) {
+                m.salarioSinAviso(ids[i], 2000.0 + static_cast<double>(i % 4000));
+            }
+            if (EmployeeManager::nominaDe(version) < 0) std::abort();
+            cambios += CAMBIOS;
+        }
+        estado.setElementosProcesados(cambios);
+    }});
+
+    casos.push_back({"informe_departamentos", [=](Estado& estado) {
+        Silencio silencio;
+        copiar(datos, trabajo);
+        EmployeeManager m(trabajo, hilos);
+        long long filas = 0;
+        std::size_t grupos = 0;
+        while (estado.seguir()) {
+            m.empleadosPorDepartamento();
+            grupos += m.estadisticasPorDepartamento().size();
+            filas += m.getCantidadEmpleados();
+        }
+        estado.setElementosProcesados(filas);
+        if (grupos == 0 && filas > 0) std::abort();
+    }});
+
+    casos.push_back({"listado_csv", [=](Estado& estado) {
+        Silencio silencio;
+        copiar(datos, trabajo);
+        EmployeeManager m(trabajo, hilos);
+        std::FILE* nulo = std::fopen("/dev/null", "wb");
+        if (!nulo) std::abort();
+        long long filas = 0;
+        while (estado.seguir()) {
+            ReportWriter informe(nulo, FormatoInforme::Csv);
+            informe.empezar();
+            m.escribirInforme(informe);
+            informe.terminar();
+            filas += static_cast<long long>(informe.getFilas());
+        }
+        std::fclose(nulo);
+        estado.setElementosProcesados(filas);
+    }});
+
+    return casos;
+}
+
+void escribirJson(std::FILE* f, const std::vector<Resultado>& resultados, unsigned hilos) {
+    char fecha[64];
+    std::time_t ahora = std::time(nullptr);
+    std::strftime(fecha, sizeof(fecha), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&ahora));
+
+    std::fprintf(f, "{\n  \"context\": {\n");
+    std::fprintf(f, "    \"date\": \"%s\",\n", fecha);
+    std::fprintf(f, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+    std::fprintf(f, "    \"hilos\": %u,\n", hilos);
+    std::fprintf(f, "    \"simd\": \"%s\",\n", kernels::nombreNivel(kernels::nivelActivo()));
+#ifdef __OPTIMIZE__
+    std::fprintf(f, "    \"library_build_type\": \"release\"\n");
+#else
+    std::fprintf(f, "    \"library_build_type\": \"debug\"\n");
+#endif
+    std::fprintf(f, "  },\n  \"benchmarks\": [\n");
+    for (std::size_t i = 0; i < resultados.size(); ++i) {
+        const Resultado& r = resultados[i];
+        std::fprintf(f, "    {\n");
+        std::fprintf(f, "      \"name\": \"%s/%lld\",\n", r.nombre.c_str(), r.filas);
+        std::fprintf(f, "      \"run_name\": \"%s/%lld\",\n", r.nombre.c_str(), r.filas);
+        std::fprintf(f, "      \"run_type\": \"iteration\",\n");
+        std::fprintf(f, "      \"filas\": %lld,\n", r.filas);
+        std::fprintf(f, "      \"iterations\": %lld,\n", r.iteraciones);
+        std::fprintf(f, "      \"real_time\": %.17g,\n", r.nsRealPorIteracion);
+        std::fprintf(f, "      \"cpu_time\": %.17g,\n", r.nsCpuPorIteracion);
+        std::fprintf(f, "      \"time_unit\": \"ns\"");
+        if (r.elementosPorSegundo > 0) {
+            std::fprintf(f, ",\n      \"items_per_second\": %.17g", r.elementosPorSegundo);
+        }
+        std::fprintf(f, "\n    }%s\n", i + 1 < resultados.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string rutaJson;
+    unsigned hilos = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> archivos;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            rutaJson = argv[++i];
+        } else if (arg == "--hilos" && i + 1 < argc) {
+            hilos = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (arg == "--tiempo-min" && i + 1 < argc) {
+            tiempoMinimo = std::stod(argv[++i]);
+        } else {
+            archivos.push_back(arg);
+        }
+    }
+    if (archivos.empty()) {
+        std::fprintf(stderr, "Uso: %s [--json salida.json] [--hilos N] [--tiempo-min S] archivo...\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<Resultado> resultados;
+    std::printf("%-36s %14s %14s %12s %16s\n", "Benchmark", "Tiempo", "CPU", "Iteraciones", "Elementos/s");
+    for (const std::string& datos : archivos) {
+        const std::string trabajo = datos + ".trabajo";
+        long long filas;
+        {
+            Silencio silencio;
+            copiar(datos, trabajo);
+            filas = EmployeeManager(trabajo, 1).getCantidadEmpleados();
+        }
+
+        for (const Caso& caso : casosPara(datos, trabajo, hilos)) {
+            Resultado r = ejecutar(caso, filas);
+            std::printf("%-36s %11.0f ns %11.0f ns %12lld %16.0f\n",
+                        (r.nombre + "/" + std::to_string(filas)).c_str(), r.nsRealPorIteracion,
+                        r.nsCpuPorIteracion, r.iteraciones, r.elementosPorSegundo);
+            std::fflush(stdout);
+            resultados.push_back(r);
+        }
+        std::filesystem::remove(trabajo);
+    }
+
+    if (!rutaJson.empty()) {
+        std::FILE* f = std::fopen(rutaJson.c_str(), "w");
+        if (!f) {
+            std::fprintf(stderr, "No se pudo crear %s\n", rutaJson.c_str());
+            return 1;
+        }
+        escribirJson(f, resultados, hilos);
+        std::fclose(f);
+        std::printf("Resultados JSON en %s\n", rutaJson.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,294 @@
+/**
+ * Cliente de carga para el servidor de consultas (--servidor)
+ * Uso: cliente (--unix RUTA | --tcp PUERTO) [--conexiones C] [--profundidad P]
+ *              [--segundos S] [--lecturas PCT]
+ *
+ * Abre C conexiones, cada una en su hilo, y mantiene P peticiones en vuelo
+ * en cada una (canalización). Un PCT% son BUSCAR y el resto SALARIO sobre
+ * IDs aleatorios. Mide la latencia de cada petición, desde que se escribe
+ * hasta que llega su respuesta, e informa del rendimiento y de los
+ * percentiles p50/p90/p99/p99.9.
+ */
+#include "Protocol.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Reloj = std::chrono::steady_clock;
+
+struct Opciones {
+    std::string rutaUnix;
+    int puerto = 0;
+    unsigned conexiones = 4;
+    unsigned profundidad = 16;
+    double segundos = 5.0;
+    unsigned lecturas = 90;
+};
+
+struct Resultado {
+    std::vector<uint32_t> latenciasNs;
+    uint64_t lecturas = 0;
+    uint64_t escrituras = 0;
+    uint64_t noEncontrados = 0;
+    uint64_t invalidas = 0;
+    bool fallo = false;
+};
+
+uint64_t siguienteAleatorio(uint64_t& x) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+}
+
+#ifdef __linux__
+
+int conectar(const Opciones& o) {
+    int fd = -1;
+    if (!o.rutaUnix.empty()) {
+        sockaddr_un dir{};
+        dir.sun_family = AF_UNIX;
+        if (o.rutaUnix.size() >= sizeof(dir.sun_path)) return -1;
+        o.rutaUnix.copy(dir.sun_path, o.rutaUnix.size());
+        fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir)) != 0) {
+            ::close(fd);
+            return -1;
+        }
+    } else {
+        sockaddr_in dir{};
+        dir.sin_family = AF_INET;
+        dir.sin_port = htons(static_cast<uint16_t>(o.puerto));
+        dir.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir)) != 0) {
+            ::close(fd);
+            return -1;
+        }
+        int uno = 1;
+        if (fd >= 0) ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+    }
+    return fd;
+}
+
+bool enviarTodo(int fd, const std::string& datos) {
+    std::size_t enviado = 0;
+    while (enviado < datos.size()) {
+        ssize_t n = ::send(fd, datos.data() + enviado, datos.size() - enviado, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        enviado += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+// Lee de 'fd' y llama a alResponder(estado, datos) por cada respuesta completa
+class LectorTramas {
+public:
+    explicit LectorTramas(int fd) : fd(fd) {}
+
+    template <typename F>
+    bool leer(F&& alResponder) {
+        char buffer[64 * 1024];
+        ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) return false;
+        pendiente.append(buffer, static_cast<std::size_t>(n));
+
+        std::size_t pos = 0;
+        while (pendiente.size() - pos >= protocolo::CABECERA) {
+            uint32_t longitud = protocolo::decodificarU32(pendiente.data() + pos);
+            if (longitud == 0 || longitud > protocolo::TRAMA_MAXIMA) return false;
+            if (pendiente.size() - pos < protocolo::CABECERA + longitud) break;
+            std::string_view trama(pendiente.data() + pos + protocolo::CABECERA, longitud);
+            alResponder(static_cast<protocolo::Estado>(trama[0]), trama.substr(1));
+            pos += protocolo::CABECERA + longitud;
+        }
+        pendiente.erase(0, pos);
+        return true;
+    }
+
+private:
+    int fd;
+    std::string pendiente;
+};
+
+// Petición síncrona para preparar la prueba (NOMINA: cuántos empleados hay)
+bool consultarEmpleados(const Opciones& o, uint32_t& empleados) {
+    int fd = conectar(o);
+    if (fd < 0) return false;
+    std::string peticion;
+    protocolo::cerrarTrama(peticion, protocolo::abrirTrama(peticion, static_cast<uint8_t>(protocolo::Operacion::Nomina)));
+
+    bool respondido = false;
+    bool ok = enviarTodo(fd, peticion);
+    LectorTramas lector(fd);
+    while (ok && !respondido) {
+        ok = lector.leer([&](protocolo::Estado estado, std::string_view datos) {
+            double total = 0;
+            respondido = true;
+            ok = estado == protocolo::Estado::Ok && protocolo::leerF64(datos, total) &&
+                 protocolo::leerU32(datos, empleados);
+        });
+    }
+    ::close(fd);
+    return ok && respondido;
+}
+
+void anadirPeticion(std::string& d, uint64_t& x, uint32_t maximoId, unsigned pctLecturas, Resultado& r) {
+    uint64_t aleatorio = siguienteAleatorio(x);
+    int32_t id = 1 + static_cast<int32_t>((aleatorio >> 8) % maximoId);
+    if (aleatorio % 100 < pctLecturas) {
+        std::size_t inicio = protocolo::abrirTrama(d, static_cast<uint8_t>(protocolo::Operacion::Buscar));
+        protocolo::anadirU32(d, static_cast<uint32_t>(id));
+        protocolo::cerrarTrama(d, inicio);
+        ++r.lecturas;
+    } else {
+        std::size_t inicio = protocolo::abrirTrama(d, static_cast<uint8_t>(protocolo::Operacion::Salario));
+        protocolo::anadirU32(d, static_cast<uint32_t>(id));
+        protocolo::anadirF64(d, 2000.0 + static_cast<double>(aleatorio % 4000));
+        protocolo::cerrarTrama(d, inicio);
+        ++r.escrituras;
+    }
+}
+
+void trabajar(const Opciones& o, unsigned hilo, uint32_t maximoId, const std::atomic<bool>& parar, Resultado& r) {
+    int fd = conectar(o);
+    if (fd < 0) {
+        r.fallo = true;
+        return;
+    }
+    uint64_t x = 0x9E3779B97F4A7C15ull * (hilo + 1);
+
+    // Anillo con el instante de envío de cada petición en vuelo, en orden
+    std::vector<Reloj::time_point> envios(o.profundidad);
+    std::size_t cabeza = 0;
+    std::size_t enVuelo = 0;
+    std::string salida;
+
+    auto rellenar = [&]() {
+        salida.clear();
+        const auto ahora = Reloj::now();
+        while (enVuelo < o.profundidad) {
+            anadirPeticion(salida, x, maximoId, o.lecturas, r);
+            envios[(cabeza + enVuelo) % o.profundidad] = ahora;
+            ++enVuelo;
+        }
+        return salida.empty() || enviarTodo(fd, salida);
+    };
+
+    LectorTramas lector(fd);
+    bool ok = rellenar();
+    while (ok && (enVuelo > 0)) {
+        ok = lector.leer([&](protocolo::Estado estado, std::string_view) {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Reloj::now() - envios[cabeza]).count();
+            r.latenciasNs.push_back(static_cast<uint32_t>(std::min<int64_t>(ns, UINT32_MAX)));
+            if (estado == protocolo::Estado::NoEncontrado) ++r.noEncontrados;
+            else if (estado == protocolo::Estado::Invalida) ++r.invalidas;
+            cabeza = (cabeza + 1) % o.profundidad;
+            --enVuelo;
+        });
+        // Al parar solo se esperan las respuestas que faltan
+        if (ok && !parar.load(std::memory_order_relaxed)) ok = rellenar();
+    }
+    r.fallo = !ok;
+    ::close(fd);
+}
+
+#endif // __linux__
+
+bool leerOpciones(int argc, char* argv[], Opciones& o) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--unix") o.rutaUnix = argv[i + 1];
+        else if (arg == "--tcp") o.puerto = std::atoi(argv[i + 1]);
+        else if (arg == "--conexiones") o.conexiones = static_cast<unsigned>(std::atoi(argv[i + 1]));
+        else if (arg == "--profundidad") o.profundidad = static_cast<unsigned>(std::atoi(argv[i + 1]));
+        else if (arg == "--segundos") o.segundos = std::atof(argv[i + 1]);
+        else if (arg == "--lecturas") o.lecturas = static_cast<unsigned>(std::atoi(argv[i + 1]));
+        else return false;
+    }
+    return argc % 2 == 1 && (o.rutaUnix.empty() != (o.puerto == 0)) && o.puerto >= 0 && o.puerto < 65536 &&
+           o.conexiones > 0 && o.profundidad > 0 && o.segundos > 0 && o.lecturas <= 100;
+}
+
+double percentil(const std::vector<uint32_t>& ordenadas, double p) {
+    if (ordenadas.empty()) return 0.0;
+    std::size_t i = static_cast<std::size_t>(p * static_cast<double>(ordenadas.size() - 1) + 0.5);
+    return ordenadas[i] / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Opciones o;
+    if (!leerOpciones(argc, argv, o)) {
+        std::fprintf(stderr,
+                     "Uso: %s (--unix RUTA | --tcp PUERTO) [--conexiones C] [--profundidad P]\n"
+                     "          [--segundos S] [--lecturas PCT]\n",
+                     argv[0]);
+        return 1;
+    }
+#ifdef __linux__
+    uint32_t empleados = 0;
+    if (!consultarEmpleados(o, empleados) || empleados == 0) {
+        std::fprintf(stderr, "No se pudo consultar el servidor o no tiene empleados\n");
+        return 1;
+    }
+    std::printf("%u empleados, %u conexiones x %u en vuelo, %u%% lecturas, %.1f s\n\n", empleados,
+                o.conexiones, o.profundidad, o.lecturas, o.segundos);
+
+    std::atomic<bool> parar{false};
+    std::vector<Resultado> resultados(o.conexiones);
+    std::vector<std::thread> hilos;
+    auto inicio = Reloj::now();
+    for (unsigned h = 0; h < o.conexiones; ++h) {
+        hilos.emplace_back([&, h]() { trabajar(o, h, empleados, parar, resultados[h]); });
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(o.segundos));
+    parar = true;
+    for (std::thread& t : hilos) t.join();
+    double segundos = std::chrono::duration<double>(Reloj::now() - inicio).count();
+
+    Resultado total;
+    for (Resultado& r : resultados) {
+        total.latenciasNs.insert(total.latenciasNs.end(), r.latenciasNs.begin(), r.latenciasNs.end());
+        total.lecturas += r.lecturas;
+        total.escrituras += r.escrituras;
+        total.noEncontrados += r.noEncontrados;
+        total.invalidas += r.invalidas;
+        total.fallo = total.fallo || r.fallo;
+    }
+    std::sort(total.latenciasNs.begin(), total.latenciasNs.end());
+
+    std::printf("Peticiones:     %zu (%llu lecturas, %llu escrituras)\n", total.latenciasNs.size(),
+                static_cast<unsigned long long>(total.lecturas), static_cast<unsigned long long>(total.escrituras));
+    std::printf("Rendimiento:    %.0f peticiones/s\n", total.latenciasNs.size() / segundos);
+    std::printf("No encontrados: %llu   Inválidas: %llu\n", static_cast<unsigned long long>(total.noEncontrados),
+                static_cast<unsigned long long>(total.invalidas));
+    std::printf("\nLatencia (µs):  p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  máx. %.1f\n",
+                percentil(total.latenciasNs, 0.50), percentil(total.latenciasNs, 0.90),
+                percentil(total.latenciasNs, 0.99), percentil(total.latenciasNs, 0.999),
+                percentil(total.latenciasNs, 1.0));
+    if (total.fallo) std::fprintf(stderr, "\nAlguna conexión se cerró antes de tiempo\n");
+    return total.fallo ? 1 : 0;
+#else
+    std::fprintf(stderr, "El cliente solo está disponible en Linux\n");
+    return 1;
+#endif
+}
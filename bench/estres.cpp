@@ -0,0 +1,167 @@
+/**
+ * Prueba de estrés de ConcurrentEmployeeManager
+ * Uso: estres [--filas N] [--segundos S] [--hilos-max T] [--fragmentos F]
+ *
+ * Con 1, 2, 4... hasta T hilos, cada hilo ejecuta durante S segundos una
+ * mezcla 90/10: 90% búsquedas por ID y 10% escrituras (8% cambios de
+ * salario, 1% altas, 1% bajas). Se informa el rendimiento total y de
+ * lectura y el escalado respecto a un hilo. Al final comprueba que la
+ * cantidad de empleados cuadra con las altas y bajas realizadas.
+ */
+#include "ConcurrentEmployeeManager.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Opciones {
+    int filas = 1000000;
+    double segundos = 2.0;
+    unsigned hilosMax = 0;   // 0 = 2 x núcleos
+    unsigned fragmentos = 64;
+};
+
+struct Contadores {
+    uint64_t lecturas = 0;
+    uint64_t escrituras = 0;
+    uint64_t altas = 0;
+    uint64_t bajas = 0;
+    uint64_t checksum = 0;
+};
+
+uint64_t siguienteAleatorio(uint64_t& x) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+}
+
+void poblar(ConcurrentEmployeeManager& m, int filas) {
+    const char* departamentos[] = {"Ingeniería", "Ventas", "Soporte", "Marketing", "Finanzas", "RRHH"};
+    for (int i = 0; i < filas; ++i) {
+        DescriptorEmpleado d{};
+        d.nombre = "Nombre";
+        d.apellido = "Apellido";
+        d.departamento = departamentos[i % 6];
+        d.salarioBase = 2000.0 + (i % 5000);
+        d.bonus = i % 700;
+        if (i % 8 == 0) {
+            d.tipo = TipoEmpleado::Manager;
+        } else {
+            d.tipo = TipoEmpleado::Developer;
+            d.lenguajes = (i % 3 == 0) ? "C++,Go" : "Python";
+        }
+        m.agregar(d);
+    }
+}
+
+Contadores trabajar(ConcurrentEmployeeManager& m, unsigned hilo, int maximoId, const std::atomic<bool>& parar) {
+    Contadores c;
+    uint64_t x = 0x9E3779B97F4A7C15ull * (hilo + 1);
+    DescriptorEmpleado nuevo{TipoEmpleado::Developer, "Nuevo", "Empleado", 2500.0, "Ventas", 100.0, 0, "Rust"};
+
+    while (!parar.load(std::memory_order_relaxed)) {
+        // Lotes de 256 operaciones entre comprobaciones de 'parar'
+        for (int k = 0; k < 256; ++k) {
+            uint64_t r = siguienteAleatorio(x);
+            int id = 1 + static_cast<int>((r >> 8) % static_cast<uint64_t>(maximoId));
+            unsigned tirada = static_cast<unsigned>(r % 100);
+            if (tirada < 90) {
+                m.leer(id, [&](const Employee& e) {
+                    c.checksum += static_cast<uint64_t>(e.calcularSalarioTotal());
+                });
+                ++c.lecturas;
+            } else if (tirada < 98) {
+                m.modificarSalario(id, 2000.0 + static_cast<double>(r % 4000));
+                ++c.escrituras;
+            } else if (tirada < 99) {
+                m.agregar(nuevo);
+                ++c.altas;
+                ++c.escrituras;
+            } else {
+                c.bajas += m.eliminar(id);
+                ++c.escrituras;
+            }
+        }
+    }
+    return c;
+}
+
+bool leerOpciones(int argc, char* argv[], Opciones& o) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--filas") o.filas = std::atoi(argv[i + 1]);
+        else if (arg == "--segundos") o.segundos = std::atof(argv[i + 1]);
+        else if (arg == "--hilos-max") o.hilosMax = static_cast<unsigned>(std::atoi(argv[i + 1]));
+        else if (arg == "--fragmentos") o.fragmentos = static_cast<unsigned>(std::atoi(argv[i + 1]));
+        else return false;
+    }
+    return argc % 2 == 1 && o.filas > 0 && o.segundos > 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Opciones o;
+    if (!leerOpciones(argc, argv, o)) {
+        std::fprintf(stderr, "Uso: %s [--filas N] [--segundos S] [--hilos-max T] [--fragmentos F]\n", argv[0]);
+        return 1;
+    }
+    if (o.hilosMax == 0) o.hilosMax = 2 * std::max(1u, std::thread::hardware_concurrency());
+
+    ConcurrentEmployeeManager m(o.fragmentos);
+    poblar(m, o.filas);
+    std::printf("%d empleados, %u fragmentos, %u núcleos, mezcla 90/10, %.1f s por medición\n\n",
+                o.filas, m.getFragmentos(), std::thread::hardware_concurrency(), o.segundos);
+    std::printf("%6s %16s %16s %16s %10s\n", "Hilos", "Ops/s", "Lecturas/s", "Escrituras/s", "Escalado");
+
+    uint64_t altasTotales = 0;
+    uint64_t bajasTotales = 0;
+    double lecturasUnHilo = 0;
+    uint64_t sumaControl = 0;   // usa lo leído para que no se optimice
+    for (unsigned hilos = 1; hilos <= o.hilosMax; hilos *= 2) {
+        std::atomic<bool> parar{false};
+        std::vector<Contadores> resultados(hilos);
+        std::vector<std::thread> trabajadores;
+
+        auto inicio = std::chrono::steady_clock::now();
+        for (unsigned h = 0; h < hilos; ++h) {
+            trabajadores.emplace_back([&, h]() { resultados[h] = trabajar(m, h, o.filas, parar); });
+        }
+        std::this_thread::sleep_for(std::chrono::duration<double>(o.segundos));
+        parar = true;
+        for (std::thread& t : trabajadores) t.join();
+        double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        Contadores total;
+        for (const Contadores& c : resultados) {
+            total.lecturas += c.lecturas;
+            total.escrituras += c.escrituras;
+            total.altas += c.altas;
+            total.bajas += c.bajas;
+            sumaControl += c.checksum;
+        }
+        altasTotales += total.altas;
+        bajasTotales += total.bajas;
+
+        double lecturas = total.lecturas / segundos;
+        if (hilos == 1) lecturasUnHilo = lecturas;
+        std::printf("%6u %16.0f %16.0f %16.0f %9.2fx\n", hilos, (total.lecturas + total.escrituras) / segundos,
+                    lecturas, total.escrituras / segundos, lecturasUnHilo > 0 ? lecturas / lecturasUnHilo : 0.0);
+    }
+
+    // Consistencia: ninguna alta ni baja se ha perdido entre fragmentos
+    std::size_t esperado = static_cast<std::size_t>(o.filas) + altasTotales - bajasTotales;
+    std::size_t real = m.getCantidadEmpleados();
+    std::printf("\nEmpleados al final: %zu (esperados %zu) %s\n", real, esperado, real == esperado ? "OK" : "ERROR");
+    std::printf("Nómina total: %.2f (control %llu)\n", m.calcularNominaTotal(),
+                static_cast<unsigned long long>(sumaControl));
+    return real == esperado ? 0 : 1;
+}
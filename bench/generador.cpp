@@ -0,0 +1,230 @@
+/**
+ * Generador determinista de datos sintéticos para los benchmarks
+ * Uso: generador <filas> <salida> [semilla]
+ *
+ * Con la misma semilla produce siempre el mismo archivo: usa su propio
+ * generador (splitmix64) en lugar de las distribuciones de <random>, cuyos
+ * resultados cambian de una biblioteca estándar a otra.
+ *
+ * Distribuciones aproximadas a una plantilla real: los departamentos y
+ * lenguajes siguen pesos desiguales, ~12% son managers, y los salarios
+ * son log-normales por departamento. Cada empleado depende de uno de los
+ * últimos managers de su departamento (algunos managers no tienen jefe),
+ * así la jerarquía tiene varios niveles y el equipo de cada manager es el
+ * número de sus subordinados directos.
+ */
+#include "EmployeeParser.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+class Aleatorio {
+public:
+    explicit Aleatorio(uint64_t semilla) : estado(semilla) {}
+
+    uint64_t siguiente() {
+        uint64_t z = (estado += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniforme en [0, 1)
+    double uniforme() { return static_cast<double>(siguiente() >> 11) * (1.0 / 9007199254740992.0); }
+
+    uint32_t entero(uint32_t limite) { return static_cast<uint32_t>(uniforme() * limite); }
+
+    // Normal estándar por Box-Muller
+    double normal() {
+        double u1 = 1.0 - uniforme();
+        double u2 = uniforme();
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+private:
+    uint64_t estado;
+};
+
+struct Opcion {
+    const char* nombre;
+    double peso;
+};
+
+// Elige según los pesos (tabla acumulada precalculada)
+class Ponderado {
+public:
+    template <std::size_t N>
+    explicit Ponderado(const Opcion (&opciones)[N]) {
+        double total = 0;
+        for (const Opcion& o : opciones) total += o.peso;
+        double acumulado = 0;
+        for (const Opcion& o : opciones) {
+            acumulado += o.peso / total;
+            nombres.push_back(o.nombre);
+            limites.push_back(acumulado);
+        }
+        limites.back() = 1.0;
+    }
+
+    std::size_t elegir(Aleatorio& rng) const {
+        double u = rng.uniforme();
+        std::size_t i = 0;
+        while (limites[i] <= u) ++i;
+        return i;
+    }
+
+    const char* nombre(std::size_t i) const { return nombres[i]; }
+    std::size_t size() const { return nombres.size(); }
+
+private:
+    std::vector<const char*> nombres;
+    std::vector<double> limites;
+};
+
+const Opcion DEPARTAMENTOS[] = {
+    {"Ingeniería", 34}, {"Ventas", 16}, {"Soporte", 12}, {"Marketing", 8}, {"Operaciones", 8},
+    {"Finanzas", 6}, {"Producto", 5}, {"RRHH", 4}, {"Legal", 2}, {"Dirección", 1},
+};
+// Mediana del salario base por departamento, en el mismo orden
+const double MEDIANA_SALARIO[] = {5200, 3600, 2800, 3900, 3300, 4400, 5000, 3500, 5600, 9000};
+
+const Opcion LENGUAJES[] = {
+    {"Python", 22}, {"JavaScript", 20}, {"Java", 14}, {"TypeScript", 12}, {"C++", 9}, {"Go", 7},
+    {"SQL", 6}, {"C#", 5}, {"Rust", 3}, {"Kotlin", 2}, {"Ruby", 2}, {"Scala", 1},
+};
+
+const char* NOMBRES[] = {
+    "Ana", "Luis", "María", "Jorge", "Lucía", "Pedro", "Sofía", "Diego", "Elena", "Pablo",
+    "Carmen", "Javier", "Laura", "Miguel", "Paula", "Andrés", "Marta", "Raúl", "Sara", "Hugo",
+    "Irene", "Daniel", "Alba", "Sergio", "Nuria", "Carlos", "Julia", "Álvaro", "Clara", "Iván",
+};
+const char* APELLIDOS[] = {
+    "García", "López", "Martínez", "Sánchez", "Pérez", "Gómez", "Martín", "Jiménez", "Ruiz",
+    "Hernández", "Díaz", "Moreno", "Muñoz", "Álvarez", "Romero", "Alonso", "Gutiérrez", "Navarro",
+    "Torres", "Domínguez", "Vázquez", "Ramos", "Gil", "Ramírez", "Serrano", "Blanco", "Molina",
+};
+
+double redondear(double valor) { return std::round(valor * 100.0) / 100.0; }
+
+// Estructura de la plantilla, decidida antes de escribir: el equipo de un
+// manager se escribe en su línea pero depende de los que vienen después
+struct Estructura {
+    std::vector<uint8_t> departamentos;
+    std::vector<bool> managers;
+    std::vector<int32_t> jefes;     // 0 = sin jefe
+    std::vector<int32_t> equipos;   // subordinados directos
+};
+
+Estructura generarEstructura(long long filas, const Ponderado& departamentos, Aleatorio& rng) {
+    const std::size_t RECIENTES = 16;
+    const double PROBABILIDAD_SIN_JEFE = 0.1;   // solo managers
+    Estructura e;
+    e.departamentos.resize(filas);
+    e.managers.resize(filas);
+    e.jefes.resize(filas);
+    e.equipos.assign(filas, 0);
+    std::vector<std::vector<int32_t>> recientes(departamentos.size());   // últimos managers por departamento
+    for (long long i = 0; i < filas; ++i) {
+        const std::size_t d = departamentos.elegir(rng);
+        const bool esManager = rng.uniforme() < 0.12;
+        std::vector<int32_t>& candidatos = recientes[d];
+        int32_t jefe = 0;
+        if (!candidatos.empty() && !(esManager && rng.uniforme() < PROBABILIDAD_SIN_JEFE)) {
+            jefe = candidatos[rng.entero(candidatos.size())];
+            ++e.equipos[jefe - 1];
+        }
+        if (esManager) {
+            const int32_t id = static_cast<int32_t>(i + 1);
+            if (candidatos.size() < RECIENTES) {
+                candidatos.push_back(id);
+            } else {
+                candidatos[id % RECIENTES] = id;
+            }
+        }
+        e.departamentos[i] = static_cast<uint8_t>(d);
+        e.managers[i] = esManager;
+        e.jefes[i] = jefe;
+    }
+    return e;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::fprintf(stderr, "Uso: %s <filas> <salida> [semilla]\n", argv[0]);
+        return 1;
+    }
+    const long long filas = std::atoll(argv[1]);
+    const uint64_t semilla = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 42;
+
+    std::FILE* salida = std::fopen(argv[2], "wb");
+    if (!salida) {
+        std::fprintf(stderr, "No se pudo crear %s\n", argv[2]);
+        return 1;
+    }
+
+    Aleatorio rng(semilla);
+    Ponderado departamentos(DEPARTAMENTOS);
+    Ponderado lenguajes(LENGUAJES);
+    const std::size_t numNombres = sizeof(NOMBRES) / sizeof(NOMBRES[0]);
+    const std::size_t numApellidos = sizeof(APELLIDOS) / sizeof(APELLIDOS[0]);
+
+    Aleatorio rngEstructura(semilla ^ 0x5DEECE66Dull);
+    const Estructura estructura = generarEstructura(filas, departamentos, rngEstructura);
+
+    std::string buffer;
+    std::string lista;
+    std::vector<bool> elegido(lenguajes.size());
+    for (long long i = 1; i <= filas; ++i) {
+        RegistroTexto r{};
+        r.id = static_cast<int>(i);
+        r.nombre = NOMBRES[rng.entero(numNombres)];
+        r.apellido = APELLIDOS[rng.entero(numApellidos)];
+        const std::size_t d = estructura.departamentos[i - 1];
+        r.departamento = departamentos.nombre(d);
+        r.jefe = estructura.jefes[i - 1];
+
+        const bool esManager = estructura.managers[i - 1];
+        double mediana = MEDIANA_SALARIO[d] * (esManager ? 1.5 : 1.0);
+        r.salarioBase = redondear(mediana * std::exp(0.25 * rng.normal()));
+
+        if (esManager) {
+            r.tipo = TipoEmpleado::Manager;
+            r.equipo = estructura.equipos[i - 1];
+            r.bonus = redondear(r.salarioBase * (0.1 + 0.2 * rng.uniforme()));
+        } else {
+            r.tipo = TipoEmpleado::Developer;
+            r.bonus = redondear(1500.0 * rng.uniforme());
+
+            // Hasta 4 lenguajes, cada uno menos probable que el anterior; los repetidos se descartan
+            int cantidad = 1;
+            while (cantidad < 4 && rng.uniforme() < 0.45) ++cantidad;
+            lista.clear();
+            elegido.assign(lenguajes.size(), false);
+            for (int k = 0; k < cantidad; ++k) {
+                std::size_t l = lenguajes.elegir(rng);
+                if (elegido[l]) continue;
+                elegido[l] = true;
+                if (!lista.empty()) lista += ',';
+                lista += lenguajes.nombre(l);
+            }
+            r.lenguajes = lista;
+        }
+
+        formatearRegistro(r, buffer);
+        buffer += '\n';
+        if (buffer.size() >= (1 << 20)) {
+            std::fwrite(buffer.data(), 1, buffer.size(), salida);
+            buffer.clear();
+        }
+    }
+    std::fwrite(buffer.data(), 1, buffer.size(), salida);
+    std::fclose(salida);
+    return 0;
+}
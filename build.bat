@@ -9,7 +9,7 @@ if not exist bin mkdir bin
 if not exist data mkdir data
 
 REM Compilar el proyecto
-g++ -std=c++17 -Iinclude src\Employee.cpp src\Developer.cpp src\Manager.cpp src\EmployeeManager.cpp src\main.cpp -o bin\employee_system.exe -Wall -Wextra
+g++ -std=c++17 -Iinclude src\Arena.cpp src\SymbolTable.cpp src\Employee.cpp src\Developer.cpp src\Manager.cpp src\IdIndex.cpp src\OrderedIndex.cpp src\RoaringBitmap.cpp src\LanguageIndex.cpp src\NameIndex.cpp src\ReportingTree.cpp src\ReportWriter.cpp src\BackgroundSaver.cpp src\VersionedStore.cpp src\StringInterner.cpp src\DepartmentIndex.cpp src\EmployeeColumns.cpp src\SalaryKernels.cpp src\ThreadPool.cpp src\MappedFile.cpp src\EmployeeParser.cpp src\Snapshot.cpp src\WriteAheadLog.cpp src\ProcessStats.cpp src\Metrics.cpp src\BatchProcessor.cpp src\ConcurrentEmployeeManager.cpp src\QueryServer.cpp src\EmployeeManager.cpp src\main.cpp -o bin\employee_system.exe -Wall -Wextra
 
 if %errorlevel% equ 0 (
     echo.
@@ -0,0 +1,67 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+/**
+ * Clase Arena - Asignador por avance de puntero (bump allocator)
+ * Demuestra: asignación en bloques grandes, vida útil compartida
+ *
+ * Reparte memoria de bloques de BLOQUE bytes y la libera toda junta al
+ * destruirse. Sirve para datos que viven tanto como su dueño, como los
+ * textos de una tabla de símbolos. No es segura entre hilos.
+ */
+class Arena {
+public:
+    static constexpr std::size_t BLOQUE = 64 * 1024;
+
+    void* reservar(std::size_t tamano, std::size_t alineacion = alignof(std::max_align_t));
+
+    // Copia el texto a la arena y devuelve una vista estable
+    std::string_view copiar(std::string_view texto);
+
+    std::size_t bytesReservados() const { return reservados; }
+
+private:
+    std::vector<std::unique_ptr<char[]>> bloques;
+    char* actual = nullptr;
+    std::size_t libres = 0;
+    std::size_t reservados = 0;
+};
+
+/**
+ * Clase PoolObjetos - Asignador de objetos de tamaño fijo con lista libre
+ * Demuestra: listas libres intrusivas, reutilización de memoria
+ *
+ * Las casillas se cortan de bloques grandes y las liberadas se encadenan
+ * para reutilizarse, sin volver al asignador general. Es seguro entre hilos.
+ */
+class PoolObjetos {
+public:
+    explicit PoolObjetos(std::size_t tamanoObjeto);
+
+    PoolObjetos(const PoolObjetos&) = delete;
+    PoolObjetos& operator=(const PoolObjetos&) = delete;
+
+    void* reservar();
+    void liberar(void* p);
+
+    std::size_t getTamanoObjeto() const { return tamanoObjeto; }
+
+    // Pool compartido para objetos de 'tamano' bytes, o nullptr si es demasiado grande
+    static PoolObjetos* paraTamano(std::size_t tamano);
+
+private:
+    struct Libre { Libre* siguiente; };
+
+    std::mutex mutex;
+    Arena arena;
+    Libre* libres = nullptr;
+    std::size_t tamanoObjeto;
+};
+
+#endif // ARENA_H
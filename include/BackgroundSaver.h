@@ -0,0 +1,73 @@
+#ifndef BACKGROUND_SAVER_H
+#define BACKGROUND_SAVER_H
+
+#include "VersionedStore.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Clase BackgroundSaver - Guardado completo en un hilo propio
+ * Demuestra: productor/consumidor con condition_variable, lectura de
+ *            una versión fijada, escritura en temporal + renombrado atómico
+ *
+ * Quien guarda fija una versión de los empleados (VersionedStore, que solo
+ * copia el directorio de bloques) y la entrega con solicitar(); el hilo la
+ * recorre sin cerrojos, la serializa en un búfer grande reutilizado y la
+ * escribe en <ruta>.tmp, hace fsync y la renombra sobre <ruta>, así el
+ * archivo anterior nunca queda a medias.
+ *
+ * Hay como mucho dos versiones retenidas: la que se está escribiendo y una
+ * en espera. Una solicitud nueva sustituye a la que espera (la más reciente
+ * ya incluye sus cambios) y la sustituida se suelta en el acto.
+ */
+class BackgroundSaver {
+public:
+    enum class Formato { Texto, Snapshot };
+
+    BackgroundSaver(std::string ruta, Formato formato);
+    ~BackgroundSaver();   // escribe lo pendiente y detiene el hilo
+
+    BackgroundSaver(const BackgroundSaver&) = delete;
+    BackgroundSaver& operator=(const BackgroundSaver&) = delete;
+
+    // Encola la versión y devuelve su número de solicitud; no bloquea.
+    // La versión se suelta (desde el hilo del guardador) al terminar.
+    uint64_t solicitar(VersionedStore::Instantanea version);
+
+    // Espera a que la solicitud 'numero' (o una posterior que la incluya)
+    // esté en disco; false con 'error' si ese guardado falló
+    bool esperar(uint64_t numero, std::string& error);
+    bool esperarTodo(std::string& error);
+
+    uint64_t getSolicitados() const;
+    uint64_t getEscritos() const;   // guardados completos; los sustituidos no cuentan
+
+private:
+    static constexpr std::size_t TAMANO_BUFFER = 4 << 20;
+
+    std::string ruta;
+    Formato formato;
+
+    mutable std::mutex mutex;
+    std::condition_variable hayTrabajo;
+    std::condition_variable terminado;
+    VersionedStore::Instantanea pendiente;   // inválida si no hay nada en espera
+    uint64_t solicitados = 0;
+    uint64_t completados = 0;   // número de la última solicitud escrita (o fallida)
+    uint64_t escritos = 0;
+    bool ultimoOk = true;
+    std::string ultimoError;
+    bool detener = false;
+
+    std::string buffer;   // solo lo usa el hilo
+    std::thread hilo;
+
+    void bucle();
+    bool escribir(const VersionedStore::Instantanea& version, std::string& error);
+    bool escribirTexto(const VersionedStore::Instantanea& version, std::string& error);
+};
+
+#endif // BACKGROUND_SAVER_H
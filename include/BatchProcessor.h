@@ -0,0 +1,118 @@
+#ifndef BATCH_PROCESSOR_H
+#define BATCH_PROCESSOR_H
+
+#include "EmployeeManager.h"
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * Clase BatchProcessor - Ejecución de comandos sin menú
+ * Demuestra: lectura por bloques, salida con búfer, altas en lote
+ *
+ * Lee un flujo de comandos, uno por línea, con campos separados por '|'
+ * como en el archivo de datos. Los corchetes marcan campos opcionales:
+ *
+ *   Cambios (sin respuesta salvo MASIVO)
+ *   ALTA|DEV|nombre|apellido|salario|depto|bonus|lenguajes[|jefe]
+ *   ALTA|MGR|nombre|apellido|salario|depto|equipo|bonus[|jefe]
+ *   SALARIO|id|salario
+ *   JEFE|id|jefe                       (jefe 0 = sin jefe)
+ *   TRASLADO|id|depto
+ *   NUEVO_LENGUAJE|id|lenguaje         (solo developers)
+ *   MASIVO|campo|op|valor[|tipo[|depto[|equipoMinimo]]]
+ *                                      -> MASIVO|actualizados
+ *   BAJA|id
+ *
+ *   Consultas
+ *   BUSCAR|id                          -> línea del empleado | NO_ENCONTRADO|id
+ *   RAMA|id                            -> RAMA|id|personas|nomina
+ *   NOMINA                             -> NOMINA|total|empleados
+ *   DEPARTAMENTOS                      -> DEPARTAMENTO|nombre|empleados|suma|media|min|max
+ *   TOP|k[|depto]                      -> k líneas, de mayor a menor salario total
+ *   RANGO|campo|desde|hasta[|depto]    -> líneas por orden ascendente del campo
+ *   LENGUAJES|expresion                -> líneas por orden de ID
+ *   CONTEO_LENGUAJES[|depto]           -> LENGUAJE|nombre|empleados
+ *   PREFIJO|texto[|k]                  -> hasta k (10) líneas
+ *   NOMBRE|texto[|k]                   -> hasta k (10) COINCIDENCIA|puntuacion|línea
+ *   LISTAR|formato[|desdeId|cantidad]  -> listado por orden de ID (ReportWriter)
+ *   VERSIONES                          -> VERSIONES|version|fijadas|bloques|compartidos|
+ *                                         copias|retirados|bytes|retenidos
+ *
+ *   Persistencia
+ *   GUARDAR                            (en segundo plano, sin detener el lote)
+ *   CIERRE|ruta                        -> CIERRE|version|empleados|ruta
+ *
+ * Valores de los campos: en MASIVO, campo BASE o BONUS, op '%', '+' o '=' y
+ * tipo DEV, MGR o '*'; en RANGO, campo ID, SALARIO o BASE; en LISTAR,
+ * formato tabla, csv o jsonl. En ALTA|MGR el equipo se ignora, porque es
+ * el número de subordinados en la jerarquía. RAMA incluye al propio
+ * empleado. NUEVO_LENGUAJE no repite uno que el developer ya sabe. PREFIJO busca nombres o apellidos que empiezan por cada palabra
+ * del texto y NOMBRE tolera erratas. CIERRE fija una versión y escribe en
+ * 'ruta' sus DEPARTAMENTO y NOMINA desde otro hilo, sin detener el lote.
+ * En LENGUAJES todo lo que sigue al primer '|' es la expresión, así que
+ * puede usar '|' como "o": LENGUAJES|C++ & (Rust | Go) & !Java.
+ *
+ * Las líneas vacías y las que empiezan por '#' se ignoran. La entrada se
+ * lee en bloques de 1 MiB y las ALTA seguidas de un bloque se agrupan en
+ * una sola llamada a agregarLote. Las respuestas se acumulan en un búfer y
+ * se escriben con fwrite, sin pasar por std::cout. Los cierres pendientes
+ * se esperan al final de ejecutar().
+ */
+struct ResumenLote {
+    std::size_t operaciones = 0;
+    std::size_t altas = 0;
+    std::size_t bajas = 0;
+    std::size_t cambiosSalario = 0;
+    std::size_t consultas = 0;
+    std::size_t informes = 0;
+    std::size_t noEncontrados = 0;
+    std::size_t errores = 0;
+    double segundos = 0.0;
+
+    double operacionesPorSegundo() const { return segundos > 0 ? operaciones / segundos : 0.0; }
+};
+
+class BatchProcessor {
+public:
+    BatchProcessor(EmployeeManager& manager, std::FILE* salida);
+    ~BatchProcessor();
+
+    BatchProcessor(const BatchProcessor&) = delete;
+    BatchProcessor& operator=(const BatchProcessor&) = delete;
+
+    // Procesa la entrada hasta el final; false si hubo un error de lectura
+    bool ejecutar(std::FILE* entrada);
+
+    const ResumenLote& getResumen() const { return resumen; }
+
+    // Primeros errores de sintaxis (línea y motivo), para informar al usuario
+    const std::vector<ErrorLinea>& getErrores() const { return errores; }
+
+    // Analiza "DEV|nombre|apellido|salario|departamento|bonus|lenguajes" o su
+    // equivalente MGR (un comando ALTA sin el prefijo). 'd' apunta a 'texto'.
+    static bool analizarAlta(std::string_view texto, DescriptorEmpleado& d, std::string& motivo);
+
+private:
+    void procesarBloque(std::string_view bloque);
+    void procesarLinea(std::string_view linea);
+    void vaciarAltas();
+    bool esManager(int id) const;
+    void vaciarSalida();
+    void anotarError(std::string motivo);
+    void esperarCierres();
+
+    EmployeeManager& manager;
+    std::FILE* salida;
+    std::string bufferSalida;
+    std::vector<DescriptorEmpleado> altasPendientes;   // vistas sobre el bloque actual
+    std::vector<ErrorLinea> errores;
+    ResumenLote resumen;
+    std::size_t lineaActual = 0;
+    std::vector<std::thread> cierres;
+};
+
+#endif // BATCH_PROCESSOR_H
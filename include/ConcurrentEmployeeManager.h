@@ -0,0 +1,89 @@
+#ifndef CONCURRENT_EMPLOYEE_MANAGER_H
+#define CONCURRENT_EMPLOYEE_MANAGER_H
+
+#include "EmployeeManager.h"
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Clase ConcurrentEmployeeManager - Gestor seguro para varios hilos
+ * Demuestra: fragmentación por hash, cerrojos lector-escritor
+ *            (std::shared_mutex), orden global de cerrojos
+ *
+ * Los empleados se reparten por el hash de su ID entre N fragmentos, cada
+ * uno con su EmployeeManager en memoria y su shared_mutex. Las consultas
+ * por ID toman el cerrojo compartido de un solo fragmento y las
+ * modificaciones el exclusivo de ese fragmento, así que lectores y
+ * escritores de fragmentos distintos no se bloquean entre sí.
+ *
+ * Las consultas globales (nómina, estadísticas, guardado) toman los
+ * cerrojos compartidos de todos los fragmentos en orden de índice y los
+ * mantienen mientras leen: como cada escritor solo retiene un fragmento,
+ * ven un corte consistente sin riesgo de interbloqueo.
+ *
+ * La jerarquía de jefes no cruza fragmentos, así que aquí no se mantiene:
+ * los empleados se guardan sin jefe y los managers sin equipo a cargo.
+ */
+class ConcurrentEmployeeManager {
+public:
+    // 'fragmentos' se redondea a la potencia de dos superior
+    explicit ConcurrentEmployeeManager(unsigned fragmentos = 16);
+
+    ConcurrentEmployeeManager(const ConcurrentEmployeeManager&) = delete;
+    ConcurrentEmployeeManager& operator=(const ConcurrentEmployeeManager&) = delete;
+
+    // Carga texto o instantánea (se detecta por la firma) y la añade a lo que haya
+    bool cargar(const std::string& ruta, std::string& error);
+    bool guardarSnapshot(const std::string& ruta, std::string& error) const;
+
+    // Devuelve el ID asignado
+    int agregar(const DescriptorEmpleado& d);
+    bool eliminar(int id);
+    bool modificarSalario(int id, double nuevoSalario);
+
+    // Ejecuta f(const Employee&) con el fragmento bloqueado en modo
+    // compartido; el empleado no debe usarse fuera de f. false si no existe.
+    template <typename Funcion>
+    bool leer(int id, Funcion&& f) const;
+
+    // Línea en formato de texto, o "" si no existe
+    std::string buscar(int id) const;
+
+    double calcularNominaTotal() const;
+    std::size_t getCantidadEmpleados() const;
+    std::vector<std::pair<std::string, kernels::EstadisticasSalario>> estadisticasPorDepartamento() const;
+
+    unsigned getFragmentos() const { return static_cast<unsigned>(fragmentos.size()); }
+
+private:
+    // Alineado a línea de caché: los cerrojos de fragmentos vecinos no se estorban
+    struct alignas(64) Fragmento {
+        mutable std::shared_mutex cerrojo;
+        EmployeeManager gestor{"", 1};
+    };
+
+    Fragmento& fragmentoDe(int id) const;
+
+    // Cerrojos compartidos de todos los fragmentos, tomados en orden
+    std::vector<std::shared_lock<std::shared_mutex>> bloquearTodos() const;
+
+    std::vector<std::unique_ptr<Fragmento>> fragmentos;
+    unsigned bitsFragmento;
+    std::atomic<int> siguienteId{1};
+};
+
+template <typename Funcion>
+bool ConcurrentEmployeeManager::leer(int id, Funcion&& f) const {
+    Fragmento& fragmento = fragmentoDe(id);
+    std::shared_lock<std::shared_mutex> lock(fragmento.cerrojo);
+    const Employee* emp = fragmento.gestor.getEmpleado(id);
+    if (!emp) return false;
+    f(*emp);
+    return true;
+}
+
+#endif // CONCURRENT_EMPLOYEE_MANAGER_H
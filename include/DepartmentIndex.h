@@ -0,0 +1,57 @@
+#ifndef DEPARTMENT_INDEX_H
+#define DEPARTMENT_INDEX_H
+
+#include "IdIndex.h"
+#include "SalaryKernels.h"
+#include "SymbolTable.h"
+#include <string_view>
+#include <vector>
+
+/**
+ * Clase DepartmentIndex - Índice secundario por departamento
+ * Demuestra: agregados incrementales, internado de cadenas
+ *
+ * Mantiene por cada departamento la lista de IDs, el número de empleados
+ * y la suma de salarios totales. EmployeeManager lo actualiza en cada alta,
+ * baja o cambio, de modo que los informes cuestan O(departamentos).
+ *
+ * Se indexa por el símbolo del departamento en la tabla global, el que ya
+ * guarda Employee: altas y bajas no buscan ni internan ningún texto. Los
+ * símbolos de lenguajes dejan huecos sin empleados, que los recorridos
+ * por símbolo saltan igual que un departamento vacío.
+ */
+class DepartmentIndex {
+public:
+    struct Departamento {
+        std::vector<int> miembros;
+        int cantidad = 0;
+        kernels::SumaCompensada nomina;   // nomina.valor() para leerla
+    };
+
+    using Simbolo = SymbolTable::Simbolo;
+
+    void agregar(int id, Simbolo departamento, double salarioTotal);
+    void eliminar(int id, Simbolo departamento, double salarioTotal);
+    void cambiarDepartamento(int id, Simbolo anterior, Simbolo nuevo, double salarioTotal);
+    void ajustarNomina(Simbolo departamento, double diferencia);
+
+    // Devuelve nullptr si el departamento no existe
+    const Departamento* buscar(std::string_view departamento) const;
+
+    // Devuelve SymbolTable::NINGUNO si el departamento no existe
+    Simbolo simbolo(std::string_view departamento) const;
+
+    // Acceso por símbolo, para recorrer todos los departamentos
+    std::size_t cantidadSimbolos() const { return departamentos.size(); }
+    std::string_view nombre(Simbolo simbolo) const { return textoSimbolo(simbolo); }
+    const Departamento& porSimbolo(Simbolo simbolo) const { return departamentos[simbolo]; }
+
+private:
+    std::vector<Departamento> departamentos;   // indexado por símbolo
+    IdIndex posicionEnLista;                   // ID -> posición en 'miembros'
+
+    Departamento& obtener(Simbolo simbolo);
+    void quitarMiembro(Departamento& dept, int id);
+};
+
+#endif // DEPARTMENT_INDEX_H
@@ -2,33 +2,52 @@
 #define DEVELOPER_H
 
 #include "Employee.h"
+#include <memory>
 #include <vector>
 
 /**
  * Clase Developer - Hereda de Employee
  * Representa un desarrollador con lenguajes de programación y bonus
+ *
+ * Cada lenguaje es un símbolo de la tabla global. La lista no se modifica
+ * una vez creada: agregarLenguaje() la sustituye por otra, así las versiones
+ * de VersionedStore la comparten sin copiarla.
  */
 class Developer : public Employee {
+public:
+    using Lenguajes = std::vector<SymbolTable::Simbolo>;
+
 private:
-    std::vector<std::string> lenguajes;
+    std::shared_ptr<const Lenguajes> lenguajes;   // nunca nula
     double bonusProyectos;
 
+protected:
+    double recalcularSalarioTotal() const override;
+
 public:
-    Developer(int id, const std::string& nombre, const std::string& apellido,
-              double salarioBase, const std::string& departamento,
+    Developer(int id, std::string_view nombre, std::string_view apellido,
+              double salarioBase, std::string_view departamento,
               const std::vector<std::string>& lenguajes, double bonusProyectos);
 
+    // 'listaLenguajes' en el formato del archivo: separados por ','
+    Developer(int id, std::string_view nombre, std::string_view apellido,
+              double salarioBase, std::string_view departamento,
+              std::string_view listaLenguajes, double bonusProyectos);
+
     // Implementación de métodos virtuales
-    double calcularSalarioTotal() const override;
-    std::string getTipo() const override { return "Developer"; }
+    std::string_view getTipo() const override { return "Developer"; }
+    ComponentesSalario getComponentesSalario() const override;
     void mostrarInfo() const override;
     std::string serializar() const override;
 
     // Métodos específicos
-    void agregarLenguaje(const std::string& lenguaje);
-    const std::vector<std::string>& getLenguajes() const { return lenguajes; }
+    void agregarLenguaje(std::string_view lenguaje);
+    // Para el texto separado por ',' ver unirLenguajes (EmployeeParser.h)
+    const Lenguajes& getLenguajes() const { return *lenguajes; }
+    const std::shared_ptr<const Lenguajes>& getListaCompartida() const { return lenguajes; }
+    int getCantidadLenguajes() const { return static_cast<int>(lenguajes->size()); }
     double getBonusProyectos() const { return bonusProyectos; }
-    void setBonusProyectos(double bonus) { bonusProyectos = bonus; }
+    void setBonusProyectos(double bonus);
 };
 
 #endif // DEVELOPER_H
@@ -1,47 +1,118 @@
 #ifndef EMPLOYEE_H
 #define EMPLOYEE_H
 
+#include "SymbolTable.h"
 #include <string>
+#include <string_view>
 #include <iostream>
 
+class Employee;
+
+// Etiqueta de tipo compacta para el almacén columnar
+enum class TipoEmpleado : unsigned char { Developer, Manager };
+
+/**
+ * Entradas de la fórmula de salario total de un empleado.
+ * Los campos que no aplican al tipo valen 0, así la fórmula
+ * base + bonus + 500*lenguajes + 300*equipo sirve para ambos.
+ */
+struct ComponentesSalario {
+    TipoEmpleado tipo;
+    double salarioBase;
+    double bonus;
+    int lenguajes;
+    int equipo;
+};
+
+/**
+ * Interfaz ObservadorEmpleado - Recibe avisos de cambios en un empleado
+ * Permite que quien indexa los empleados mantenga sus agregados al día
+ * aunque los setters se llamen directamente sobre el objeto.
+ */
+class ObservadorEmpleado {
+public:
+    virtual ~ObservadorEmpleado() = default;
+    virtual void alCambiarSalario(const Employee& emp, double salarioTotalAnterior) = 0;
+    virtual void alCambiarDepartamento(const Employee& emp, SymbolTable::Simbolo anterior) = 0;
+    virtual void alAgregarLenguaje(const Employee& emp, SymbolTable::Simbolo lenguaje) = 0;
+};
+
 /**
  * Clase base Employee - Representa un empleado genérico
  * Demuestra: encapsulación, métodos virtuales, abstracción
+ *
+ * El departamento se guarda como símbolo de la tabla global (SymbolTable);
+ * nombre y apellido, casi siempre distintos, son cadenas propias que caben
+ * en el búfer interno de std::string y se liberan con el empleado. Los
+ * objetos salen de pools de tamaño fijo (PoolObjetos).
  */
 class Employee {
 protected:
     int id;
     std::string nombre;
     std::string apellido;
+    SymbolTable::Simbolo departamento;
+    int jefe = 0;   // ID de su manager; 0 = sin jefe
     double salarioBase;
-    std::string departamento;
+    double salarioTotal = 0.0;   // caché de recalcularSalarioTotal()
+    ObservadorEmpleado* observador = nullptr;
+
+    // Fórmula del salario total de cada tipo; solo se evalúa al cambiar un dato
+    virtual double recalcularSalarioTotal() const = 0;
+
+    // Tras modificar un dato que afecta al salario: renueva la caché y avisa
+    // al observador. Los constructores derivados la inicializan con
+    // salarioTotal = recalcularSalarioTotal().
+    void notificarCambioSalario(double salarioTotalAnterior) {
+        salarioTotal = recalcularSalarioTotal();
+        if (observador) observador->alCambiarSalario(*this, salarioTotalAnterior);
+    }
 
 public:
     // Constructor
-    Employee(int id, const std::string& nombre, const std::string& apellido,
-             double salarioBase, const std::string& departamento);
+    Employee(int id, std::string_view nombre, std::string_view apellido,
+             double salarioBase, std::string_view departamento);
 
     // Destructor virtual (importante para herencia)
     virtual ~Employee() = default;
 
+    // La caché se renueva en cada setter, así que leerla no escribe nada y
+    // es segura con varios lectores a la vez (ConcurrentEmployeeManager)
+    double calcularSalarioTotal() const { return salarioTotal; }
+
     // Métodos virtuales puros - hacen la clase abstracta
-    virtual double calcularSalarioTotal() const = 0;
-    virtual std::string getTipo() const = 0;
+    virtual std::string_view getTipo() const = 0;
+    virtual ComponentesSalario getComponentesSalario() const = 0;
     virtual void mostrarInfo() const;
 
     // Serialización para guardar en archivo
     virtual std::string serializar() const = 0;
 
-    // Getters
+    // Getters (la vista del departamento apunta a la tabla global y no caduca;
+    // las de nombre y apellido, mientras viva el empleado)
     int getId() const { return id; }
-    std::string getNombre() const { return nombre; }
-    std::string getApellido() const { return apellido; }
+    std::string_view getNombre() const { return nombre; }
+    std::string_view getApellido() const { return apellido; }
     double getSalarioBase() const { return salarioBase; }
-    std::string getDepartamento() const { return departamento; }
+    std::string_view getDepartamento() const { return textoSimbolo(departamento); }
+    int getJefe() const { return jefe; }
+
+    // Símbolo de la tabla global, para copias compactas (VersionedStore)
+    SymbolTable::Simbolo getSimboloDepartamento() const { return departamento; }
 
     // Setters
-    void setSalarioBase(double nuevoSalario) { salarioBase = nuevoSalario; }
-    void setDepartamento(const std::string& dept) { departamento = dept; }
+    void setSalarioBase(double nuevoSalario);
+    void setDepartamento(std::string_view dept);
+
+    // Los empleados se reservan en pools por tamaño en lugar del heap general
+    static void* operator new(std::size_t tamano);
+    static void operator delete(void* p, std::size_t tamano);
+
+    // Observador de cambios (lo asigna EmployeeManager)
+    void setObservador(ObservadorEmpleado* obs) { observador = obs; }
+
+    // Lo mantiene EmployeeManager junto con su jerarquía (ver cambiarJefe)
+    void setJefe(int id) { jefe = id; }
 };
 
 #endif // EMPLOYEE_H
@@ -0,0 +1,56 @@
+#ifndef EMPLOYEE_COLUMNS_H
+#define EMPLOYEE_COLUMNS_H
+
+#include "Employee.h"
+#include "SalaryKernels.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Clase EmployeeColumns - Almacén columnar (estructura de arrays)
+ * Demuestra: diseño orientado a datos, bucles sin saltos ni llamadas virtuales
+ *
+ * Guarda en columnas contiguas las entradas de la fórmula de salario,
+ * en la misma posición que el empleado ocupa en EmployeeManager. Así la
+ * nómina se calcula recorriendo memoria contigua en lugar de saltar de
+ * objeto en objeto llamando a calcularSalarioTotal().
+ */
+class EmployeeColumns {
+public:
+    static constexpr double BONUS_POR_LENGUAJE = 500.0;
+    static constexpr double BONUS_POR_PERSONA = 300.0;
+
+    void agregar(const ComponentesSalario& c, uint32_t departamento);
+    void actualizar(std::size_t pos, const ComponentesSalario& c);
+    void setDepartamento(std::size_t pos, uint32_t departamento) { departamentos[pos] = departamento; }
+    void eliminarIntercambiando(std::size_t pos);
+    void reservar(std::size_t cantidad);
+
+    double salarioTotal(std::size_t pos) const {
+        return salariosBase[pos] + bonus[pos]
+             + BONUS_POR_LENGUAJE * lenguajes[pos] + BONUS_POR_PERSONA * equipos[pos];
+    }
+
+    std::size_t size() const { return salariosBase.size(); }
+
+    // Vista para los núcleos vectorizados de SalaryKernels
+    kernels::ColumnasSalario vista() const;
+
+    // Acceso de solo lectura a las columnas
+    const double* getSalariosBase() const { return salariosBase.data(); }
+    const double* getBonus() const { return bonus.data(); }
+    const TipoEmpleado* getTipos() const { return tipos.data(); }
+    const int32_t* getLenguajes() const { return lenguajes.data(); }
+    const int32_t* getEquipos() const { return equipos.data(); }
+    const uint32_t* getDepartamentos() const { return departamentos.data(); }
+
+private:
+    std::vector<double> salariosBase;
+    std::vector<double> bonus;
+    std::vector<TipoEmpleado> tipos;
+    std::vector<int32_t> lenguajes;   // 0 para managers
+    std::vector<int32_t> equipos;     // 0 para developers
+    std::vector<uint32_t> departamentos;   // símbolo de la tabla global (SymbolTable)
+};
+
+#endif // EMPLOYEE_COLUMNS_H
@@ -4,51 +4,368 @@
 #include "Employee.h"
 #include "Developer.h"
 #include "Manager.h"
+#include "IdIndex.h"
+#include "DepartmentIndex.h"
+#include "OrderedIndex.h"
+#include "LanguageIndex.h"
+#include "NameIndex.h"
+#include "ReportingTree.h"
+#include "ReportWriter.h"
+#include "BackgroundSaver.h"
+#include "VersionedStore.h"
+#include "EmployeeColumns.h"
+#include "ThreadPool.h"
+#include "EmployeeParser.h"
+#include "Snapshot.h"
+#include "WriteAheadLog.h"
+#include "Metrics.h"
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <thread>
+#include <type_traits>
 #include <vector>
-#include <map>
 #include <string>
+#include <string_view>
+
+/**
+ * Datos de un empleado para altas en lote. Los textos son vistas que solo
+ * se copian al internarlos; el ID lo asigna EmployeeManager::agregarLote.
+ * El equipo a cargo de un manager no se indica: se cuenta en la jerarquía.
+ */
+struct DescriptorEmpleado {
+    TipoEmpleado tipo;
+    std::string_view nombre;
+    std::string_view apellido;
+    double salarioBase;
+    std::string_view departamento;
+    double bonus;
+    int jefe = 0;                  // ID de un manager; 0 = sin jefe
+    std::string_view lenguajes;    // solo developers, separados por ','
+};
+
+// Campos con índice ordenado, para consultas top-K y por rango
+enum class CampoOrden { Id, SalarioTotal, SalarioBase };
+
+// Empleados a los que afecta una actualización masiva; lo que se deja con
+// su valor por defecto no filtra
+struct SeleccionEmpleados {
+    bool porTipo = false;
+    TipoEmpleado tipo = TipoEmpleado::Developer;
+    std::string_view departamento;   // vacío = todos
+    int equipoMinimo = 0;            // > 0: solo managers con al menos ese equipo
+    double baseMinima = -std::numeric_limits<double>::infinity();
+    double baseMaxima = std::numeric_limits<double>::infinity();
+};
+
+enum class ModoCambio { Porcentaje, Sumar, Fijar };
+
+// Cambio de una actualización masiva; el resultado nunca baja de 0
+struct CambioMasivo {
+    CampoMasivo campo = CampoMasivo::SalarioBase;
+    ModoCambio modo = ModoCambio::Porcentaje;
+    double valor = 0.0;   // porcentaje, cantidad a sumar o valor nuevo
+};
 
 /**
  * Clase EmployeeManager - Sistema de gestión de empleados
  * Demuestra: smart pointers, contenedores STL, manejo de archivos
  */
-class EmployeeManager {
+class EmployeeManager : private ObservadorEmpleado {
 private:
     // Uso de smart pointers para gestión automática de memoria
     std::vector<std::unique_ptr<Employee>> empleados;
+    IdIndex indicePorId;   // ID -> posición en 'empleados'
+    DepartmentIndex indicePorDepartamento;
+    LanguageIndex indicePorLenguaje;   // lenguaje / departamento -> mapa de IDs
+    NameIndex indicePorNombre;   // palabras de nombre y apellido -> mapa de IDs
+    EmployeeColumns columnas;   // entradas de salario, alineadas con 'empleados'
+    VersionedStore versiones;   // copia versionada, alineada con 'empleados' (ver VersionedStore.h)
+
+    // Jefes y agregados por rama (ver ReportingTree.h). Durante una carga no
+    // se mantiene: terminarCarga() la construye de una vez, resolviendo los
+    // jefes dados de baja mientras tanto con 'bajasDuranteCarga' (ID, jefe)
+    ReportingTree jerarquia;
+    std::vector<std::pair<int, int>> bajasDuranteCarga;
+
+    // Nómina total mantenida con cada alta, baja o cambio. Tras tantos ajustes
+    // como empleados (o al terminar una carga) se recalcula desde las
+    // columnas: el coste amortizado sigue siendo O(1) por cambio.
+    kernels::SumaCompensada nominaTotal;
+    std::size_t ajustesNomina = 0;
+
+    // Índices ordenados (clave, ID). Durante una carga no se mantienen uno
+    // a uno: terminarCarga() los reconstruye ordenando de una vez.
+    OrderedIndex ordenPorId;
+    OrderedIndex ordenPorSalarioTotal;
+    OrderedIndex ordenPorSalarioBase;
+    bool cargando = false;
     int siguienteId;
     std::string archivoGuardado;
+    bool formatoBinario;   // guardar como instantánea en lugar de texto
+    std::unique_ptr<ThreadPool> pool;   // nullptr = modo serie
+
+    // Modo con diario (solo con instantánea): cada cambio se anexa a
+    // <archivo>.wal y la compactación lo vuelca a una instantánea nueva
+    std::unique_ptr<WriteAheadLog> diario;
+    std::thread compactador;
+    std::atomic<bool> compactando{false};
+    bool diarioRoto = false;   // falló una escritura: lo anotado desde entonces no está en el diario
+
+    // Sin diario: guardado completo en segundo plano (ver BackgroundSaver.h).
+    // El autoguardado se comprueba tras cada operación que modifica.
+    std::unique_ptr<BackgroundSaver> guardador;
+    uint64_t cambiosSinGuardar = 0;
+    std::chrono::steady_clock::duration intervaloAutoguardado{};   // cero = desactivado
+    std::chrono::steady_clock::time_point proximoAutoguardado;
 
     // Métodos privados auxiliares
     Employee* buscarPorId(int id);
+    const Employee* buscarPorId(int id) const;
+    bool registrar(std::unique_ptr<Employee> emp);
+    bool registrarRegistro(const RegistroTexto& r);
+    void quitar(std::size_t pos);
+    void ajustarNomina(double diferencia);
+    void renovarNomina();
+    void empezarCarga();
+    void terminarCarga();
+    void reconstruirOrdenSalarios();
+    void construirJerarquia();
+    bool esManager(int id) const;
+    void ajustarEquipo(int jefe, int diferencia);
+    const OrderedIndex& indiceOrden(CampoOrden campo) const;
+    void reservarAltas(std::size_t cantidad);
+    int altaSinAviso(const DescriptorEmpleado& d);
+
+    // Avisos de los empleados para mantener los índices
+    void alCambiarSalario(const Employee& emp, double salarioTotalAnterior) override;
+    void alCambiarDepartamento(const Employee& emp, SymbolTable::Simbolo anterior) override;
+    void alAgregarLenguaje(const Employee& emp, SymbolTable::Simbolo lenguaje) override;
     void cargarDesdeArchivo();
+    void cargarRegistros(const std::vector<RegistroTexto>& registros, std::vector<ErrorLinea>& errores);
+    bool cargarDesdeSnapshot(std::string_view imagen, std::string& error);
+    snapshot::Escritor crearEscritor() const;
+
+    void abrirDiario();
+    bool reproducirDiario(const std::string& ruta, bool truncarCola);
+    void aplicarEntrada(const EntradaDiario& entrada);
+    void revisarDiario();
+    bool sincronizarDiario();     // false tras un error de escritura (ya informado)
+    bool guardarYVaciarDiario();  // instantánea síncrona; después el diario sobra
+    void revisarPersistencia();   // compactación del diario o autoguardado
+    void esperarCompactacion();
+    void informarErroresCarga(std::vector<ErrorLinea>& errores) const;
 
 public:
-    EmployeeManager(const std::string& archivo = "data/empleados.txt");
+    // Con archivo "" el gestor trabaja solo en memoria: ni carga ni guarda
+    EmployeeManager(const std::string& archivo = "data/empleados.txt", unsigned hilos = 1);
     ~EmployeeManager();
 
-    // Operaciones CRUD
+    // Operaciones CRUD. El jefe, si lo hay, debe ser un manager existente
     void agregarDeveloper(const std::string& nombre, const std::string& apellido,
                          double salarioBase, const std::string& departamento,
-                         const std::vector<std::string>& lenguajes, double bonus);
+                         const std::vector<std::string>& lenguajes, double bonus, int jefe = 0);
 
     void agregarManager(const std::string& nombre, const std::string& apellido,
                        double salarioBase, const std::string& departamento,
-                       int equipoACargo, double bonus);
+                       double bonus, int jefe = 0);
+
+    // Altas en lote: reserva una vez, asigna IDs consecutivos y no escribe
+    // nada por consola. Devuelve el ID del primero. Con iteradores de entrada
+    // (lectura en streaming) cada descriptor se consume antes de avanzar.
+    template <typename Iterador>
+    int agregarLote(Iterador inicio, Iterador fin);
+    int agregarLote(const std::vector<DescriptorEmpleado>& descriptores) {
+        return agregarLote(descriptores.begin(), descriptores.end());
+    }
 
     bool eliminarEmpleado(int id);
+    bool modificarSalario(int id, double nuevoSalario);
+
+    // Igual que las anteriores pero sin escribir por consola (modo por lotes);
+    // devuelven false si el ID no existe
+    bool bajaSinAviso(int id);
+    bool salarioSinAviso(int id, double nuevoSalario);
+
+    // Alta con un ID elegido por quien llama (p. ej. un gestor fragmentado
+    // que reparte IDs globales); false si el ID ya existe o el jefe no vale
+    bool altaConId(int id, const DescriptorEmpleado& d);
+
+    // Jerarquía. El equipo a cargo de cada manager es su número de
+    // subordinados directos y entra en su salario total. Al dar de baja a un
+    // manager su equipo pasa a su jefe. cambiarJefe (jefe 0 = sin jefe)
+    // rechaza jefes que no sean managers o que estén en la rama del empleado.
+    bool cambiarJefe(int id, int jefe, std::string& error);
+
+    // Traslado de departamento y lenguaje nuevo de un developer; se anotan en
+    // el diario como cualquier otro cambio. Rechazan textos vacíos o con
+    // separadores del archivo ('|', y ',' en un lenguaje). Un lenguaje que
+    // el developer ya sabe no se repite.
+    bool cambiarDepartamento(int id, std::string_view departamento, std::string& error);
+    bool agregarLenguaje(int id, std::string_view lenguaje, std::string& error);
+    ReportingTree::Rama rama(int id) const;   // personas y nómina, incluido él
+    std::vector<int> subordinados(int id) const;   // directos
+
+    // Actualización masiva, p. ej. +4% de salario base a los developers de un
+    // departamento: una pasada filtrada por las columnas repartida entre
+    // hilos, una sola entrada de diario y los agregados e índices renovados
+    // de una vez. Devuelve cuántos empleados cambió.
+    std::size_t actualizarMasivo(const SeleccionEmpleados& seleccion, const CambioMasivo& cambio);
+
     void listarTodosEmpleados() const;
+
+    // Escribe por orden de ID los empleados con ID >= desdeId, como mucho
+    // 'cantidad'. Devuelve el ID desde el que sigue la página siguiente, o 0
+    // si no quedan más. Las cabeceras las pone quien llama (empezar/terminar)
+    int escribirInforme(ReportWriter& informe, int desdeId = 0,
+                        std::size_t cantidad = static_cast<std::size_t>(-1)) const;
     void buscarEmpleado(int id) const;
-    bool modificarSalario(int id, double nuevoSalario);
+    const Employee* getEmpleado(int id) const;   // nullptr si no existe
 
-    // Consultas y estadísticas
+    // Consultas y estadísticas. La nómina total y la de cada departamento se
+    // mantienen al día con cada cambio y consultarlas cuesta O(1)
     void empleadosPorDepartamento() const;
     double calcularNominaTotal() const;
-    void guardarEnArchivo() const;
+    double recalcularNominaTotal() const;   // recorre las columnas (comprobación)
+    double calcularNominaDepartamento(const std::string& departamento) const;
+    int getCantidadEnDepartamento(const std::string& departamento) const;
+
+    // Estadísticas del salario total (núcleos vectorizados)
+    kernels::FiltroSalario filtroTipo(TipoEmpleado tipo) const;
+    kernels::FiltroSalario filtroDepartamento(const std::string& departamento) const;
+    kernels::EstadisticasSalario estadisticasSalario(const kernels::FiltroSalario& filtro = {}) const;
+    std::vector<std::size_t> histogramaSalarios(int cubetas, const kernels::FiltroSalario& filtro = {}) const;
+    std::vector<std::pair<std::string, kernels::EstadisticasSalario>> estadisticasPorDepartamento() const;
+    std::vector<std::pair<std::string, kernels::EstadisticasSalario>> estadisticasPorTipo() const;
+    void informeEstadisticas() const;
+
+    /**
+     * Vista de un rango de un índice ordenado: recorre los empleados por
+     * orden ascendente del campo sin copiarlos. Deja de ser válida con
+     * cualquier alta, baja o cambio de salario del gestor.
+     */
+    class Rango {
+    public:
+        class Iterador {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Employee;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Employee*;
+            using reference = const Employee&;
+
+            const Employee& operator*() const { return *rango->gestor->empleados[posicion]; }
+            const Employee* operator->() const { return &**this; }
+            Iterador& operator++();
+            bool operator==(const Iterador& otro) const { return actual == otro.actual; }
+            bool operator!=(const Iterador& otro) const { return actual != otro.actual; }
+
+        private:
+            friend class Rango;
+            Iterador(const Rango* rango, OrderedIndex::Iterador actual);
+            void saltarNoCoincidentes();
+
+            const Rango* rango;
+            OrderedIndex::Iterador actual;
+            std::size_t posicion = 0;   // en 'empleados'
+        };
+
+        Iterador begin() const { return Iterador(this, desde); }
+        Iterador end() const { return Iterador(this, hasta); }
+        std::size_t contar() const;
+
+    private:
+        friend class EmployeeManager;
+        const EmployeeManager* gestor;
+        OrderedIndex::Iterador desde;
+        OrderedIndex::Iterador hasta;
+        bool porDepartamento = false;
+        uint32_t departamento = 0;
+    };
+
+    // Empleados con el campo en [desde, hasta], opcionalmente de un departamento
+    Rango rango(CampoOrden campo, double desde, double hasta, std::string_view departamento = {}) const;
+
+    // Búsqueda por lenguajes con el índice invertido, p. ej. "C++ & Rust & !Java"
+    // (ver LanguageIndex.h). 'ids' recibe los IDs; false si la expresión es inválida
+    bool buscarPorLenguajes(std::string_view expresion, RoaringBitmap& ids, std::string& error) const;
+    uint64_t contarLenguaje(std::string_view lenguaje, std::string_view departamento = {}) const;
+    std::vector<std::pair<std::string, uint64_t>> conteoLenguajes(std::string_view departamento = {}) const;
+
+    // Búsqueda por nombre y apellido (ver NameIndex.h). Por prefijo: "mar gar"
+    // encuentra a María García. Aproximada: tolera acentos y erratas, de mejor
+    // a peor coincidencia (1 = exacta)
+    std::vector<const Employee*> buscarPorPrefijo(std::string_view consulta, std::size_t limite = 10) const;
+    std::vector<std::pair<const Employee*, double>> buscarPorNombre(std::string_view consulta,
+                                                                    std::size_t limite = 10) const;
+
+    // Los k mayores por el campo, de mayor a menor (empates: ID mayor primero)
+    std::vector<const Employee*> topK(std::size_t k, CampoOrden campo = CampoOrden::SalarioTotal,
+                                      std::string_view departamento = {}) const;
+
+    // Ejecución paralela: 1 = serie; los totales coinciden exactamente con la serie
+    void setHilos(unsigned hilos);
+    unsigned getHilos() const { return pool ? pool->getTrabajadores() + 1 : 1; }
+    // Guarda y espera a que esté en disco (con diario: fsync del diario);
+    // false si no llegó, con el motivo ya escrito en cerr
+    bool guardarEnArchivo();
+    // Sin diario: fija una versión y la escribe otro hilo, sin bloquear;
+    // esperarGuardado() espera al último guardado pedido
+    void guardarEnSegundoPlano();
+    bool esperarGuardado();
+    // Guarda en segundo plano cada 'intervalo' si hubo cambios; cero lo desactiva
+    void setAutoguardado(std::chrono::seconds intervalo);
+    uint64_t getCambiosSinGuardar() const { return cambiosSinGuardar; }
+
+    // Versión consistente de todos los empleados que otro hilo puede leer sin
+    // cerrojos mientras este sigue modificando; inválida si ya hay
+    // VersionedStore::MAX_INSTANTANEAS fijadas. Lo que solo retienen
+    // versiones soltadas se libera tras la siguiente operación que modifica.
+    VersionedStore::Instantanea fijarVersion();
+    VersionedStore::Estadisticas getEstadisticasVersiones() const { return versiones.estadisticas(); }
+
+    // Informes sobre una versión fijada; se pueden llamar desde cualquier hilo
+    static double nominaDe(const VersionedStore::Instantanea& version);
+    static std::vector<std::pair<std::string, kernels::EstadisticasSalario>>
+        estadisticasPorDepartamento(const VersionedStore::Instantanea& version);
+
+    // Instantánea binaria (ver Snapshot.h); el archivo de trabajo se detecta por su firma
+    bool guardarSnapshot(const std::string& ruta) const;
+    void exportar(snapshot::Escritor& escritor) const;   // añade todos los empleados
+    bool cargarSnapshot(const std::string& ruta);
+
+    // Diario: compactar() vuelca el diario a la instantánea en segundo plano
+    bool tieneDiario() const { return diario != nullptr; }
+    bool compactar();
 
     // Utilidades
     int getCantidadEmpleados() const { return empleados.size(); }
 };
 
+template <typename Iterador>
+int EmployeeManager::agregarLote(Iterador inicio, Iterador fin) {
+    using Categoria = typename std::iterator_traits<Iterador>::iterator_category;
+    metricas::Temporizador temporizador(metricas::Operacion::AltaLote);
+    // Un lote mayor que lo ya cargado se trata como una carga: los índices
+    // ordenados se reconstruyen al final en lugar de insertar uno a uno
+    bool masivo = false;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Categoria>) {
+        const std::size_t cantidad = static_cast<std::size_t>(std::distance(inicio, fin));
+        reservarAltas(cantidad);
+        masivo = cantidad > empleados.size() && !cargando;
+    }
+
+    if (masivo) empezarCarga();
+    const int primero = siguienteId;
+    for (; inicio != fin; ++inicio) {
+        altaSinAviso(*inicio);
+    }
+    if (masivo) terminarCarga();
+    metricas::contar(metricas::Evento::EmpleadosAlta, static_cast<uint64_t>(siguienteId - primero));
+    revisarPersistencia();
+    return primero;
+}
+
 #endif // EMPLOYEE_MANAGER_H
@@ -0,0 +1,92 @@
+#ifndef EMPLOYEE_PARSER_H
+#define EMPLOYEE_PARSER_H
+
+#include "Employee.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * Lectura y escritura del formato de texto DEV|... / MGR|...
+ * Demuestra: string_view, std::from_chars / std::to_chars, análisis sin
+ *            asignaciones por campo
+ *
+ * Los campos de texto son vistas sobre el búfer original (normalmente un
+ * MappedFile), así que el búfer debe vivir mientras se usen los registros.
+ * Con un ThreadPool el texto se parte en trozos alineados a línea que se
+ * analizan en paralelo; el orden de los registros es el del archivo.
+ * Un noveno campo opcional lleva el ID del jefe; sin jefe no se escribe.
+ */
+struct RegistroTexto {
+    TipoEmpleado tipo;
+    int id;
+    std::string_view nombre;
+    std::string_view apellido;
+    double salarioBase;
+    std::string_view departamento;
+    double bonus;
+    int equipo;                   // solo managers
+    int jefe;                     // ID de su manager; 0 = sin jefe
+    std::string_view lenguajes;   // solo developers, separados por ','
+    std::size_t linea;
+};
+
+struct ErrorLinea {
+    std::size_t linea;
+    std::string motivo;
+};
+
+struct ResultadoAnalisis {
+    std::vector<RegistroTexto> registros;
+    std::vector<ErrorLinea> errores;
+};
+
+// Analiza una sola línea (sin el '\n'). Devuelve false y rellena 'motivo' si está mal formada.
+bool analizarLinea(std::string_view linea, RegistroTexto& registro, std::string& motivo);
+
+// Analiza el texto completo; las líneas vacías se ignoran
+ResultadoAnalisis analizarEmpleados(std::string_view texto, ThreadPool* pool = nullptr);
+
+// Añade el registro en formato de texto (sin '\n') al final de 'destino'.
+// Los números usan la representación más corta que se lee de vuelta sin pérdida.
+void formatearRegistro(const RegistroTexto& registro, std::string& destino);
+
+// Recorre los lenguajes de un RegistroTexto sin copiarlos
+template <typename Funcion>
+void paraCadaLenguaje(std::string_view lenguajes, Funcion&& f) {
+    while (!lenguajes.empty()) {
+        std::size_t coma = lenguajes.find(',');
+        f(lenguajes.substr(0, coma));
+        if (coma == std::string_view::npos) break;
+        lenguajes.remove_prefix(coma + 1);
+    }
+}
+
+// Añade a 'destino' los lenguajes separados por ',', el formato del campo de
+// texto. 'recorrer(f)' llama a f con cada lenguaje, así el mismo código une
+// los de una instantánea, los de un vector o los de un Developer.
+template <typename Recorrer>
+void unirLenguajes(Recorrer&& recorrer, std::string& destino) {
+    bool primero = true;
+    recorrer([&](std::string_view lenguaje) {
+        if (!primero) destino += ',';
+        destino += lenguaje;
+        primero = false;
+    });
+}
+
+// Casos frecuentes: una lista de nombres y los símbolos de un Developer
+inline std::string unirLenguajes(const std::vector<std::string>& lenguajes) {
+    std::string lista;
+    unirLenguajes([&](auto&& f) { for (const std::string& l : lenguajes) f(l); }, lista);
+    return lista;
+}
+
+inline void unirLenguajes(const std::vector<SymbolTable::Simbolo>& lenguajes, std::string& destino) {
+    unirLenguajes([&](auto&& f) { for (SymbolTable::Simbolo s : lenguajes) f(textoSimbolo(s)); }, destino);
+}
+
+#endif // EMPLOYEE_PARSER_H
@@ -0,0 +1,51 @@
+#ifndef ID_INDEX_H
+#define ID_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Clase IdIndex - Tabla hash ID -> posición en el vector de empleados
+ * Demuestra: direccionamiento abierto, sondeo lineal, borrado sin lápidas
+ *
+ * Las búsquedas, inserciones y borrados son O(1) amortizado. Al borrar se
+ * desplazan hacia atrás las entradas del mismo grupo, así la tabla nunca
+ * se llena de lápidas aunque haya muchas bajas.
+ */
+class IdIndex {
+public:
+    static constexpr std::size_t NO_ENCONTRADO = static_cast<std::size_t>(-1);
+
+    IdIndex();
+
+    // Devuelve la posición asociada al ID o NO_ENCONTRADO
+    std::size_t buscar(int id) const;
+
+    // Inserta el ID o actualiza su posición si ya existía
+    void insertar(int id, std::size_t posicion);
+
+    // Elimina el ID; devuelve false si no estaba
+    bool eliminar(int id);
+
+    void reservar(std::size_t cantidad);
+    void limpiar();
+    std::size_t size() const { return ocupadas; }
+
+private:
+    static constexpr uint32_t VACIA = UINT32_MAX;
+
+    struct Entrada {
+        int id;
+        uint32_t posicion;   // VACIA si la celda está libre
+    };
+
+    std::vector<Entrada> tabla;   // capacidad siempre potencia de dos
+    std::size_t mascara;
+    std::size_t ocupadas;
+
+    std::size_t celdaInicial(int id) const;
+    void redimensionar(std::size_t nuevaCapacidad);
+};
+
+#endif // ID_INDEX_H
@@ -0,0 +1,63 @@
+#ifndef LANGUAGE_INDEX_H
+#define LANGUAGE_INDEX_H
+
+#include "RoaringBitmap.h"
+#include "SymbolTable.h"
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * Clase LanguageIndex - Índice invertido lenguaje -> empleados
+ * Demuestra: índices invertidos, mapas de bits comprimidos, análisis
+ *            descendente recursivo de expresiones
+ *
+ * Por cada lenguaje y cada departamento guarda un RoaringBitmap con los
+ * IDs de sus empleados (los IDs no cambian con las bajas, a diferencia de
+ * la posición en el vector). Las búsquedas combinan mapas en lugar de
+ * comparar cadenas empleado a empleado:
+ *
+ *   C++ & Rust & !Java      (y: &, o: |, no: !, paréntesis)
+ *
+ * '!' es relativo a todos los empleados. En un término con '&' primero se
+ * intersecan los lenguajes pedidos, de menor a mayor cardinalidad, y luego
+ * se restan los negados, así "!Java" no construye el complemento.
+ *
+ * Los lenguajes se identifican con su símbolo de la tabla global, el mismo
+ * que guarda Developer, así que altas y bajas no buscan ningún texto.
+ */
+class LanguageIndex {
+public:
+    using Simbolo = SymbolTable::Simbolo;
+
+    // 'departamento' es el símbolo del departamento en la tabla global
+    void agregarEmpleado(int id, const std::vector<Simbolo>& lenguajes, Simbolo departamento);
+    void quitarEmpleado(int id, const std::vector<Simbolo>& lenguajes, Simbolo departamento);
+    void agregarLenguaje(int id, Simbolo lenguaje);
+    void cambiarDepartamento(int id, Simbolo anterior, Simbolo nuevo);
+
+    // false con 'error' si la expresión está mal formada
+    bool evaluar(std::string_view expresion, RoaringBitmap& resultado, std::string& error) const;
+
+    // Cuántos empleados saben el lenguaje (en un departamento, o en todos con NINGUNO)
+    uint64_t contar(std::string_view lenguaje, Simbolo departamento = SymbolTable::NINGUNO) const;
+
+    // (lenguaje, empleados) de todos los lenguajes con alguno, ordenado por nombre
+    std::vector<std::pair<std::string, uint64_t>> conteos(Simbolo departamento = SymbolTable::NINGUNO) const;
+
+    std::size_t bytesUsados() const;
+
+private:
+    std::vector<RoaringBitmap> porLenguaje;       // indexado por símbolo; vacío si no es un lenguaje
+    std::vector<RoaringBitmap> porDepartamento;   // indexado por símbolo de departamento
+    RoaringBitmap todos;
+
+    RoaringBitmap& departamento(Simbolo simbolo);
+    const RoaringBitmap* lenguaje(std::string_view nombre) const;
+    uint64_t contar(const RoaringBitmap& lenguaje, Simbolo departamento) const;
+
+    class Analizador;
+};
+
+#endif // LANGUAGE_INDEX_H
@@ -12,22 +12,25 @@ private:
     int equipoACargo;
     double bonusGestion;
 
+protected:
+    double recalcularSalarioTotal() const override;
+
 public:
-    Manager(int id, const std::string& nombre, const std::string& apellido,
-            double salarioBase, const std::string& departamento,
+    Manager(int id, std::string_view nombre, std::string_view apellido,
+            double salarioBase, std::string_view departamento,
             int equipoACargo, double bonusGestion);
 
     // Implementación de métodos virtuales
-    double calcularSalarioTotal() const override;
-    std::string getTipo() const override { return "Manager"; }
+    std::string_view getTipo() const override { return "Manager"; }
+    ComponentesSalario getComponentesSalario() const override;
     void mostrarInfo() const override;
     std::string serializar() const override;
 
     // Métodos específicos
     int getEquipoACargo() const { return equipoACargo; }
-    void setEquipoACargo(int equipo) { equipoACargo = equipo; }
+    void setEquipoACargo(int equipo);
     double getBonusGestion() const { return bonusGestion; }
-    void setBonusGestion(double bonus) { bonusGestion = bonus; }
+    void setBonusGestion(double bonus);
 };
 
 #endif // MANAGER_H
@@ -0,0 +1,37 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * Clase MappedFile - Archivo proyectado en memoria de solo lectura (RAII)
+ * Demuestra: mmap, gestión de recursos del sistema, string_view
+ *
+ * En POSIX el contenido se proyecta con mmap y se lee sin copiarlo. En
+ * Windows se lee completo a memoria, con la misma interfaz.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& ruta);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool abierto() const { return estaAbierto; }
+    std::string_view contenido() const { return std::string_view(datos, tamano); }
+
+private:
+    const char* datos = nullptr;
+    std::size_t tamano = 0;
+    bool estaAbierto = false;
+#ifdef _WIN32
+    std::string copia;
+#else
+    bool proyectado = false;
+#endif
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,93 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+/**
+ * Métricas internas: temporizadores, contadores y asignaciones
+ * Demuestra: histogramas logarítmico-lineales (estilo HDR), contadores
+ *            repartidos por hilo, RAII, compilación condicional
+ *
+ * Cada operación de EmployeeManager crea un Temporizador que, al
+ * destruirse, anota su latencia en el histograma de la operación y cuántas
+ * asignaciones de memoria hizo el hilo mientras tanto. Los histogramas
+ * tienen 32 subcubetas por potencia de dos (error relativo < 3,2%) hasta
+ * 2^40 ns, así que p99 y p999 salen sin guardar las muestras.
+ *
+ * Los datos se reparten en franjas por hilo para que varios hilos midiendo
+ * a la vez no compartan líneas de caché. Compilando con -DSIN_METRICAS
+ * (make METRICAS=0) todas las clases quedan vacías, las llamadas
+ * desaparecen y el operador new global no se reemplaza.
+ */
+namespace metricas {
+
+enum class Operacion : uint8_t {
+    Carga, Guardado, Busqueda, Alta, AltaLote, Baja, CambioSalario,
+    Nomina, Informe, ReproduccionDiario, Compactacion, CambioMasivo, CambioJefe,
+    CambioDepartamento, CambioLenguajes,
+    CANTIDAD
+};
+
+enum class Evento : uint8_t {
+    FilasCargadas, LineasIgnoradas, BusquedasFallidas, EmpleadosAlta,
+    CambiosReaplicados, Compactaciones,
+    CANTIDAD
+};
+
+enum class Formato { Prometheus, Json };
+
+#ifndef SIN_METRICAS
+
+class Temporizador {
+public:
+    explicit Temporizador(Operacion operacion, uint32_t peso = 1);
+    ~Temporizador() { detener(); }
+
+    Temporizador(const Temporizador&) = delete;
+    Temporizador& operator=(const Temporizador&) = delete;
+
+    // Para operaciones muy baratas: mide una de cada 64 llamadas y la
+    // anota con peso 64, así los totales y percentiles siguen siendo estimaciones insesgadas
+    static Temporizador muestreado(Operacion operacion);
+
+    // Anota ya la medición (p. ej. antes de escribir por consola)
+    void detener();
+
+private:
+    Operacion operacion;
+    uint32_t peso;   // 0 = inactivo
+    int64_t inicio;
+    uint64_t asignacionesInicio;
+};
+
+void contar(Evento evento, uint64_t cantidad = 1);
+
+#else
+
+class Temporizador {
+public:
+    explicit Temporizador(Operacion, uint32_t = 1) {}
+    ~Temporizador() {}   // no trivial: evita avisos de variable sin usar
+    static Temporizador muestreado(Operacion operacion) { return Temporizador(operacion); }
+    void detener() {}
+};
+
+inline void contar(Evento, uint64_t = 1) {}
+
+#endif
+
+const char* nombreOperacion(Operacion operacion);
+const char* nombreEvento(Evento evento);
+
+// Vuelca el estado actual; destino "-" es la salida estándar
+void escribir(std::ostream& salida, Formato formato);
+bool volcar(const std::string& destino, Formato formato, std::string& error);
+
+// Formato según la extensión: .json -> Json, cualquier otra -> Prometheus
+Formato formatoPorRuta(const std::string& ruta);
+
+} // namespace metricas
+
+#endif // METRICS_H
@@ -0,0 +1,89 @@
+#ifndef NAME_INDEX_H
+#define NAME_INDEX_H
+
+#include "RoaringBitmap.h"
+#include "StringInterner.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Clase NameIndex - Búsqueda de empleados por nombre y apellido
+ * Demuestra: normalización de texto UTF-8, índice de trigramas, arreglo
+ *            ordenado de prefijos, distancia de edición acotada
+ *
+ * Nombre y apellido se normalizan (minúsculas, sin acentos del Latin-1 ni
+ * apóstrofos) y se parten en palabras. Cada palabra distinta se guarda una
+ * vez con un RoaringBitmap de los IDs que la usan, así que el trabajo de
+ * una búsqueda depende de las palabras distintas y no de los empleados:
+ *
+ *   - Prefijo ("mar gar"): cada palabra de la consulta es el comienzo de
+ *     alguna del empleado. Las palabras del índice se guardan por orden
+ *     alfabético y el rango de un prefijo se halla con búsqueda binaria.
+ *   - Aproximada ("Gonzales"): por cada palabra de la consulta, las del
+ *     índice a distancia de edición pequeña (1 de 3 a 6 letras, 2 a partir
+ *     de 7; las transposiciones cuentan 1). Los candidatos salen del índice
+ *     de trigramas ("$$g", "$go", "gon", ...): con d ediciones se comparten
+ *     al menos n + 2 - 4d de los n + 2 trigramas de la consulta, así que
+ *     basta mirar las listas menos frecuentes.
+ *     Se ordena por la media de 1 - distancia / longitud de cada palabra.
+ *
+ * Las palabras nuevas van a un segundo arreglo ordenado pequeño que se
+ * funde con el principal cuando crece; durante una carga se acumulan y se
+ * ordenan todas en terminarCarga(). Las bajas quitan el ID de sus palabras;
+ * cuando las que ya no usa nadie pasan de la mitad, el diccionario se
+ * rehace solo con las vivas, así los nombres dados de baja no ocupan
+ * memoria para siempre.
+ */
+class NameIndex {
+public:
+    struct Coincidencia {
+        int id;
+        double puntuacion;   // 1 = todas las palabras exactas
+    };
+
+    void agregarEmpleado(int id, std::string_view nombre, std::string_view apellido);
+    void quitarEmpleado(int id, std::string_view nombre, std::string_view apellido);
+
+    void empezarCarga();
+    void terminarCarga();
+
+    // Con una palabra, por orden alfabético de la palabra encontrada y luego
+    // de ID; con varias, por ID. Como mucho 'limite'.
+    std::vector<int> buscarPrefijo(std::string_view consulta, std::size_t limite) const;
+
+    // De mejor a peor puntuación; como mucho 'limite'
+    std::vector<Coincidencia> buscarAproximado(std::string_view consulta, std::size_t limite) const;
+
+    std::size_t cantidadPalabras() const { return palabras.size(); }
+    std::size_t bytesUsados() const;
+
+    // Añade a 'resultado' las palabras normalizadas de 'texto', separadas por un espacio
+    static void normalizar(std::string_view texto, std::string& resultado);
+
+private:
+    using Simbolo = StringInterner::Simbolo;
+
+    StringInterner palabras;
+    std::vector<RoaringBitmap> empleadosPorPalabra;   // indexado por símbolo de 'palabras'
+    std::unordered_map<uint32_t, std::vector<Simbolo>> porTrigrama;   // en orden de símbolo
+    std::vector<Simbolo> ordenadas;   // por orden alfabético
+    std::vector<Simbolo> recientes;   // también ordenadas; se funden con las anteriores al crecer
+    std::size_t sinEmpleados = 0;     // palabras cuyo mapa quedó vacío
+    bool cargando = false;
+    std::string temporal;   // para normalizar en altas y bajas sin reservar memoria
+
+    Simbolo registrarPalabra(std::string_view palabra);
+    void fundirRecientes();
+    void compactar();
+
+    // Palabras con el prefijo por orden alfabético; f devuelve false para parar
+    template <typename Funcion>
+    void paraCadaConPrefijo(std::string_view prefijo, Funcion&& f) const;
+
+    // (palabra, puntuación) parecidas a 'palabra', de mejor a peor
+    std::vector<std::pair<Simbolo, double>> variantes(std::string_view palabra, std::size_t maximo) const;
+};
+
+#endif // NAME_INDEX_H
@@ -0,0 +1,86 @@
+#ifndef ORDERED_INDEX_H
+#define ORDERED_INDEX_H
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+/**
+ * Clase OrderedIndex - Índice ordenado (clave, ID) por hojas
+ * Demuestra: árbol B+ de dos niveles, búsqueda binaria, recorridos por rango
+ *
+ * Las entradas se guardan ordenadas en hojas de hasta 2 * TAMANO_HOJA
+ * elementos contiguos; un vector con la primera entrada de cada hoja hace
+ * de nivel interno. Insertar o borrar cuesta una búsqueda binaria en cada
+ * nivel más desplazar como mucho una hoja, y un recorrido por rango lee
+ * memoria contigua. El ID desempata claves iguales, así cada entrada es
+ * única y se puede borrar conociendo solo (clave, ID).
+ */
+class OrderedIndex {
+public:
+    static constexpr std::size_t TAMANO_HOJA = 256;
+
+    struct Entrada {
+        double clave;
+        int id;
+
+        bool operator<(const Entrada& otra) const {
+            return clave < otra.clave || (clave == otra.clave && id < otra.id);
+        }
+        bool operator==(const Entrada& otra) const { return clave == otra.clave && id == otra.id; }
+    };
+
+    // Posición (hoja, elemento); end() es (número de hojas, 0)
+    class Iterador {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Entrada;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entrada*;
+        using reference = const Entrada&;
+
+        Iterador() = default;
+        const Entrada& operator*() const { return (*hojas)[hoja][pos]; }
+        const Entrada* operator->() const { return &**this; }
+        Iterador& operator++();
+        Iterador& operator--();
+        bool operator==(const Iterador& otro) const { return hoja == otro.hoja && pos == otro.pos; }
+        bool operator!=(const Iterador& otro) const { return !(*this == otro); }
+
+    private:
+        friend class OrderedIndex;
+        Iterador(const std::vector<std::vector<Entrada>>* hojas, std::size_t hoja, std::size_t pos)
+            : hojas(hojas), hoja(hoja), pos(pos) {}
+
+        const std::vector<std::vector<Entrada>>* hojas = nullptr;
+        std::size_t hoja = 0;
+        std::size_t pos = 0;
+    };
+
+    void insertar(double clave, int id);
+    bool eliminar(double clave, int id);   // false si no estaba
+
+    // Sustituye el contenido; más rápido que insertar una a una tras una carga
+    void construir(std::vector<Entrada> entradas);
+    void limpiar();
+
+    std::size_t size() const { return cantidad; }
+    bool empty() const { return cantidad == 0; }
+
+    Iterador begin() const { return Iterador(&hojas, 0, 0); }
+    Iterador end() const { return Iterador(&hojas, hojas.size(), 0); }
+
+    // Primera entrada con clave >= 'clave' / con clave > 'clave'
+    Iterador primeroNoMenor(double clave) const;
+    Iterador primeroMayor(double clave) const;
+
+private:
+    std::vector<std::vector<Entrada>> hojas;   // ninguna vacía
+    std::vector<Entrada> primeros;             // primeros[i] == hojas[i].front()
+    std::size_t cantidad = 0;
+
+    std::size_t hojaPara(const Entrada& e) const;
+    Iterador cotaInferior(const Entrada& e) const;
+};
+
+#endif // ORDERED_INDEX_H
@@ -0,0 +1,15 @@
+#ifndef PROCESS_STATS_H
+#define PROCESS_STATS_H
+
+#include <cstddef>
+
+/**
+ * Consumo de memoria del proceso
+ * Demuestra: getrusage, /proc/self/statm
+ *
+ * Devuelven KiB, o 0 donde el sistema no ofrece el dato.
+ */
+std::size_t memoriaPicoKB();     // máximo de memoria residente (peak RSS)
+std::size_t memoriaActualKB();   // memoria residente actual
+
+#endif // PROCESS_STATS_H
@@ -0,0 +1,104 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+/**
+ * Protocolo binario del servidor de consultas
+ * Demuestra: tramas con prefijo de longitud, codificación little-endian
+ *            explícita, canalización (pipelining)
+ *
+ *   petición:  uint32 longitud | uint8 operación | datos
+ *   respuesta: uint32 longitud | uint8 estado    | datos
+ *
+ * 'longitud' cuenta el byte de operación/estado más los datos. Un cliente
+ * puede enviar varias peticiones sin esperar: las respuestas llegan en el
+ * mismo orden. Enteros y doubles van en little-endian sea cual sea la CPU.
+ *
+ *   BUSCAR         int32 id                -> OK texto | NO_ENCONTRADO
+ *   ALTA           texto "DEV|nombre|..."  -> OK int32 id
+ *   SALARIO        int32 id, f64 salario   -> OK | NO_ENCONTRADO
+ *   BAJA           int32 id                -> OK | NO_ENCONTRADO
+ *   NOMINA                                 -> OK f64 total, uint32 empleados
+ *   DEPARTAMENTOS                          -> OK uint32 n, n x (uint16 largo, nombre,
+ *                                             uint32 empleados, f64 suma, media, mín., máx.)
+ *   PING                                   -> OK
+ *
+ * El texto de ALTA es el de un comando ALTA de BatchProcessor sin "ALTA|".
+ * Si algo está mal formado la respuesta es INVALIDA con el motivo en texto.
+ */
+namespace protocolo {
+
+enum class Operacion : uint8_t {
+    Buscar = 1, Alta = 2, Salario = 3, Baja = 4, Nomina = 5, Departamentos = 6, Ping = 7
+};
+
+enum class Estado : uint8_t { Ok = 0, NoEncontrado = 1, Invalida = 2 };
+
+constexpr std::size_t CABECERA = 4;
+constexpr uint32_t TRAMA_MAXIMA = 1 << 20;   // una trama mayor cierra la conexión
+
+inline void anadirU16(std::string& d, uint16_t v) {
+    d += static_cast<char>(v & 0xFF);
+    d += static_cast<char>(v >> 8);
+}
+
+inline void anadirU32(std::string& d, uint32_t v) {
+    for (int i = 0; i < 4; ++i) d += static_cast<char>((v >> (8 * i)) & 0xFF);
+}
+
+inline void anadirF64(std::string& d, double v) {
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    for (int i = 0; i < 8; ++i) d += static_cast<char>((bits >> (8 * i)) & 0xFF);
+}
+
+inline uint32_t decodificarU32(const char* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    return v;
+}
+
+// Lectores que consumen del principio de 'd'; false si no quedan bytes suficientes
+inline bool leerU16(std::string_view& d, uint16_t& v) {
+    if (d.size() < 2) return false;
+    v = static_cast<uint16_t>(static_cast<unsigned char>(d[0]) | (static_cast<unsigned char>(d[1]) << 8));
+    d.remove_prefix(2);
+    return true;
+}
+
+inline bool leerU32(std::string_view& d, uint32_t& v) {
+    if (d.size() < 4) return false;
+    v = decodificarU32(d.data());
+    d.remove_prefix(4);
+    return true;
+}
+
+inline bool leerF64(std::string_view& d, double& v) {
+    if (d.size() < 8) return false;
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i) bits |= static_cast<uint64_t>(static_cast<unsigned char>(d[i])) << (8 * i);
+    std::memcpy(&v, &bits, sizeof(v));
+    d.remove_prefix(8);
+    return true;
+}
+
+// Abre una trama en 'd' con la longitud aún por rellenar; devuelve su posición
+inline std::size_t abrirTrama(std::string& d, uint8_t codigo) {
+    std::size_t inicio = d.size();
+    d.append(CABECERA, '\0');
+    d += static_cast<char>(codigo);
+    return inicio;
+}
+
+inline void cerrarTrama(std::string& d, std::size_t inicio) {
+    uint32_t longitud = static_cast<uint32_t>(d.size() - inicio - CABECERA);
+    for (int i = 0; i < 4; ++i) d[inicio + i] = static_cast<char>((longitud >> (8 * i)) & 0xFF);
+}
+
+} // namespace protocolo
+
+#endif // PROTOCOL_H
@@ -0,0 +1,75 @@
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include "EmployeeManager.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Clase QueryServer - Servidor de consultas sobre un EmployeeManager
+ * Demuestra: bucle de eventos con epoll, sockets no bloqueantes,
+ *            canalización de peticiones, confirmación en grupo
+ *
+ * Escucha en un socket Unix ("unix:/ruta") o en TCP solo por loopback
+ * ("tcp:puerto", 127.0.0.1) y habla el protocolo de Protocol.h. Un único
+ * hilo atiende todas las conexiones, así que el gestor no necesita
+ * cerrojos. En cada vuelta del bucle se procesan todas las tramas
+ * completas que hayan llegado; si alguna modificó datos y el gestor tiene
+ * diario, se sincroniza una sola vez antes de enviar las respuestas: una
+ * respuesta OK a una modificación significa que ya está en disco.
+ *
+ * Solo está disponible en Linux; en otros sistemas escuchar() falla.
+ */
+class QueryServer {
+public:
+    explicit QueryServer(EmployeeManager& manager);
+    ~QueryServer();
+
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    bool escuchar(const std::string& direccion, std::string& error);
+
+    // Atiende conexiones hasta que se llame a detener()
+    bool ejecutar(std::string& error);
+
+    // Se puede llamar desde otro hilo o desde un manejador de señal
+    void detener();
+
+    uint64_t getPeticiones() const { return peticiones; }
+    uint64_t getConexiones() const { return conexionesAceptadas; }
+    uint64_t getSincronizaciones() const { return sincronizaciones; }
+
+private:
+    struct Conexion {
+        int fd;
+        std::string entrada;
+        std::string salida;
+        std::size_t enviado = 0;
+        uint32_t eventos = 0;      // intereses registrados en epoll
+        bool finLectura = false;   // el cliente ya no enviará más
+    };
+
+    void aceptar();
+    bool leer(Conexion& c);
+    bool procesarTramas(Conexion& c, bool& modifico);
+    bool atender(uint8_t operacion, std::string_view datos, std::string& salida);
+    bool enviar(Conexion& c);
+    void cerrar(int fd);
+
+    EmployeeManager& manager;
+    int epollFd = -1;
+    int escuchaFd = -1;
+    int despertadorFd = -1;
+    std::string rutaUnix;   // se borra al cerrar
+    std::unordered_map<int, std::unique_ptr<Conexion>> conexiones;
+
+    uint64_t peticiones = 0;
+    uint64_t conexionesAceptadas = 0;
+    uint64_t sincronizaciones = 0;
+};
+
+#endif // QUERY_SERVER_H
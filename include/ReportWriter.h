@@ -0,0 +1,61 @@
+#ifndef REPORT_WRITER_H
+#define REPORT_WRITER_H
+
+#include "Developer.h"
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+enum class FormatoInforme { Tabla, Csv, JsonLineas };
+
+// "tabla", "csv" o "jsonl"; false si el nombre no es ninguno de ellos
+bool formatoInformePorNombre(std::string_view nombre, FormatoInforme& formato);
+
+/**
+ * Clase ReportWriter - Listados de empleados con salida en búfer
+ * Demuestra: formateo sin asignaciones (std::to_chars), E/S por bloques
+ *
+ * Cada fila se formatea directamente en un búfer reutilizable: los textos
+ * se copian desde la tabla de símbolos y los números con to_chars, sin
+ * cadenas temporales ni manipuladores de iostream. El búfer se escribe
+ * con fwrite al pasar de 1 MiB, así un listado completo queda limitado
+ * por la E/S y no por el formateo.
+ *
+ *   Tabla       columnas alineadas, importes con dos decimales
+ *   Csv         cabecera + una línea por empleado (RFC 4180)
+ *   JsonLineas  un objeto JSON por línea, sin cabecera
+ *
+ * Para paginar basta con escribir cada página con el mismo objeto entre
+ * empezar() y terminar() (ver EmployeeManager::escribirInforme).
+ */
+class ReportWriter {
+public:
+    static constexpr std::size_t TAMANO_BUFFER = 1 << 20;
+
+    ReportWriter(std::FILE* salida, FormatoInforme formato);
+    ~ReportWriter();   // vacía lo pendiente
+
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    void empezar();   // cabecera de la tabla o del CSV
+    void escribir(const Employee& emp);
+    bool terminar();  // pie de la tabla y vaciado; false si falló la escritura
+
+    void vaciar();
+    std::size_t getFilas() const { return filas; }
+
+private:
+    std::FILE* salida;
+    FormatoInforme formato;
+    std::string buffer;
+    std::string lista;   // lenguajes unidos para el CSV
+    std::size_t filas = 0;
+
+    void filaTabla(const Employee& emp, const ComponentesSalario& c, const Developer::Lenguajes& lenguajes);
+    void filaCsv(const Employee& emp, const ComponentesSalario& c, const Developer::Lenguajes& lenguajes);
+    void filaJson(const Employee& emp, const ComponentesSalario& c, const Developer::Lenguajes& lenguajes);
+};
+
+#endif // REPORT_WRITER_H
@@ -0,0 +1,100 @@
+#ifndef REPORTING_TREE_H
+#define REPORTING_TREE_H
+
+#include "IdIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Clase ReportingTree - Jerarquía de jefes con agregados por rama
+ * Demuestra: recorrido de Euler, treap implícito, agregados por subárbol
+ *
+ * Cada empleado aporta dos marcas al recorrido de Euler del bosque de
+ * jefes: una de apertura y otra de cierre, y entre ambas queda toda su
+ * rama. Un Fenwick sobre ese recorrido sumaría rangos en O(log n), pero
+ * mover una rama desplazaría todas las posiciones detrás. Por eso el
+ * recorrido vive en un treap implícito (ordenado por posición, sin clave):
+ * cada nodo guarda el tamaño, las personas y la nómina de su subárbol, y
+ * cortar una rama y pegarla bajo otro jefe son un par de divisiones y
+ * uniones. Altas, bajas, cambios de jefe, cambios de salario y consultas
+ * de rama cuestan O(log n) esperado.
+ */
+class ReportingTree {
+public:
+    // Totales de una rama, incluido el propio jefe
+    struct Rama {
+        uint32_t personas = 0;
+        double nomina = 0.0;
+    };
+
+    // Para construir(): jefe 0 = sin jefe
+    struct Enlace {
+        int id;
+        int jefe;
+        double salario;
+    };
+
+    // false si el ID ya está o el jefe (distinto de 0) no está
+    bool agregar(int id, double salario, int jefe);
+
+    // Sus subordinados pasan a colgar de su jefe; false si no estaba
+    bool quitar(int id);
+
+    // false si alguno no está o el jefe nuevo pertenece a la rama de 'id'
+    bool mover(int id, int jefe);
+
+    void actualizarSalario(int id, double salario);
+
+    bool contiene(int id) const { return indice.buscar(id) != IdIndex::NO_ENCONTRADO; }
+    Rama rama(int id) const;   // vacía si no está
+    bool estaEnRama(int jefe, int id) const;   // true también si jefe == id
+    std::vector<int> subordinados(int id) const;   // directos, en orden de recorrido
+
+    // Sustituye el contenido en O(n). Los enlaces a jefes que no están o que
+    // cerrarían un ciclo se descartan; devuelve los IDs que se quedan sin jefe
+    std::vector<int> construir(const std::vector<Enlace>& enlaces);
+
+    // Cambios de salario en bloque: fijar sin propagar y recalcular al final
+    void fijarSalario(int id, double salario);
+    void recalcularAgregados();
+
+    void limpiar();
+    std::size_t size() const { return indice.size(); }
+
+private:
+    static constexpr uint32_t NULO = UINT32_MAX;
+
+    // Marcas 2 * hueco (apertura) y 2 * hueco + 1 (cierre)
+    struct Nodo {
+        uint32_t izq = NULO;
+        uint32_t der = NULO;
+        uint32_t padre = NULO;
+        uint32_t prioridad = 0;
+        uint32_t tamano = 1;     // marcas del subárbol
+        uint32_t personas = 0;   // aperturas del subárbol
+        double nomina = 0.0;
+    };
+
+    std::vector<Nodo> nodos;
+    std::vector<double> salarios;   // por hueco
+    std::vector<int> ids;           // por hueco
+    std::vector<uint32_t> libres;   // huecos reutilizables
+    IdIndex indice;                 // ID -> hueco
+    uint32_t raiz = NULO;           // todo el bosque, una rama tras otra
+    uint32_t semilla = 2463534242u;
+
+    uint32_t aleatorio();
+    uint32_t tamano(uint32_t t) const { return t == NULO ? 0 : nodos[t].tamano; }
+    void recalcular(uint32_t t);
+    uint32_t posicion(uint32_t t) const;
+    uint32_t sucesor(uint32_t t) const;   // NULO si es la última marca
+    void dividir(uint32_t t, uint32_t k, uint32_t& primeros, uint32_t& resto);
+    uint32_t unir(uint32_t a, uint32_t b);
+    void sumarRango(uint32_t t, int64_t desde, int64_t hasta, Rama& total) const;
+    void insertarTras(uint32_t abrirJefe, uint32_t tramo);
+    uint32_t cortar(uint32_t hueco);   // separa la rama del hueco y la devuelve
+    uint32_t nuevoHueco(int id, double salario);
+};
+
+#endif // REPORTING_TREE_H
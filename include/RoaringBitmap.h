@@ -0,0 +1,110 @@
+#ifndef ROARING_BITMAP_H
+#define ROARING_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Clase RoaringBitmap - Conjunto comprimido de enteros de 32 bits
+ * Demuestra: contenedores adaptativos (arreglo / mapa de bits), popcount,
+ *            operaciones de conjuntos palabra a palabra
+ *
+ * Como en Roaring, los 16 bits altos eligen un contenedor y los 16 bajos
+ * se guardan en él: un arreglo ordenado de uint16_t mientras tenga como
+ * mucho 4096 valores y un mapa de 65536 bits (1024 palabras) a partir de
+ * ahí. Un conjunto disperso ocupa 2 bytes por valor y uno denso 1 bit;
+ * las intersecciones entre mapas son AND de palabras más popcount.
+ */
+class RoaringBitmap {
+public:
+    void agregar(uint32_t valor);
+    bool quitar(uint32_t valor);   // false si no estaba
+    bool contiene(uint32_t valor) const;
+
+    uint64_t cardinalidad() const;
+    bool empty() const { return contenedores.empty(); }
+
+    // Operaciones de conjuntos; 'diferencia' es a AND NOT b
+    static RoaringBitmap interseccion(const RoaringBitmap& a, const RoaringBitmap& b);
+    static RoaringBitmap unir(const RoaringBitmap& a, const RoaringBitmap& b);
+    static RoaringBitmap diferencia(const RoaringBitmap& a, const RoaringBitmap& b);
+
+    // |a AND b| sin construir el resultado
+    static uint64_t cardinalidadInterseccion(const RoaringBitmap& a, const RoaringBitmap& b);
+
+    // Recorre los valores en orden ascendente
+    template <typename Funcion>
+    void paraCada(Funcion&& f) const;
+
+    // Igual, pero se detiene cuando f devuelve false; devuelve false si se detuvo
+    template <typename Funcion>
+    bool paraCadaMientras(Funcion&& f) const;
+
+    std::size_t bytesUsados() const;
+
+private:
+    static constexpr std::size_t MAXIMO_ARREGLO = 4096;
+    static constexpr std::size_t PALABRAS = 1024;   // 65536 bits
+
+    struct Contenedor {
+        uint16_t clave;              // 16 bits altos
+        uint32_t cardinalidad = 0;
+        std::vector<uint16_t> arreglo;   // ordenado; vacío si es mapa
+        std::vector<uint64_t> bits;      // PALABRAS palabras; vacío si es arreglo
+
+        bool esMapa() const { return !bits.empty(); }
+        bool contiene(uint16_t bajo) const;
+        void aMapa();
+        void normalizar();   // vuelve a arreglo si cabe
+    };
+
+    std::vector<Contenedor> contenedores;   // ordenados por clave
+
+    Contenedor* buscar(uint16_t clave);
+    const Contenedor* buscar(uint16_t clave) const;
+
+    static Contenedor intersecar(const Contenedor& a, const Contenedor& b);
+    static Contenedor unirContenedores(const Contenedor& a, const Contenedor& b);
+    static Contenedor restar(const Contenedor& a, const Contenedor& b);
+    static uint64_t contarInterseccion(const Contenedor& a, const Contenedor& b);
+};
+
+template <typename Funcion>
+void RoaringBitmap::paraCada(Funcion&& f) const {
+    for (const Contenedor& c : contenedores) {
+        const uint32_t alto = static_cast<uint32_t>(c.clave) << 16;
+        if (!c.esMapa()) {
+            for (uint16_t bajo : c.arreglo) f(alto | bajo);
+            continue;
+        }
+        for (std::size_t w = 0; w < PALABRAS; ++w) {
+            for (uint64_t palabra = c.bits[w]; palabra != 0; palabra &= palabra - 1) {
+                f(alto | static_cast<uint32_t>(w * 64 + static_cast<std::size_t>(__builtin_ctzll(palabra))));
+            }
+        }
+    }
+}
+
+template <typename Funcion>
+bool RoaringBitmap::paraCadaMientras(Funcion&& f) const {
+    for (const Contenedor& c : contenedores) {
+        const uint32_t alto = static_cast<uint32_t>(c.clave) << 16;
+        if (!c.esMapa()) {
+            for (uint16_t bajo : c.arreglo) {
+                if (!f(alto | bajo)) return false;
+            }
+            continue;
+        }
+        for (std::size_t w = 0; w < PALABRAS; ++w) {
+            for (uint64_t palabra = c.bits[w]; palabra != 0; palabra &= palabra - 1) {
+                if (!f(alto | static_cast<uint32_t>(w * 64 + static_cast<std::size_t>(__builtin_ctzll(palabra))))) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+#endif // ROARING_BITMAP_H
@@ -0,0 +1,147 @@
+#ifndef SALARY_KERNELS_H
+#define SALARY_KERNELS_H
+
+#include "Employee.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * Núcleos vectorizados (AVX2 / SSE2 / escalar) sobre las columnas de salario
+ * Demuestra: SIMD con intrínsecos, despacho en tiempo de ejecución,
+ *            suma compensada determinista
+ *
+ * Todas las variantes siguen el mismo orden de operaciones: el rango se
+ * divide en bloques de ELEMENTOS_POR_BLOQUE, cada bloque se suma con 4
+ * carriles de Kahan (el elemento i va al carril i % 4) y los bloques se
+ * combinan por parejas. Por eso el resultado es idéntico bit a bit sea
+ * cual sea el juego de instrucciones o el número de hilos que lo calcule:
+ * con un ThreadPool cada hilo suma un tramo de bloques y las sumas de
+ * bloque se combinan después en el mismo orden que en serie.
+ */
+namespace kernels {
+
+enum class NivelSimd { Escalar, SSE2, AVX2 };
+
+NivelSimd nivelDetectado();            // el mejor que soporta la CPU
+NivelSimd nivelActivo();               // el que se está usando
+void forzarNivel(NivelSimd nivel);     // se limita a lo que soporta la CPU
+const char* nombreNivel(NivelSimd nivel);
+
+constexpr std::size_t ELEMENTOS_POR_BLOQUE = 1024;
+
+inline std::size_t numeroBloques(std::size_t n) {
+    return (n + ELEMENTOS_POR_BLOQUE - 1) / ELEMENTOS_POR_BLOQUE;
+}
+
+// Vista de solo lectura de las columnas (ver EmployeeColumns)
+struct ColumnasSalario {
+    const double* base;
+    const double* bonus;
+    const int32_t* lenguajes;
+    const int32_t* equipos;
+    const TipoEmpleado* tipos;
+    const uint32_t* departamentos;
+    std::size_t n;
+};
+
+// Filtro por tipo y/o departamento (símbolo del índice de departamentos)
+struct FiltroSalario {
+    bool porTipo = false;
+    TipoEmpleado tipo = TipoEmpleado::Developer;
+    bool porDepartamento = false;
+    uint32_t departamento = 0;
+};
+
+// Agregados que no dependen del orden (cantidad, mínimo, máximo)
+struct ResumenParcial {
+    std::size_t cantidad = 0;
+    double minimo = std::numeric_limits<double>::infinity();
+    double maximo = -std::numeric_limits<double>::infinity();
+
+    void combinar(const ResumenParcial& otro);
+};
+
+struct EstadisticasSalario {
+    std::size_t cantidad = 0;
+    double suma = 0.0;
+    double minimo = 0.0;
+    double maximo = 0.0;
+    double media = 0.0;
+    double varianza = 0.0;   // poblacional
+};
+
+// Suma corrida con compensación de Neumaier, para totales que se mantienen
+// a base de sumas y restas sueltas (altas, bajas, cambios de salario). El
+// error no crece con el número de ajustes como en un double simple.
+struct SumaCompensada {
+    double suma = 0.0;
+    double compensacion = 0.0;
+
+    void sumar(double x) {
+        double t = suma + x;
+        if (std::fabs(suma) >= std::fabs(x)) compensacion += (suma - t) + x;
+        else compensacion += (x - t) + suma;
+        suma = t;
+    }
+    double valor() const { return suma + compensacion; }
+    void reiniciar(double valorInicial = 0.0) {
+        suma = valorInicial;
+        compensacion = 0.0;
+    }
+};
+
+// Primitivas por rango de bloques [primerBloque, finBloque): escriben la suma
+// de cada bloque en sumas[b - primerBloque]. Permiten repartir bloques entre hilos.
+void sumarBloques(const ColumnasSalario& c, const FiltroSalario& f,
+                  std::size_t primerBloque, std::size_t finBloque,
+                  double* sumas, ResumenParcial& resumen);
+void sumarCuadradosBloques(const ColumnasSalario& c, const FiltroSalario& f, double media,
+                           std::size_t primerBloque, std::size_t finBloque, double* sumas);
+void acumularHistograma(const ColumnasSalario& c, const FiltroSalario& f,
+                        double minimo, double maximo, std::size_t inicio, std::size_t fin,
+                        std::size_t* cubetas, int numCubetas);
+
+// Combina las sumas de bloque por parejas, siempre en el mismo orden
+double sumaPorParejas(const double* sumas, std::size_t cantidad);
+
+// Consultas completas; con pool == nullptr se ejecutan en el hilo actual
+double sumaTotal(const ColumnasSalario& c, const FiltroSalario& f = {}, ThreadPool* pool = nullptr);
+EstadisticasSalario calcularEstadisticas(const ColumnasSalario& c, const FiltroSalario& f = {},
+                                         ThreadPool* pool = nullptr);
+std::vector<std::size_t> calcularHistograma(const ColumnasSalario& c, const FiltroSalario& f,
+                                            double minimo, double maximo, int numCubetas,
+                                            ThreadPool* pool = nullptr);
+
+enum class Agrupacion { PorTipo, PorDepartamento };
+
+// Estadísticas de todos los grupos en una sola pasada. El resultado se indexa
+// por tipo o por símbolo de departamento y coincide bit a bit con filtrar
+// cada grupo por separado. Pensado para pocos grupos (memoria bloques x grupos).
+std::vector<EstadisticasSalario> estadisticasPorGrupo(const ColumnasSalario& c, Agrupacion agrupacion,
+                                                      std::size_t numGrupos, ThreadPool* pool = nullptr);
+
+// Selección de una actualización masiva: el filtro de tipo y departamento,
+// un equipo mínimo (> 0 deja solo managers) y un rango de salario base
+struct FiltroMasivo {
+    FiltroSalario grupo;
+    int equipoMinimo = 0;
+    double baseMinima = -std::numeric_limits<double>::infinity();
+    double baseMaxima = std::numeric_limits<double>::infinity();
+};
+
+// Una pasada filtrada por las columnas, repartida entre hilos por tramos de
+// bloques: deja en 'posiciones' (por orden) las filas que cumplen el filtro y
+// en 'valores' el nuevo valor del campo, max(0, actual * factor + sumando),
+// donde 'actual' es el bonus si 'sobreBonus' y si no el salario base
+void calcularMasivo(const ColumnasSalario& c, const FiltroMasivo& f, bool sobreBonus,
+                    double factor, double sumando, std::vector<uint32_t>& posiciones,
+                    std::vector<double>& valores, ThreadPool* pool = nullptr);
+
+} // namespace kernels
+
+#endif // SALARY_KERNELS_H
@@ -0,0 +1,144 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "EmployeeParser.h"
+#include "StringInterner.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Formato binario de instantánea (snapshot) de empleados
+ * Demuestra: formatos binarios versionados, columnas de ancho fijo,
+ *            tabla de cadenas, suma de verificación
+ *
+ * Disposición del archivo (little-endian, secciones alineadas a 8 bytes):
+ *   CabeceraSnapshot
+ *   IDS            int32[n]        TIPOS          uint8[n]
+ *   SALARIOS_BASE  double[n]       BONUS          double[n]
+ *   EQUIPOS        int32[n]        NOMBRES        uint32[n]  (índice de cadena)
+ *   APELLIDOS      uint32[n]       DEPARTAMENTOS  uint32[n]
+ *   LENG_INICIO    uint32[n + 1]   LENGUAJES      uint32[numLenguajes]
+ *   CADENAS_INICIO uint64[numCadenas + 1]   CADENAS_DATOS  char[]
+ *   JEFES          int32[n]        (desde la versión 2; 0 = sin jefe)
+ *
+ * Los desplazamientos de cada sección van en la cabecera, así una versión
+ * futura puede añadir secciones sin romper a los lectores anteriores. La
+ * versión 1 acaba en CADENAS_DATOS y su cabecera trae una sección menos;
+ * se sigue leyendo, con todos los empleados sin jefe.
+ */
+namespace snapshot {
+
+constexpr char MAGIA[8] = {'E', 'M', 'P', 'S', 'N', 'A', 'P', '\0'};
+constexpr uint32_t VERSION = 2;
+constexpr uint32_t MARCA_ORDEN = 0x01020304;
+
+enum Seccion : uint32_t {
+    IDS, TIPOS, SALARIOS_BASE, BONUS, EQUIPOS, NOMBRES, APELLIDOS, DEPARTAMENTOS,
+    LENG_INICIO, LENGUAJES, CADENAS_INICIO, CADENAS_DATOS, JEFES, NUM_SECCIONES
+};
+
+struct CabeceraSnapshot {
+    char magia[8];
+    uint32_t version;
+    uint32_t marcaOrden;      // detecta archivos escritos con otro orden de bytes
+    uint64_t numEmpleados;
+    uint64_t numCadenas;
+    uint64_t numLenguajes;
+    int64_t siguienteId;
+    uint64_t tamanoTotal;
+    uint64_t checksum;        // de todo lo que sigue a la cabecera
+    uint64_t secciones[NUM_SECCIONES];
+};
+
+// Comprueba si un búfer empieza con la firma de una instantánea
+bool esSnapshot(std::string_view datos);
+
+// Suma de verificación FNV-1a de 64 bits, procesada por palabras de 8 bytes
+uint64_t checksum(const char* datos, std::size_t tamano);
+
+/**
+ * Clase Escritor - Acumula empleados y construye la imagen binaria
+ */
+class Escritor {
+public:
+    void reservar(std::size_t empleados);
+
+    // r.lenguajes (lista separada por comas) se añade como lenguajes del empleado
+    void agregar(const RegistroTexto& r);
+    // Añade un lenguaje más al último empleado agregado
+    void agregarLenguaje(std::string_view lenguaje);
+
+    std::size_t size() const { return ids.size(); }
+
+    std::vector<char> construirImagen(int siguienteId) const;
+
+    // Escribe en un temporal y lo renombra: el archivo anterior nunca queda a medias
+    bool guardar(const std::string& ruta, int siguienteId, std::string& error) const;
+
+private:
+    StringInterner cadenas;
+    std::vector<int32_t> ids;
+    std::vector<uint8_t> tipos;
+    std::vector<double> salariosBase;
+    std::vector<double> bonus;
+    std::vector<int32_t> equipos;
+    std::vector<uint32_t> nombres;
+    std::vector<uint32_t> apellidos;
+    std::vector<uint32_t> departamentos;
+    std::vector<uint32_t> lengInicio{0};
+    std::vector<uint32_t> lenguajes;
+    std::vector<int32_t> jefes;
+};
+
+/**
+ * Clase Lector - Acceso directo a una imagen binaria validada
+ * Las vistas devueltas apuntan a la imagen, que debe seguir viva.
+ */
+class Lector {
+public:
+    // Valida cabecera, límites de secciones, índices y checksum
+    bool abrir(std::string_view imagen, std::string& error);
+
+    std::size_t size() const { return static_cast<std::size_t>(cabecera.numEmpleados); }
+    int siguienteId() const { return static_cast<int>(cabecera.siguienteId); }
+
+    // Registro sin lenguajes (r.lenguajes vacío); usar paraCadaLenguaje
+    RegistroTexto registro(std::size_t i) const;
+
+    template <typename Funcion>
+    void paraCadaLenguaje(std::size_t i, Funcion&& f) const {
+        for (uint32_t k = lengInicio[i]; k < lengInicio[i + 1]; ++k) f(cadena(lenguajes[k]));
+    }
+
+private:
+    CabeceraSnapshot cabecera{};
+    const char* base = nullptr;
+    const int32_t* ids = nullptr;
+    const uint8_t* tipos = nullptr;
+    const double* salariosBase = nullptr;
+    const double* bonus = nullptr;
+    const int32_t* equipos = nullptr;
+    const uint32_t* nombres = nullptr;
+    const uint32_t* apellidos = nullptr;
+    const uint32_t* departamentos = nullptr;
+    const uint32_t* lengInicio = nullptr;
+    const uint32_t* lenguajes = nullptr;
+    const uint64_t* cadenasInicio = nullptr;
+    const char* cadenasDatos = nullptr;
+    const int32_t* jefes = nullptr;   // nullptr en la versión 1
+
+    std::string_view cadena(uint32_t indice) const {
+        return std::string_view(cadenasDatos + cadenasInicio[indice],
+                                cadenasInicio[indice + 1] - cadenasInicio[indice]);
+    }
+};
+
+// Conversores entre el formato de texto y el binario
+bool convertirTextoASnapshot(const std::string& rutaTexto, const std::string& rutaSnapshot, std::string& error);
+bool convertirSnapshotATexto(const std::string& rutaSnapshot, const std::string& rutaTexto, std::string& error);
+
+} // namespace snapshot
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,37 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * Clase StringInterner - Tabla de cadenas internadas
+ * Demuestra: string_view, identificadores compactos, estabilidad de referencias
+ *
+ * Cada cadena distinta se guarda una sola vez y se identifica con un
+ * símbolo de 32 bits. Los textos viven en un deque, así las vistas
+ * devueltas siguen siendo válidas aunque se internen cadenas nuevas.
+ */
+class StringInterner {
+public:
+    using Simbolo = uint32_t;
+    static constexpr Simbolo NINGUNO = UINT32_MAX;
+
+    // Devuelve el símbolo de la cadena, creándolo si no existía
+    Simbolo internar(std::string_view texto);
+
+    // Devuelve el símbolo o NINGUNO si la cadena no está internada
+    Simbolo buscar(std::string_view texto) const;
+
+    std::string_view texto(Simbolo simbolo) const { return textos[simbolo]; }
+    std::size_t size() const { return textos.size(); }
+
+private:
+    std::deque<std::string> textos;
+    std::unordered_map<std::string_view, Simbolo> simbolos;
+};
+
+#endif // STRING_INTERNER_H
@@ -0,0 +1,68 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include "Arena.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * Clase SymbolTable - Tabla global de cadenas internadas
+ * Demuestra: internado de cadenas, lecturas sin cerrojo, arenas
+ *
+ * Departamentos y lenguajes se repiten millones de veces, así que los
+ * empleados guardan un símbolo de 32 bits y la tabla guarda cada texto una
+ * sola vez; los índices por departamento y por lenguaje usan los mismos
+ * símbolos. Las cadenas no se liberan nunca: la memoria crece con los
+ * valores distintos, no con los registros. Por eso nombres y apellidos,
+ * casi todos distintos, no pasan por aquí.
+ *
+ * internar() y buscar() toman un cerrojo; texto() no, y puede llamarse
+ * desde cualquier hilo con un símbolo que ese hilo ya haya recibido.
+ */
+class SymbolTable {
+public:
+    using Simbolo = uint32_t;
+    static constexpr Simbolo NINGUNO = UINT32_MAX;
+
+    static SymbolTable& global();
+
+    SymbolTable();
+    ~SymbolTable();
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    Simbolo internar(std::string_view texto);
+
+    // Devuelve el símbolo o NINGUNO si el texto no está internado
+    Simbolo buscar(std::string_view texto) const;
+
+    std::string_view texto(Simbolo simbolo) const {
+        return bloques[simbolo >> BITS_BLOQUE].load(std::memory_order_acquire)[simbolo & MASCARA_BLOQUE];
+    }
+
+    std::size_t size() const { return cantidad.load(std::memory_order_acquire); }
+    std::size_t bytesTextos() const;
+
+private:
+    static constexpr unsigned BITS_BLOQUE = 16;
+    static constexpr uint32_t MASCARA_BLOQUE = (1u << BITS_BLOQUE) - 1;
+    static constexpr std::size_t MAX_BLOQUES = std::size_t(1) << (32 - BITS_BLOQUE);
+
+    // Directorio fijo de bloques: los ya publicados no se mueven nunca
+    std::unique_ptr<std::atomic<std::string_view*>[]> bloques;
+    std::atomic<std::size_t> cantidad{0};
+
+    mutable std::mutex mutex;
+    Arena textos;
+    std::unordered_map<std::string_view, Simbolo> simbolos;
+};
+
+// Atajos sobre la tabla global
+inline SymbolTable::Simbolo internar(std::string_view texto) { return SymbolTable::global().internar(texto); }
+inline std::string_view textoSimbolo(SymbolTable::Simbolo simbolo) { return SymbolTable::global().texto(simbolo); }
+
+#endif // SYMBOL_TABLE_H
@@ -0,0 +1,54 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Clase ThreadPool - Grupo de hilos con robo de trabajo
+ * Demuestra: std::thread, mutex, condition_variable, RAII
+ *
+ * Cada trabajador tiene su propia cola. Atiende primero la suya (por el
+ * final) y, si está vacía, roba del principio de las demás. El hilo que
+ * llama a ejecutar() también trabaja mientras espera, así un grupo de N
+ * trabajadores aporta N + 1 hilos de cómputo.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned trabajadores);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned getTrabajadores() const { return static_cast<unsigned>(hilos.size()); }
+
+    // Ejecuta tarea(0) ... tarea(numTareas - 1) y espera a que terminen todas.
+    // Si alguna lanza una excepción, se relanza aquí la primera.
+    void ejecutar(std::size_t numTareas, const std::function<void(std::size_t)>& tarea);
+
+private:
+    struct Cola {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tareas;
+    };
+
+    std::vector<std::unique_ptr<Cola>> colas;
+    std::vector<std::thread> hilos;
+    std::mutex mutexEspera;
+    std::condition_variable hayTrabajo;
+    std::atomic<std::size_t> pendientes;
+    bool terminar;
+
+    bool ejecutarUna(std::size_t colaPropia);
+    void bucleTrabajador(std::size_t indice);
+};
+
+#endif // THREAD_POOL_H
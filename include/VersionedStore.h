@@ -0,0 +1,173 @@
+#ifndef VERSIONED_STORE_H
+#define VERSIONED_STORE_H
+
+#include "Developer.h"
+#include "SymbolTable.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Clase VersionedStore - Copia versionada de los registros (MVCC)
+ * Demuestra: copia en escritura por bloques, instantáneas inmutables,
+ *            recolección por épocas
+ *
+ * Guarda los datos de cada empleado, en el mismo orden que el vector de
+ * EmployeeManager, en bloques de REGISTROS_POR_BLOQUE. fijar() publica la
+ * versión en curso copiando solo el directorio de bloques (un puntero por
+ * bloque) y devuelve una Instantanea que otro hilo puede leer sin cerrojos
+ * mientras el dueño sigue modificando: la primera escritura en un bloque
+ * compartido con una versión publicada lo copia y deja el original a la
+ * versión antigua.
+ *
+ * Los bloques y directorios sustituidos se retiran con la época (número
+ * de versión) en que dejaron de ser actuales. Cada instantánea ocupa una
+ * ranura con la época que fijó; recoger() libera lo retirado en una época
+ * menor que todas las ranuras ocupadas.
+ *
+ * Cada registro lleva su copia de nombre y apellido y comparte la lista de
+ * lenguajes del Developer (inmutable), así una versión antigua sigue
+ * siendo legible aunque el empleado ya no exista.
+ *
+ * Solo el hilo dueño llama a los métodos de escritura, a fijar() y a
+ * recoger(); las instantáneas se leen y se sueltan desde cualquier hilo.
+ */
+class VersionedStore {
+public:
+    static constexpr std::size_t REGISTROS_POR_BLOQUE = 512;
+    static constexpr std::size_t MAX_INSTANTANEAS = 64;
+
+    struct Registro {
+        int id;
+        TipoEmpleado tipo;
+        int equipo;                        // solo managers
+        int jefe;                          // 0 = sin jefe
+        double salarioBase;
+        double bonus;
+        double salarioTotal;
+        std::string nombre;
+        std::string apellido;
+        SymbolTable::Simbolo departamento;
+        std::shared_ptr<const Developer::Lenguajes> lenguajes;   // nula en managers
+    };
+
+    struct Estadisticas {
+        uint64_t version = 0;                  // última publicada
+        std::size_t instantaneasActivas = 0;
+        std::size_t bloques = 0;               // de la versión en curso
+        std::size_t bloquesCompartidos = 0;    // aún sin copiar desde la última publicación
+        uint64_t copiasEnEscritura = 0;        // acumuladas
+        std::size_t retirados = 0;             // bloques y directorios pendientes de liberar
+        std::size_t bytesActuales = 0;
+        std::size_t bytesRetenidos = 0;        // lo que solo mantienen versiones antiguas
+    };
+
+private:
+    struct Bloque {
+        Registro registros[REGISTROS_POR_BLOQUE];
+    };
+
+    struct Version {
+        uint64_t numero;
+        std::size_t cantidad;
+        int siguienteId;
+        std::vector<const Bloque*> bloques;
+    };
+
+public:
+    // Versión fijada; se suelta al destruirla (o con soltar())
+    class Instantanea {
+    public:
+        Instantanea() = default;
+        ~Instantanea() { soltar(); }
+        Instantanea(Instantanea&& otra) noexcept : version(otra.version), ranura(otra.ranura) {
+            otra.version = nullptr;
+            otra.ranura = nullptr;
+        }
+        Instantanea& operator=(Instantanea&& otra) noexcept;
+        Instantanea(const Instantanea&) = delete;
+        Instantanea& operator=(const Instantanea&) = delete;
+
+        bool valida() const { return version != nullptr; }
+        uint64_t numero() const { return version->numero; }
+        std::size_t size() const { return version->cantidad; }
+        int siguienteId() const { return version->siguienteId; }
+
+        const Registro& operator[](std::size_t i) const {
+            return version->bloques[i / REGISTROS_POR_BLOQUE]->registros[i % REGISTROS_POR_BLOQUE];
+        }
+
+        // Recorre los registros bloque a bloque, en orden
+        template <typename Funcion>
+        void paraCada(Funcion&& f) const;
+
+        void soltar();
+
+    private:
+        friend class VersionedStore;
+        Instantanea(const Version* version, std::atomic<uint64_t>* ranura) : version(version), ranura(ranura) {}
+
+        const Version* version = nullptr;
+        std::atomic<uint64_t>* ranura = nullptr;
+    };
+
+    VersionedStore();
+    ~VersionedStore();   // las instantáneas deben haberse soltado antes
+
+    VersionedStore(const VersionedStore&) = delete;
+    VersionedStore& operator=(const VersionedStore&) = delete;
+
+    // Escritura (hilo dueño); quitar() mueve el último a 'pos', como EmployeeManager
+    void agregar(const Registro& r);
+    void actualizar(std::size_t pos, const Registro& r);
+    void quitar(std::size_t pos);
+    void setSiguienteId(int id);
+
+    std::size_t size() const { return cantidad; }
+
+    // Publica la versión en curso si cambió y la fija; inválida si no
+    // quedan ranuras libres (MAX_INSTANTANEAS instantáneas vivas)
+    Instantanea fijar();
+
+    // Libera lo retirado que ya no puede ver ninguna instantánea
+    void recoger();
+    bool hayRetirados() const { return !retirados.empty(); }
+
+    Estadisticas estadisticas() const;
+
+private:
+    struct Retirado {
+        uint64_t epoca;
+        const Bloque* bloque;     // uno de los dos
+        const Version* version;
+    };
+
+    std::vector<Bloque*> bloques;       // versión en curso
+    std::vector<bool> compartido;       // el bloque aparece en una versión publicada
+    std::size_t cantidad = 0;
+    int siguienteId = 1;
+
+    const Version* ultima = nullptr;    // última publicada, si no hubo cambios desde entonces
+    uint64_t epoca = 0;                 // número de la última publicada
+    uint64_t copias = 0;
+    std::vector<Retirado> retirados;
+    std::unique_ptr<std::atomic<uint64_t>[]> ranuras;   // 0 = libre, si no la época fijada
+
+    void cambiar();
+    Registro& escribible(std::size_t pos);
+};
+
+template <typename Funcion>
+void VersionedStore::Instantanea::paraCada(Funcion&& f) const {
+    std::size_t restantes = version->cantidad;
+    for (const Bloque* bloque : version->bloques) {
+        const std::size_t n = restantes < REGISTROS_POR_BLOQUE ? restantes : REGISTROS_POR_BLOQUE;
+        for (std::size_t i = 0; i < n; ++i) f(bloque->registros[i]);
+        restantes -= n;
+    }
+}
+
+#endif // VERSIONED_STORE_H
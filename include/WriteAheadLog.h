@@ -0,0 +1,116 @@
+#ifndef WRITE_AHEAD_LOG_H
+#define WRITE_AHEAD_LOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+/**
+ * Clase WriteAheadLog - Diario de cambios de solo anexado
+ * Demuestra: registro previo a escritura, fsync por lotes (group commit),
+ *            CRC32, hilos en segundo plano
+ *
+ * Cada cambio se anexa como un registro pequeño:
+ *   uint32 longitud | uint32 crc32(tipo + datos) | uint8 tipo | datos
+ * Los registros se acumulan en memoria y un hilo los escribe y sincroniza
+ * con el disco cada 'intervalo', de modo que muchas operaciones comparten
+ * un solo fsync. sincronizar() espera a que todo lo anexado sea durable.
+ * Si una escritura o un fsync fallan (disco lleno, EIO) el error se queda:
+ * el diario deja de anotar y sincronizar() devuelve false con el motivo
+ * hasta que rotar() empiece un segmento nuevo.
+ *
+ * Todas las operaciones son absolutas (poner el registro completo, borrar
+ * un ID, fijar un salario, un jefe o un departamento, añadir un lenguaje
+ * que aún no tenga), así que reaplicar el diario sobre un estado que ya lo
+ * contiene deja el mismo resultado. Una actualización masiva (p. ej.
+ * un aumento porcentual) se anota por eso con los valores ya calculados:
+ * un solo registro con el campo y los pares (ID, valor nuevo).
+ */
+enum class OperacionDiario : uint8_t {
+    Poner = 1, Borrar = 2, Salario = 3, Masiva = 4, Jefe = 5, Departamento = 6, Lenguaje = 7
+};
+
+// Campo que fija una entrada Masiva; Bonus es el de proyectos o el de gestión según el tipo
+enum class CampoMasivo : uint8_t { SalarioBase = 0, Bonus = 1 };
+
+struct EntradaDiario {
+    OperacionDiario operacion;
+    int id;                  // Borrar, Salario, Jefe, Departamento, Lenguaje
+    double salario;          // Salario
+    int jefe;                // Jefe: 0 = sin jefe
+    std::string_view linea;  // Poner: registro en formato de texto
+    CampoMasivo campo = CampoMasivo::SalarioBase;   // Masiva
+    std::string_view valores;                       // Masiva: pares sin alinear, ver leerValor()
+    std::string_view texto;                         // Departamento, Lenguaje: el nombre
+
+    std::size_t cantidadValores() const { return valores.size() / TAMANO_VALOR; }
+    void leerValor(std::size_t i, int& idValor, double& valor) const;
+
+    static constexpr std::size_t TAMANO_VALOR = 4 + 8;   // int32 id | double valor
+};
+
+class WriteAheadLog {
+public:
+    explicit WriteAheadLog(const std::string& ruta,
+                           std::chrono::milliseconds intervalo = std::chrono::milliseconds(20));
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    bool abierto() const { return archivo != nullptr; }
+    const std::string& getRuta() const { return ruta; }
+
+    void anotarPoner(std::string_view linea);
+    void anotarBorrado(int id);
+    void anotarSalario(int id, double salario);
+    void anotarJefe(int id, int jefe);
+    void anotarDepartamento(int id, std::string_view departamento);
+    void anotarLenguaje(int id, std::string_view lenguaje);
+    // Un solo registro para 'cantidad' cambios del mismo campo
+    void anotarMasiva(CampoMasivo campo, const int* ids, const double* valores, std::size_t cantidad);
+
+    // Bloquea hasta que todo lo anotado esté en disco; false si no se pudo
+    bool sincronizar(std::string& error);
+
+    // Bytes del segmento actual, incluidos los aún no escritos
+    std::uint64_t bytes() const;
+
+    // Sincroniza, renombra el segmento actual a 'destino' y empieza uno vacío.
+    // También tras un error de escritura: el segmento nuevo lo deja atrás
+    bool rotar(const std::string& destino, std::string& error);
+
+    // Recorre los registros válidos de 'datos'. Devuelve los bytes consumidos;
+    // si es menor que datos.size(), el resto es una cola rota o corrupta.
+    static std::size_t reproducir(std::string_view datos,
+                                  const std::function<void(const EntradaDiario&)>& aplicar);
+
+private:
+    std::string ruta;
+    std::chrono::milliseconds intervalo;
+    std::FILE* archivo = nullptr;
+
+    mutable std::mutex mutex;
+    std::condition_variable hayDatos;
+    std::condition_variable escrito;
+    std::string pendiente;          // registros anotados y aún no escritos
+    std::uint64_t anotados = 0;     // bytes anotados en el segmento actual
+    std::uint64_t durables = 0;     // bytes ya sincronizados del segmento actual
+    bool escribiendo = false;
+    std::string errorEscritura;     // primer fallo; vacío si no lo hubo
+    bool terminar = false;
+    std::thread escritor;
+
+    void anotar(OperacionDiario operacion, const char* datos, std::size_t tamano);
+    void anotarTexto(OperacionDiario operacion, int id, std::string_view texto);   // int32 id | texto
+    void bucleEscritor();
+    void volcar(std::unique_lock<std::mutex>& lock);
+};
+
+#endif // WRITE_AHEAD_LOG_H
@@ -0,0 +1,68 @@
+#include "Arena.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+void* Arena::reservar(std::size_t tamano, std::size_t alineacion) {
+    std::size_t relleno = (alineacion - reinterpret_cast<std::uintptr_t>(actual) % alineacion) % alineacion;
+    if (!actual || relleno + tamano > libres) {
+        // Lo que no cabe en un bloque normal recibe un bloque propio
+        std::size_t tamanoBloque = std::max(BLOQUE, tamano + alineacion);
+        bloques.push_back(std::make_unique<char[]>(tamanoBloque));
+        actual = bloques.back().get();
+        libres = tamanoBloque;
+        reservados += tamanoBloque;
+        relleno = (alineacion - reinterpret_cast<std::uintptr_t>(actual) % alineacion) % alineacion;
+    }
+
+    void* p = actual + relleno;
+    actual += relleno + tamano;
+    libres -= relleno + tamano;
+    return p;
+}
+
+std::string_view Arena::copiar(std::string_view texto) {
+    if (texto.empty()) return std::string_view();
+    char* destino = static_cast<char*>(reservar(texto.size(), 1));
+    std::memcpy(destino, texto.data(), texto.size());
+    return std::string_view(destino, texto.size());
+}
+
+PoolObjetos::PoolObjetos(std::size_t tamanoObjeto)
+    : tamanoObjeto(std::max(tamanoObjeto, sizeof(Libre))) {}
+
+void* PoolObjetos::reservar() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (libres) {
+        Libre* p = libres;
+        libres = p->siguiente;
+        return p;
+    }
+    // Alineación natural de la casilla: la mayor potencia de 2 que divide su tamaño
+    std::size_t alineacion = std::min<std::size_t>(tamanoObjeto & (~tamanoObjeto + 1), alignof(std::max_align_t));
+    return arena.reservar(tamanoObjeto, alineacion);
+}
+
+void PoolObjetos::liberar(void* p) {
+    if (!p) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    Libre* nodo = static_cast<Libre*>(p);
+    nodo->siguiente = libres;
+    libres = nodo;
+}
+
+PoolObjetos* PoolObjetos::paraTamano(std::size_t tamano) {
+    // Clases de tamaño de 8 en 8 bytes hasta 256
+    constexpr std::size_t PASO = 8;
+    constexpr std::size_t CLASES = 32;
+    if (tamano == 0 || tamano > PASO * CLASES) return nullptr;
+
+    // No se destruyen nunca: un objeto estático podría liberarse después que ellos
+    static std::array<PoolObjetos*, CLASES> pools = [] {
+        std::array<PoolObjetos*, CLASES> p;
+        for (std::size_t i = 0; i < CLASES; ++i) p[i] = new PoolObjetos((i + 1) * PASO);
+        return p;
+    }();
+    return pools[(tamano - 1) / PASO];
+}
@@ -0,0 +1,156 @@
+#include "BackgroundSaver.h"
+#include "EmployeeParser.h"
+#include "Metrics.h"
+#include "Snapshot.h"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Las vistas valen mientras vivan 'r' (fijado en la versión) y 'lenguajes'
+RegistroTexto registroTexto(const VersionedStore::Registro& r, std::string& lenguajes) {
+    lenguajes.clear();
+    if (r.lenguajes) unirLenguajes(*r.lenguajes, lenguajes);
+    return {r.tipo, r.id, r.nombre, r.apellido, r.salarioBase,
+            textoSimbolo(r.departamento), r.bonus, r.equipo, r.jefe, lenguajes, 0};
+}
+
+} // namespace
+
+BackgroundSaver::BackgroundSaver(std::string ruta, Formato formato)
+    : ruta(std::move(ruta)), formato(formato) {
+    hilo = std::thread([this]() { bucle(); });
+}
+
+BackgroundSaver::~BackgroundSaver() {
+    {
+        std::lock_guard<std::mutex> cerrojo(mutex);
+        detener = true;
+    }
+    hayTrabajo.notify_one();
+    hilo.join();
+}
+
+uint64_t BackgroundSaver::solicitar(VersionedStore::Instantanea version) {
+    uint64_t numero;
+    {
+        std::lock_guard<std::mutex> cerrojo(mutex);
+        // La que esperaba queda sustituida (y soltada al moverle encima)
+        pendiente = std::move(version);
+        numero = ++solicitados;
+    }
+    hayTrabajo.notify_one();
+    return numero;
+}
+
+bool BackgroundSaver::esperar(uint64_t numero, std::string& error) {
+    std::unique_lock<std::mutex> cerrojo(mutex);
+    terminado.wait(cerrojo, [&]() { return completados >= numero; });
+    if (!ultimoOk) error = ultimoError;
+    return ultimoOk;
+}
+
+bool BackgroundSaver::esperarTodo(std::string& error) {
+    uint64_t numero;
+    {
+        std::lock_guard<std::mutex> cerrojo(mutex);
+        numero = solicitados;
+    }
+    return esperar(numero, error);
+}
+
+uint64_t BackgroundSaver::getSolicitados() const {
+    std::lock_guard<std::mutex> cerrojo(mutex);
+    return solicitados;
+}
+
+uint64_t BackgroundSaver::getEscritos() const {
+    std::lock_guard<std::mutex> cerrojo(mutex);
+    return escritos;
+}
+
+void BackgroundSaver::bucle() {
+    buffer.reserve(TAMANO_BUFFER + 4096);
+    std::unique_lock<std::mutex> cerrojo(mutex);
+    while (true) {
+        hayTrabajo.wait(cerrojo, [&]() { return pendiente.valida() || detener; });
+        if (!pendiente.valida()) return;   // detener sin nada pendiente
+
+        VersionedStore::Instantanea enCurso = std::move(pendiente);
+        const uint64_t numero = solicitados;
+        cerrojo.unlock();
+
+        std::string error;
+        bool ok = escribir(enCurso, error);
+        if (!ok) std::cerr << "❌ Error al guardar en segundo plano: " << error << "\n";
+        enCurso.soltar();
+
+        cerrojo.lock();
+        completados = numero;
+        ultimoOk = ok;
+        ultimoError = std::move(error);
+        if (ok) ++escritos;
+        terminado.notify_all();
+    }
+}
+
+bool BackgroundSaver::escribir(const VersionedStore::Instantanea& version, std::string& error) {
+    metricas::Temporizador temporizador(metricas::Operacion::Guardado);
+    if (formato == Formato::Texto) return escribirTexto(version, error);
+
+    snapshot::Escritor escritor;
+    escritor.reservar(version.size());
+    std::string lenguajes;
+    version.paraCada([&](const VersionedStore::Registro& r) { escritor.agregar(registroTexto(r, lenguajes)); });
+    return escritor.guardar(ruta, version.siguienteId(), error);
+}
+
+bool BackgroundSaver::escribirTexto(const VersionedStore::Instantanea& version, std::string& error) {
+    const std::string temporal = ruta + ".tmp";
+    std::FILE* archivo = std::fopen(temporal.c_str(), "wb");
+    if (!archivo) {
+        error = "no se pudo crear " + temporal;
+        return false;
+    }
+
+    bool escrito = true;
+    buffer.clear();
+    std::string lenguajes;
+    version.paraCada([&](const VersionedStore::Registro& r) {
+        formatearRegistro(registroTexto(r, lenguajes), buffer);
+        buffer += '\n';
+        if (buffer.size() >= TAMANO_BUFFER) {
+            escrito = escrito && std::fwrite(buffer.data(), 1, buffer.size(), archivo) == buffer.size();
+            buffer.clear();
+        }
+    });
+    escrito = escrito && std::fwrite(buffer.data(), 1, buffer.size(), archivo) == buffer.size() &&
+              std::fflush(archivo) == 0;
+    buffer.clear();
+    // Como en snapshot::Escritor::guardar: los datos en disco antes del renombrado
+#ifdef _WIN32
+    escrito = escrito && _commit(_fileno(archivo)) == 0;
+#else
+    escrito = escrito && ::fsync(::fileno(archivo)) == 0;
+#endif
+    std::fclose(archivo);
+    if (!escrito) {
+        error = "error de escritura en " + temporal;
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporal, ruta, ec);
+    if (ec) {
+        error = "no se pudo renombrar " + temporal + ": " + ec.message();
+        return false;
+    }
+    return true;
+}
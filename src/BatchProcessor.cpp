@@ -0,0 +1,497 @@
+#include "BatchProcessor.h"
+#include <chrono>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+namespace {
+
+constexpr std::size_t TAMANO_BLOQUE = 1 << 20;
+constexpr std::size_t SALIDA_MAXIMA = 1 << 16;   // se vuelca al superar 64 KiB
+constexpr std::size_t MAX_CAMPOS = 9;
+constexpr std::size_t MAX_ERRORES_GUARDADOS = 10;
+
+std::size_t separarCampos(std::string_view linea, std::string_view* campos) {
+    std::size_t n = 0;
+    while (true) {
+        std::size_t barra = linea.find('|');
+        if (n < MAX_CAMPOS) campos[n] = linea.substr(0, barra);
+        ++n;
+        if (barra == std::string_view::npos) return n;
+        linea.remove_prefix(barra + 1);
+    }
+}
+
+template <typename T>
+bool leerNumero(std::string_view campo, T& valor) {
+    const char* fin = campo.data() + campo.size();
+    auto [ptr, ec] = std::from_chars(campo.data(), fin, valor);
+    if (ec != std::errc() || ptr != fin) return false;
+    // from_chars acepta "nan" e "inf", que no son importes válidos
+    if constexpr (std::is_floating_point_v<T>) return std::isfinite(valor);
+    return true;
+}
+
+template <typename T>
+void anadirNumero(std::string& destino, T valor) {
+    char buffer[32];
+    auto [fin, ec] = std::to_chars(buffer, buffer + sizeof(buffer), valor);
+    destino.append(buffer, ec == std::errc() ? fin : buffer);
+}
+
+// Informe de cierre sobre una versión fijada: lo que vea el archivo es un
+// único estado, aunque el lote siga modificando mientras se escribe
+bool escribirCierre(const VersionedStore::Instantanea& version, const std::string& ruta, std::string& error) {
+    std::string texto = "# Cierre de nómina, versión ";
+    anadirNumero(texto, version.numero());
+    texto += '\n';
+    for (const auto& [nombre, e] : EmployeeManager::estadisticasPorDepartamento(version)) {
+        texto += "DEPARTAMENTO|";
+        texto += nombre;
+        texto += '|';
+        anadirNumero(texto, e.cantidad);
+        for (double valor : {e.suma, e.media, e.minimo, e.maximo}) {
+            texto += '|';
+            anadirNumero(texto, valor);
+        }
+        texto += '\n';
+    }
+    texto += "NOMINA|";
+    anadirNumero(texto, EmployeeManager::nominaDe(version));
+    texto += '|';
+    anadirNumero(texto, version.size());
+    texto += '\n';
+
+    std::FILE* archivo = std::fopen(ruta.c_str(), "wb");
+    if (!archivo) {
+        error = "no se pudo crear " + ruta;
+        return false;
+    }
+    bool escrito = std::fwrite(texto.data(), 1, texto.size(), archivo) == texto.size();
+    escrito = std::fclose(archivo) == 0 && escrito;
+    if (!escrito) error = "error de escritura en " + ruta;
+    return escrito;
+}
+
+} // namespace
+
+BatchProcessor::BatchProcessor(EmployeeManager& manager, std::FILE* salida)
+    : manager(manager), salida(salida) {
+    bufferSalida.reserve(SALIDA_MAXIMA + 4096);
+}
+
+BatchProcessor::~BatchProcessor() {
+    esperarCierres();
+    vaciarSalida();
+}
+
+void BatchProcessor::esperarCierres() {
+    for (std::thread& hilo : cierres) hilo.join();
+    cierres.clear();
+}
+
+bool BatchProcessor::ejecutar(std::FILE* entrada) {
+    const auto inicio = std::chrono::steady_clock::now();
+
+    // Se procesa hasta el último '\n' del bloque; el resto pasa al siguiente
+    std::vector<char> bloque(TAMANO_BLOQUE);
+    std::size_t arrastre = 0;
+    while (true) {
+        if (arrastre == bloque.size()) bloque.resize(bloque.size() * 2);   // línea enorme
+        std::size_t leidos = std::fread(bloque.data() + arrastre, 1, bloque.size() - arrastre, entrada);
+        std::size_t total = arrastre + leidos;
+        if (leidos == 0) {
+            procesarBloque(std::string_view(bloque.data(), total));
+            break;
+        }
+
+        std::string_view datos(bloque.data(), total);
+        std::size_t ultimo = datos.rfind('\n');
+        if (ultimo == std::string_view::npos) {
+            arrastre = total;
+            continue;
+        }
+        procesarBloque(datos.substr(0, ultimo + 1));
+        vaciarAltas();   // las altas pendientes apuntan a este bloque
+
+        arrastre = total - (ultimo + 1);
+        std::memmove(bloque.data(), bloque.data() + ultimo + 1, arrastre);
+    }
+    vaciarAltas();
+    vaciarSalida();
+    esperarCierres();
+
+    resumen.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return !std::ferror(entrada);
+}
+
+void BatchProcessor::procesarBloque(std::string_view bloque) {
+    while (!bloque.empty()) {
+        std::size_t salto = bloque.find('\n');
+        std::string_view linea = bloque.substr(0, salto);
+        bloque.remove_prefix(salto == std::string_view::npos ? bloque.size() : salto + 1);
+        ++lineaActual;
+
+        if (!linea.empty() && linea.back() == '\r') linea.remove_suffix(1);
+        if (linea.empty() || linea.front() == '#') continue;
+        procesarLinea(linea);
+    }
+}
+
+void BatchProcessor::procesarLinea(std::string_view linea) {
+    std::string_view campos[MAX_CAMPOS];
+    std::size_t n = separarCampos(linea, campos);
+    const std::string_view comando = campos[0];
+
+    if (comando == "ALTA") {
+        DescriptorEmpleado d;
+        std::string motivo;
+        if (n < 2 || !analizarAlta(linea.substr(comando.size() + 1), d, motivo)) {
+            anotarError(n < 2 ? "ALTA sin datos" : std::move(motivo));
+            return;
+        }
+        // El jefe puede ser una de las altas aún pendientes
+        if (d.jefe != 0 && !esManager(d.jefe)) {
+            vaciarAltas();
+            if (!esManager(d.jefe)) {
+                anotarError("ALTA: el jefe " + std::to_string(d.jefe) + " no existe o no es manager");
+                return;
+            }
+        }
+        altasPendientes.push_back(d);
+        ++resumen.operaciones;
+        return;
+    }
+
+    // Las altas acumuladas van antes, para respetar el orden del flujo
+    vaciarAltas();
+
+    int id = 0;
+    if (comando == "SALARIO") {
+        double salario = 0;
+        if (n != 3 || !leerNumero(campos[1], id) || !leerNumero(campos[2], salario) || salario < 0) {
+            anotarError("SALARIO espera id|salario");
+            return;
+        }
+        ++resumen.cambiosSalario;
+        if (!manager.salarioSinAviso(id, salario)) ++resumen.noEncontrados;
+    } else if (comando == "MASIVO") {
+        // MASIVO|BASE|%|4|DEV|Ingeniería  o  MASIVO|BONUS|=|2000|MGR||11
+        SeleccionEmpleados seleccion;
+        CambioMasivo cambio;
+        bool valido = n >= 4 && n <= 7 && (campos[1] == "BASE" || campos[1] == "BONUS") &&
+                      (campos[2] == "%" || campos[2] == "+" || campos[2] == "=") &&
+                      leerNumero(campos[3], cambio.valor);
+        if (valido && n >= 5 && campos[4] != "*") {
+            valido = campos[4] == "DEV" || campos[4] == "MGR";
+            seleccion.porTipo = true;
+            seleccion.tipo = campos[4] == "DEV" ? TipoEmpleado::Developer : TipoEmpleado::Manager;
+        }
+        if (n >= 6) seleccion.departamento = campos[5];
+        if (valido && n == 7) valido = leerNumero(campos[6], seleccion.equipoMinimo);
+        if (!valido) {
+            anotarError("MASIVO espera BASE|BONUS|%|+|=|valor[|DEV|MGR|*[|departamento[|equipoMinimo]]]");
+            return;
+        }
+        cambio.campo = campos[1] == "BASE" ? CampoMasivo::SalarioBase : CampoMasivo::Bonus;
+        cambio.modo = campos[2] == "%" ? ModoCambio::Porcentaje
+                    : campos[2] == "+" ? ModoCambio::Sumar : ModoCambio::Fijar;
+        bufferSalida += "MASIVO|";
+        anadirNumero(bufferSalida, manager.actualizarMasivo(seleccion, cambio));
+        bufferSalida += '\n';
+    } else if (comando == "BAJA") {
+        if (n != 2 || !leerNumero(campos[1], id)) {
+            anotarError("BAJA espera id");
+            return;
+        }
+        ++resumen.bajas;
+        if (!manager.bajaSinAviso(id)) ++resumen.noEncontrados;
+    } else if (comando == "JEFE") {
+        int jefe = 0;
+        std::string motivo;
+        if (n != 3 || !leerNumero(campos[1], id) || !leerNumero(campos[2], jefe)) {
+            anotarError("JEFE espera id|jefe");
+            return;
+        }
+        if (!manager.cambiarJefe(id, jefe, motivo)) {
+            anotarError("JEFE: " + motivo);
+            return;
+        }
+    } else if (comando == "TRASLADO") {
+        std::string motivo;
+        if (n != 3 || !leerNumero(campos[1], id)) {
+            anotarError("TRASLADO espera id|departamento");
+            return;
+        }
+        if (!manager.cambiarDepartamento(id, campos[2], motivo)) {
+            anotarError("TRASLADO: " + motivo);
+            return;
+        }
+    } else if (comando == "NUEVO_LENGUAJE") {
+        std::string motivo;
+        if (n != 3 || !leerNumero(campos[1], id)) {
+            anotarError("NUEVO_LENGUAJE espera id|lenguaje");
+            return;
+        }
+        if (!manager.agregarLenguaje(id, campos[2], motivo)) {
+            anotarError("NUEVO_LENGUAJE: " + motivo);
+            return;
+        }
+    } else if (comando == "RAMA") {
+        if (n != 2 || !leerNumero(campos[1], id)) {
+            anotarError("RAMA espera id");
+            return;
+        }
+        ++resumen.consultas;
+        if (manager.getEmpleado(id)) {
+            const ReportingTree::Rama rama = manager.rama(id);
+            bufferSalida += "RAMA|";
+            anadirNumero(bufferSalida, id);
+            bufferSalida += '|';
+            anadirNumero(bufferSalida, rama.personas);
+            bufferSalida += '|';
+            anadirNumero(bufferSalida, rama.nomina);
+        } else {
+            ++resumen.noEncontrados;
+            bufferSalida += "NO_ENCONTRADO|";
+            anadirNumero(bufferSalida, id);
+        }
+        bufferSalida += '\n';
+    } else if (comando == "BUSCAR") {
+        if (n != 2 || !leerNumero(campos[1], id)) {
+            anotarError("BUSCAR espera id");
+            return;
+        }
+        ++resumen.consultas;
+        if (const Employee* emp = manager.getEmpleado(id)) {
+            bufferSalida += emp->serializar();
+        } else {
+            ++resumen.noEncontrados;
+            bufferSalida += "NO_ENCONTRADO|";
+            anadirNumero(bufferSalida, id);
+        }
+        bufferSalida += '\n';
+    } else if (comando == "NOMINA" && n == 1) {
+        ++resumen.informes;
+        bufferSalida += "NOMINA|";
+        anadirNumero(bufferSalida, manager.calcularNominaTotal());
+        bufferSalida += '|';
+        anadirNumero(bufferSalida, manager.getCantidadEmpleados());
+        bufferSalida += '\n';
+    } else if (comando == "DEPARTAMENTOS" && n == 1) {
+        ++resumen.informes;
+        for (const auto& [nombre, e] : manager.estadisticasPorDepartamento()) {
+            bufferSalida += "DEPARTAMENTO|";
+            bufferSalida += nombre;
+            bufferSalida += '|';
+            anadirNumero(bufferSalida, e.cantidad);
+            for (double valor : {e.suma, e.media, e.minimo, e.maximo}) {
+                bufferSalida += '|';
+                anadirNumero(bufferSalida, valor);
+            }
+            bufferSalida += '\n';
+        }
+    } else if (comando == "TOP") {
+        std::size_t k = 0;
+        if ((n != 2 && n != 3) || !leerNumero(campos[1], k)) {
+            anotarError("TOP espera k[|departamento]");
+            return;
+        }
+        ++resumen.consultas;
+        for (const Employee* emp : manager.topK(k, CampoOrden::SalarioTotal, n == 3 ? campos[2] : "")) {
+            bufferSalida += emp->serializar();
+            bufferSalida += '\n';
+            if (bufferSalida.size() >= SALIDA_MAXIMA) vaciarSalida();
+        }
+    } else if (comando == "RANGO") {
+        CampoOrden campo = CampoOrden::SalarioTotal;
+        double desde = 0;
+        double hasta = 0;
+        bool campoValido = n >= 2 && (campos[1] == "ID" || campos[1] == "SALARIO" || campos[1] == "BASE");
+        if (campoValido) {
+            campo = campos[1] == "ID" ? CampoOrden::Id
+                  : campos[1] == "BASE" ? CampoOrden::SalarioBase : CampoOrden::SalarioTotal;
+        }
+        if (!campoValido || (n != 4 && n != 5) || !leerNumero(campos[2], desde) || !leerNumero(campos[3], hasta)) {
+            anotarError("RANGO espera ID|SALARIO|BASE|desde|hasta[|departamento]");
+            return;
+        }
+        ++resumen.consultas;
+        for (const Employee& emp : manager.rango(campo, desde, hasta, n == 5 ? campos[4] : "")) {
+            bufferSalida += emp.serializar();
+            bufferSalida += '\n';
+            if (bufferSalida.size() >= SALIDA_MAXIMA) vaciarSalida();
+        }
+    } else if (comando == "LENGUAJES") {
+        RoaringBitmap ids;
+        std::string motivo;
+        if (n < 2 || !manager.buscarPorLenguajes(linea.substr(comando.size() + 1), ids, motivo)) {
+            anotarError(n < 2 ? "LENGUAJES espera una expresión" : "LENGUAJES: " + motivo);
+            return;
+        }
+        ++resumen.consultas;
+        ids.paraCada([&](uint32_t valor) {
+            if (const Employee* emp = manager.getEmpleado(static_cast<int>(valor))) {
+                bufferSalida += emp->serializar();
+                bufferSalida += '\n';
+                if (bufferSalida.size() >= SALIDA_MAXIMA) vaciarSalida();
+            }
+        });
+    } else if (comando == "CONTEO_LENGUAJES" && (n == 1 || n == 2)) {
+        ++resumen.informes;
+        for (const auto& [nombre, cantidad] : manager.conteoLenguajes(n == 2 ? campos[1] : "")) {
+            bufferSalida += "LENGUAJE|";
+            bufferSalida += nombre;
+            bufferSalida += '|';
+            anadirNumero(bufferSalida, cantidad);
+            bufferSalida += '\n';
+        }
+    } else if (comando == "PREFIJO" || comando == "NOMBRE") {
+        std::size_t k = 10;
+        if ((n != 2 && n != 3) || campos[1].empty() || (n == 3 && !leerNumero(campos[2], k))) {
+            anotarError(std::string(comando) + " espera texto[|k]");
+            return;
+        }
+        ++resumen.consultas;
+        if (comando == "PREFIJO") {
+            for (const Employee* emp : manager.buscarPorPrefijo(campos[1], k)) {
+                bufferSalida += emp->serializar();
+                bufferSalida += '\n';
+                if (bufferSalida.size() >= SALIDA_MAXIMA) vaciarSalida();
+            }
+        } else {
+            for (const auto& [emp, puntuacion] : manager.buscarPorNombre(campos[1], k)) {
+                bufferSalida += "COINCIDENCIA|";
+                anadirNumero(bufferSalida, puntuacion);
+                bufferSalida += '|';
+                bufferSalida += emp->serializar();
+                bufferSalida += '\n';
+                if (bufferSalida.size() >= SALIDA_MAXIMA) vaciarSalida();
+            }
+        }
+    } else if (comando == "LISTAR") {
+        FormatoInforme formato = FormatoInforme::Tabla;
+        std::size_t cantidad = static_cast<std::size_t>(-1);
+        if ((n != 2 && n != 4) || !formatoInformePorNombre(campos[1], formato) ||
+            (n == 4 && (!leerNumero(campos[2], id) || !leerNumero(campos[3], cantidad)))) {
+            anotarError("LISTAR espera tabla|csv|jsonl[|desdeId|cantidad]");
+            return;
+        }
+        ++resumen.informes;
+        vaciarSalida();   // el informe escribe en 'salida' con su propio búfer
+        ReportWriter informe(salida, formato);
+        informe.empezar();
+        manager.escribirInforme(informe, id, cantidad);
+        informe.terminar();
+    } else if (comando == "GUARDAR" && n == 1) {
+        manager.guardarEnSegundoPlano();   // el lote sigue; al terminar se espera
+    } else if (comando == "CIERRE" && n == 2 && !campos[1].empty()) {
+        VersionedStore::Instantanea version = manager.fijarVersion();
+        if (!version.valida()) {
+            anotarError("CIERRE: demasiadas versiones fijadas");
+            return;
+        }
+        ++resumen.informes;
+        bufferSalida += "CIERRE|";
+        anadirNumero(bufferSalida, version.numero());
+        bufferSalida += '|';
+        anadirNumero(bufferSalida, version.size());
+        bufferSalida += '|';
+        bufferSalida += campos[1];
+        bufferSalida += '\n';
+        cierres.emplace_back([version = std::move(version), ruta = std::string(campos[1])]() {
+            std::string error;
+            if (!escribirCierre(version, ruta, error)) std::cerr << "❌ Error en el cierre: " << error << "\n";
+        });
+    } else if (comando == "VERSIONES" && n == 1) {
+        ++resumen.informes;
+        const VersionedStore::Estadisticas e = manager.getEstadisticasVersiones();
+        bufferSalida += "VERSIONES";
+        for (uint64_t valor : {e.version, uint64_t(e.instantaneasActivas), uint64_t(e.bloques),
+                               uint64_t(e.bloquesCompartidos), e.copiasEnEscritura, uint64_t(e.retirados),
+                               uint64_t(e.bytesActuales), uint64_t(e.bytesRetenidos)}) {
+            bufferSalida += '|';
+            anadirNumero(bufferSalida, valor);
+        }
+        bufferSalida += '\n';
+    } else {
+        anotarError("comando desconocido '" + std::string(linea.substr(0, 40)) + "'");
+        return;
+    }
+
+    ++resumen.operaciones;
+    if (bufferSalida.size() >= SALIDA_MAXIMA) vaciarSalida();
+}
+
+bool BatchProcessor::analizarAlta(std::string_view texto, DescriptorEmpleado& d, std::string& motivo) {
+    std::string_view campos[MAX_CAMPOS];
+    std::size_t n = separarCampos(texto, campos);
+    d = DescriptorEmpleado{};
+    if (n != 7 && n != 8) {
+        motivo = "ALTA espera 7 u 8 campos tras el comando y tiene " + std::to_string(n);
+        return false;
+    }
+    if (n == 8 && (!leerNumero(campos[7], d.jefe) || d.jefe < 0)) {
+        motivo = "jefe inválido '" + std::string(campos[7]) + "'";
+        return false;
+    }
+    if (campos[0] == "DEV") {
+        d.tipo = TipoEmpleado::Developer;
+        d.lenguajes = campos[6];
+        if (!leerNumero(campos[5], d.bonus)) {
+            motivo = "bonus inválido '" + std::string(campos[5]) + "'";
+            return false;
+        }
+    } else if (campos[0] == "MGR") {
+        d.tipo = TipoEmpleado::Manager;
+        int equipo = 0;   // se acepta por compatibilidad; se deriva de la jerarquía
+        if (!leerNumero(campos[5], equipo) || equipo < 0) {
+            motivo = "equipo inválido '" + std::string(campos[5]) + "'";
+            return false;
+        }
+        if (!leerNumero(campos[6], d.bonus)) {
+            motivo = "bonus inválido '" + std::string(campos[6]) + "'";
+            return false;
+        }
+    } else {
+        motivo = "tipo desconocido '" + std::string(campos[0]) + "'";
+        return false;
+    }
+
+    if (!leerNumero(campos[3], d.salarioBase) || d.salarioBase < 0) {
+        motivo = "salario inválido '" + std::string(campos[3]) + "'";
+        return false;
+    }
+    d.nombre = campos[1];
+    d.apellido = campos[2];
+    d.departamento = campos[4];
+    return true;
+}
+
+bool BatchProcessor::esManager(int id) const {
+    const Employee* emp = manager.getEmpleado(id);
+    return emp && emp->getComponentesSalario().tipo == TipoEmpleado::Manager;
+}
+
+void BatchProcessor::vaciarAltas() {
+    if (altasPendientes.empty()) return;
+    manager.agregarLote(altasPendientes);
+    resumen.altas += altasPendientes.size();
+    altasPendientes.clear();
+}
+
+void BatchProcessor::vaciarSalida() {
+    if (bufferSalida.empty()) return;
+    std::fwrite(bufferSalida.data(), 1, bufferSalida.size(), salida);
+    std::fflush(salida);
+    bufferSalida.clear();
+}
+
+void BatchProcessor::anotarError(std::string motivo) {
+    ++resumen.errores;
+    if (errores.size() < MAX_ERRORES_GUARDADOS) {
+        errores.push_back({lineaActual, std::move(motivo)});
+    }
+}
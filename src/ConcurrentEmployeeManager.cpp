@@ -0,0 +1,175 @@
+#include "ConcurrentEmployeeManager.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+namespace {
+
+// Sin jefe: la jerarquía no cruza fragmentos (ver ConcurrentEmployeeManager.h)
+DescriptorEmpleado descriptorDe(const RegistroTexto& r) {
+    return {r.tipo, r.nombre, r.apellido, r.salarioBase, r.departamento, r.bonus, 0, r.lenguajes};
+}
+
+// Une las estadísticas de dos particiones disjuntas (Chan et al.)
+void combinar(kernels::EstadisticasSalario& a, const kernels::EstadisticasSalario& b) {
+    if (b.cantidad == 0) return;
+    if (a.cantidad == 0) {
+        a = b;
+        return;
+    }
+    const double na = static_cast<double>(a.cantidad);
+    const double nb = static_cast<double>(b.cantidad);
+    const double n = na + nb;
+    const double delta = b.media - a.media;
+    const double m2 = a.varianza * na + b.varianza * nb + delta * delta * na * nb / n;
+
+    a.cantidad += b.cantidad;
+    a.suma += b.suma;
+    a.minimo = std::min(a.minimo, b.minimo);
+    a.maximo = std::max(a.maximo, b.maximo);
+    a.media = a.suma / n;
+    a.varianza = m2 / n;
+}
+
+} // namespace
+
+ConcurrentEmployeeManager::ConcurrentEmployeeManager(unsigned fragmentos) : bitsFragmento(0) {
+    while ((1u << bitsFragmento) < fragmentos && bitsFragmento < 16) ++bitsFragmento;
+    for (unsigned i = 0; i < (1u << bitsFragmento); ++i) {
+        this->fragmentos.push_back(std::make_unique<Fragmento>());
+    }
+}
+
+ConcurrentEmployeeManager::Fragmento& ConcurrentEmployeeManager::fragmentoDe(int id) const {
+    // Hash de Fibonacci: los bits altos reparten bien IDs consecutivos
+    if (bitsFragmento == 0) return *fragmentos[0];
+    uint32_t h = static_cast<uint32_t>(id) * 2654435769u;
+    return *fragmentos[h >> (32 - bitsFragmento)];
+}
+
+std::vector<std::shared_lock<std::shared_mutex>> ConcurrentEmployeeManager::bloquearTodos() const {
+    std::vector<std::shared_lock<std::shared_mutex>> locks;
+    locks.reserve(fragmentos.size());
+    for (const auto& f : fragmentos) {
+        locks.emplace_back(f->cerrojo);
+    }
+    return locks;
+}
+
+bool ConcurrentEmployeeManager::cargar(const std::string& ruta, std::string& error) {
+    MappedFile archivo(ruta);
+    if (!archivo.abierto()) {
+        error = "no se pudo abrir " + ruta;
+        return false;
+    }
+
+    int maximoId = 0;
+    auto insertar = [&](const RegistroTexto& r) {
+        Fragmento& f = fragmentoDe(r.id);
+        std::unique_lock<std::shared_mutex> lock(f.cerrojo);
+        if (f.gestor.altaConId(r.id, descriptorDe(r))) {
+            maximoId = std::max(maximoId, r.id);
+        }
+    };
+
+    if (snapshot::esSnapshot(archivo.contenido())) {
+        snapshot::Lector lector;
+        if (!lector.abrir(archivo.contenido(), error)) return false;
+
+        std::string lenguajes;
+        for (std::size_t i = 0; i < lector.size(); ++i) {
+            RegistroTexto r = lector.registro(i);
+            lenguajes.clear();
+            unirLenguajes([&](auto&& f) { lector.paraCadaLenguaje(i, f); }, lenguajes);
+            r.lenguajes = lenguajes;
+            insertar(r);
+        }
+        maximoId = std::max(maximoId, lector.siguienteId() - 1);
+    } else {
+        ResultadoAnalisis resultado = analizarEmpleados(archivo.contenido());
+        for (const RegistroTexto& r : resultado.registros) {
+            insertar(r);
+        }
+    }
+
+    int actual = siguienteId.load();
+    while (actual <= maximoId && !siguienteId.compare_exchange_weak(actual, maximoId + 1)) {
+    }
+    return true;
+}
+
+bool ConcurrentEmployeeManager::guardarSnapshot(const std::string& ruta, std::string& error) const {
+    snapshot::Escritor escritor;
+    int id;
+    {
+        auto locks = bloquearTodos();
+        std::size_t total = 0;
+        for (const auto& f : fragmentos) total += f->gestor.getCantidadEmpleados();
+        escritor.reservar(total);
+        for (const auto& f : fragmentos) f->gestor.exportar(escritor);
+        id = siguienteId.load();
+    }
+    // Serializar y escribir ya no necesita los cerrojos
+    return escritor.guardar(ruta, id, error);
+}
+
+int ConcurrentEmployeeManager::agregar(const DescriptorEmpleado& d) {
+    const int id = siguienteId.fetch_add(1);
+    Fragmento& f = fragmentoDe(id);
+    DescriptorEmpleado sinJefe = d;
+    sinJefe.jefe = 0;
+    std::unique_lock<std::shared_mutex> lock(f.cerrojo);
+    f.gestor.altaConId(id, sinJefe);
+    return id;
+}
+
+bool ConcurrentEmployeeManager::eliminar(int id) {
+    Fragmento& f = fragmentoDe(id);
+    std::unique_lock<std::shared_mutex> lock(f.cerrojo);
+    return f.gestor.bajaSinAviso(id);
+}
+
+bool ConcurrentEmployeeManager::modificarSalario(int id, double nuevoSalario) {
+    Fragmento& f = fragmentoDe(id);
+    std::unique_lock<std::shared_mutex> lock(f.cerrojo);
+    return f.gestor.salarioSinAviso(id, nuevoSalario);
+}
+
+std::string ConcurrentEmployeeManager::buscar(int id) const {
+    std::string linea;
+    leer(id, [&](const Employee& emp) { linea = emp.serializar(); });
+    return linea;
+}
+
+double ConcurrentEmployeeManager::calcularNominaTotal() const {
+    std::vector<double> totales(fragmentos.size());
+    {
+        auto locks = bloquearTodos();
+        for (std::size_t i = 0; i < fragmentos.size(); ++i) {
+            totales[i] = fragmentos[i]->gestor.calcularNominaTotal();
+        }
+    }
+    return kernels::sumaPorParejas(totales.data(), totales.size());
+}
+
+std::size_t ConcurrentEmployeeManager::getCantidadEmpleados() const {
+    auto locks = bloquearTodos();
+    std::size_t total = 0;
+    for (const auto& f : fragmentos) total += f->gestor.getCantidadEmpleados();
+    return total;
+}
+
+std::vector<std::pair<std::string, kernels::EstadisticasSalario>>
+ConcurrentEmployeeManager::estadisticasPorDepartamento() const {
+    std::map<std::string, kernels::EstadisticasSalario> porDepartamento;
+    {
+        auto locks = bloquearTodos();
+        for (const auto& f : fragmentos) {
+            for (const auto& [nombre, e] : f->gestor.estadisticasPorDepartamento()) {
+                combinar(porDepartamento[nombre], e);
+            }
+        }
+    }
+    return {porDepartamento.begin(), porDepartamento.end()};
+}
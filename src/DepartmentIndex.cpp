@@ -0,0 +1,56 @@
+#include "DepartmentIndex.h"
+
+DepartmentIndex::Departamento& DepartmentIndex::obtener(Simbolo simbolo) {
+    if (simbolo >= departamentos.size()) {
+        departamentos.resize(simbolo + 1);
+    }
+    return departamentos[simbolo];
+}
+
+DepartmentIndex::Simbolo DepartmentIndex::simbolo(std::string_view departamento) const {
+    // Uno que nunca tuvo empleados no ha pasado por obtener()
+    Simbolo s = SymbolTable::global().buscar(departamento);
+    return s < departamentos.size() ? s : SymbolTable::NINGUNO;
+}
+
+const DepartmentIndex::Departamento* DepartmentIndex::buscar(std::string_view departamento) const {
+    Simbolo s = simbolo(departamento);
+    return s == SymbolTable::NINGUNO ? nullptr : &departamentos[s];
+}
+
+void DepartmentIndex::agregar(int id, Simbolo departamento, double salarioTotal) {
+    Departamento& dept = obtener(departamento);
+    posicionEnLista.insertar(id, dept.miembros.size());
+    dept.miembros.push_back(id);
+    dept.cantidad++;
+    dept.nomina.sumar(salarioTotal);
+}
+
+void DepartmentIndex::quitarMiembro(Departamento& dept, int id) {
+    std::size_t pos = posicionEnLista.buscar(id);
+    if (pos == IdIndex::NO_ENCONTRADO) return;
+
+    if (pos != dept.miembros.size() - 1) {
+        dept.miembros[pos] = dept.miembros.back();
+        posicionEnLista.insertar(dept.miembros[pos], pos);
+    }
+    dept.miembros.pop_back();
+    posicionEnLista.eliminar(id);
+    dept.cantidad--;
+}
+
+void DepartmentIndex::eliminar(int id, Simbolo departamento, double salarioTotal) {
+    Departamento& dept = obtener(departamento);
+    quitarMiembro(dept, id);
+    dept.nomina.sumar(-salarioTotal);
+    if (dept.cantidad == 0) dept.nomina.reiniciar();   // descarta el error acumulado
+}
+
+void DepartmentIndex::cambiarDepartamento(int id, Simbolo anterior, Simbolo nuevo, double salarioTotal) {
+    eliminar(id, anterior, salarioTotal);
+    agregar(id, nuevo, salarioTotal);
+}
+
+void DepartmentIndex::ajustarNomina(Simbolo departamento, double diferencia) {
+    obtener(departamento).nomina.sumar(diferencia);
+}
@@ -1,45 +1,75 @@
 #include "Developer.h"
-#include <sstream>
+#include "EmployeeParser.h"
 #include <iomanip>
 
-Developer::Developer(int id, const std::string& nombre, const std::string& apellido,
-                     double salarioBase, const std::string& departamento,
+namespace {
+
+std::shared_ptr<const Developer::Lenguajes> internarLenguajes(std::string_view lista) {
+    auto lenguajes = std::make_shared<Developer::Lenguajes>();
+    paraCadaLenguaje(lista, [&](std::string_view lang) { lenguajes->push_back(internar(lang)); });
+    return lenguajes;
+}
+
+} // namespace
+
+Developer::Developer(int id, std::string_view nombre, std::string_view apellido,
+                     double salarioBase, std::string_view departamento,
                      const std::vector<std::string>& lenguajes, double bonusProyectos)
+    : Developer(id, nombre, apellido, salarioBase, departamento, unirLenguajes(lenguajes), bonusProyectos) {}
+
+Developer::Developer(int id, std::string_view nombre, std::string_view apellido,
+                     double salarioBase, std::string_view departamento,
+                     std::string_view listaLenguajes, double bonusProyectos)
     : Employee(id, nombre, apellido, salarioBase, departamento),
-      lenguajes(lenguajes), bonusProyectos(bonusProyectos) {}
+      lenguajes(internarLenguajes(listaLenguajes)), bonusProyectos(bonusProyectos) {
+    salarioTotal = recalcularSalarioTotal();
+}
 
-double Developer::calcularSalarioTotal() const {
+double Developer::recalcularSalarioTotal() const {
     // Salario base + bonus de proyectos + bonus por cada lenguaje
-    return salarioBase + bonusProyectos + (lenguajes.size() * 500.0);
+    return salarioBase + bonusProyectos + (getCantidadLenguajes() * 500.0);
+}
+
+ComponentesSalario Developer::getComponentesSalario() const {
+    return {TipoEmpleado::Developer, salarioBase, bonusProyectos,
+            getCantidadLenguajes(), 0};
 }
 
 void Developer::mostrarInfo() const {
     Employee::mostrarInfo();
     std::cout << "│ Bonus Proyectos: $" << std::setw(20) << std::left << std::fixed << std::setprecision(2) << bonusProyectos << "│\n";
-    std::cout << "│ Lenguajes (" << lenguajes.size() << "): ";
+    std::cout << "│ Lenguajes (" << getCantidadLenguajes() << "): ";
 
     std::string langs;
-    for (size_t i = 0; i < lenguajes.size(); ++i) {
-        langs += lenguajes[i];
-        if (i < lenguajes.size() - 1) langs += ", ";
+    for (SymbolTable::Simbolo lang : *lenguajes) {
+        if (!langs.empty()) langs += ", ";
+        langs += textoSimbolo(lang);
     }
-    std::cout << std::setw(28 - std::to_string(lenguajes.size()).length()) << std::left << langs << "│\n";
+    std::cout << std::setw(28 - std::to_string(getCantidadLenguajes()).length()) << std::left << langs << "│\n";
     std::cout << "└─────────────────────────────────────────┘\n";
 }
 
 std::string Developer::serializar() const {
-    std::ostringstream oss;
-    oss << "DEV|" << id << "|" << nombre << "|" << apellido << "|"
-        << salarioBase << "|" << departamento << "|" << bonusProyectos << "|";
-
-    for (size_t i = 0; i < lenguajes.size(); ++i) {
-        oss << lenguajes[i];
-        if (i < lenguajes.size() - 1) oss << ",";
-    }
+    std::string lista;
+    unirLenguajes(*lenguajes, lista);
+    std::string linea;
+    formatearRegistro({TipoEmpleado::Developer, id, getNombre(), getApellido(), salarioBase,
+                       getDepartamento(), bonusProyectos, 0, jefe, lista, 0}, linea);
+    return linea;
+}
 
-    return oss.str();
+void Developer::agregarLenguaje(std::string_view lenguaje) {
+    double anterior = calcularSalarioTotal();
+    const SymbolTable::Simbolo simbolo = internar(lenguaje);
+    auto lista = std::make_shared<Lenguajes>(*lenguajes);
+    lista->push_back(simbolo);
+    lenguajes = std::move(lista);
+    if (observador) observador->alAgregarLenguaje(*this, simbolo);
+    notificarCambioSalario(anterior);
 }
 
-void Developer::agregarLenguaje(const std::string& lenguaje) {
-    lenguajes.push_back(lenguaje);
+void Developer::setBonusProyectos(double bonus) {
+    double anterior = calcularSalarioTotal();
+    bonusProyectos = bonus;
+    notificarCambioSalario(anterior);
 }
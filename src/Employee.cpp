@@ -1,17 +1,48 @@
 #include "Employee.h"
+#include "Arena.h"
 #include <iomanip>
+#include <new>
 
-Employee::Employee(int id, const std::string& nombre, const std::string& apellido,
-                   double salarioBase, const std::string& departamento)
+Employee::Employee(int id, std::string_view nombre, std::string_view apellido,
+                   double salarioBase, std::string_view departamento)
     : id(id), nombre(nombre), apellido(apellido),
-      salarioBase(salarioBase), departamento(departamento) {}
+      departamento(internar(departamento)), salarioBase(salarioBase) {}
+
+void* Employee::operator new(std::size_t tamano) {
+    if (PoolObjetos* pool = PoolObjetos::paraTamano(tamano)) {
+        return pool->reservar();
+    }
+    return ::operator new(tamano);
+}
+
+void Employee::operator delete(void* p, std::size_t tamano) {
+    // Con destructor virtual 'tamano' es el del tipo dinámico, el mismo que se reservó
+    if (PoolObjetos* pool = PoolObjetos::paraTamano(tamano)) {
+        pool->liberar(p);
+    } else {
+        ::operator delete(p);
+    }
+}
 
 void Employee::mostrarInfo() const {
     std::cout << "\n┌─────────────────────────────────────────┐\n";
     std::cout << "│ ID: " << std::setw(36) << std::left << id << "│\n";
     std::cout << "│ Nombre: " << std::setw(32) << std::left << (nombre + " " + apellido) << "│\n";
     std::cout << "│ Tipo: " << std::setw(34) << std::left << getTipo() << "│\n";
-    std::cout << "│ Departamento: " << std::setw(26) << std::left << departamento << "│\n";
+    std::cout << "│ Departamento: " << std::setw(26) << std::left << getDepartamento() << "│\n";
+    if (jefe != 0) std::cout << "│ Jefe: " << std::setw(34) << std::left << jefe << "│\n";
     std::cout << "│ Salario Base: $" << std::setw(24) << std::left << std::fixed << std::setprecision(2) << salarioBase << "│\n";
     std::cout << "│ Salario Total: $" << std::setw(23) << std::left << calcularSalarioTotal() << "│\n";
 }
+
+void Employee::setSalarioBase(double nuevoSalario) {
+    double anterior = calcularSalarioTotal();
+    salarioBase = nuevoSalario;
+    notificarCambioSalario(anterior);
+}
+
+void Employee::setDepartamento(std::string_view dept) {
+    SymbolTable::Simbolo anterior = departamento;
+    departamento = internar(dept);
+    if (observador) observador->alCambiarDepartamento(*this, anterior);
+}
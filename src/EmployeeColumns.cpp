@@ -0,0 +1,49 @@
+#include "EmployeeColumns.h"
+
+void EmployeeColumns::agregar(const ComponentesSalario& c, uint32_t departamento) {
+    salariosBase.push_back(c.salarioBase);
+    bonus.push_back(c.bonus);
+    tipos.push_back(c.tipo);
+    lenguajes.push_back(c.lenguajes);
+    equipos.push_back(c.equipo);
+    departamentos.push_back(departamento);
+}
+
+void EmployeeColumns::actualizar(std::size_t pos, const ComponentesSalario& c) {
+    salariosBase[pos] = c.salarioBase;
+    bonus[pos] = c.bonus;
+    tipos[pos] = c.tipo;
+    lenguajes[pos] = c.lenguajes;
+    equipos[pos] = c.equipo;
+}
+
+void EmployeeColumns::eliminarIntercambiando(std::size_t pos) {
+    // Mismo esquema que el vector de empleados: el último ocupa el hueco
+    salariosBase[pos] = salariosBase.back();
+    bonus[pos] = bonus.back();
+    tipos[pos] = tipos.back();
+    lenguajes[pos] = lenguajes.back();
+    equipos[pos] = equipos.back();
+    departamentos[pos] = departamentos.back();
+
+    salariosBase.pop_back();
+    bonus.pop_back();
+    tipos.pop_back();
+    lenguajes.pop_back();
+    equipos.pop_back();
+    departamentos.pop_back();
+}
+
+void EmployeeColumns::reservar(std::size_t cantidad) {
+    salariosBase.reserve(cantidad);
+    bonus.reserve(cantidad);
+    tipos.reserve(cantidad);
+    lenguajes.reserve(cantidad);
+    equipos.reserve(cantidad);
+    departamentos.reserve(cantidad);
+}
+
+kernels::ColumnasSalario EmployeeColumns::vista() const {
+    return {salariosBase.data(), bonus.data(), lenguajes.data(), equipos.data(),
+            tipos.data(), departamentos.data(), size()};
+}
@@ -1,130 +1,767 @@
 #include "EmployeeManager.h"
-#include <fstream>
-#include <sstream>
+#include "MappedFile.h"
+#include "ProcessStats.h"
 #include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <cmath>
+#include <filesystem>
+#include <unordered_map>
 
-EmployeeManager::EmployeeManager(const std::string& archivo)
-    : siguienteId(1), archivoGuardado(archivo) {
+namespace {
+const Developer::Lenguajes& lenguajesDe(const Employee& emp) {
+    static const Developer::Lenguajes NINGUNO;
+    const auto* dev = dynamic_cast<const Developer*>(&emp);
+    return dev ? dev->getLenguajes() : NINGUNO;
+}
+
+VersionedStore::Registro registroVersion(const Employee& emp) {
+    const ComponentesSalario c = emp.getComponentesSalario();
+    std::shared_ptr<const Developer::Lenguajes> lenguajes;
+    if (c.tipo == TipoEmpleado::Developer) lenguajes = static_cast<const Developer&>(emp).getListaCompartida();
+    return {emp.getId(), c.tipo, c.equipo, emp.getJefe(), c.salarioBase, c.bonus, emp.calcularSalarioTotal(),
+            std::string(emp.getNombre()), std::string(emp.getApellido()), emp.getSimboloDepartamento(),
+            std::move(lenguajes)};
+}
+
+// Bonus es el de proyectos o el de gestión según el tipo
+void fijarCampo(Employee& emp, CampoMasivo campo, double valor) {
+    if (campo == CampoMasivo::SalarioBase) {
+        emp.setSalarioBase(valor);
+    } else if (emp.getComponentesSalario().tipo == TipoEmpleado::Developer) {
+        static_cast<Developer&>(emp).setBonusProyectos(valor);
+    } else {
+        static_cast<Manager&>(emp).setBonusGestion(valor);
+    }
+}
+
+// Texto que cabe en un campo del archivo: no vacío y sin separadores
+bool campoValido(std::string_view texto, std::string_view prohibidos) {
+    return !texto.empty() && texto.find_first_of(prohibidos) == std::string_view::npos;
+}
+
+bool sabeLenguaje(const Developer& dev, std::string_view lenguaje) {
+    const SymbolTable::Simbolo s = SymbolTable::global().buscar(lenguaje);
+    const Developer::Lenguajes& lenguajes = dev.getLenguajes();
+    return s != SymbolTable::NINGUNO && std::find(lenguajes.begin(), lenguajes.end(), s) != lenguajes.end();
+}
+} // namespace
+
+EmployeeManager::EmployeeManager(const std::string& archivo, unsigned hilos)
+    : siguienteId(1), archivoGuardado(archivo),
+      formatoBinario(archivo.size() >= 5 && archivo.compare(archivo.size() - 5, 5, ".snap") == 0) {
+    setHilos(hilos);
+    if (archivoGuardado.empty()) return;
+    empezarCarga();
     cargarDesdeArchivo();
+    if (formatoBinario) {
+        abrirDiario();
+    }
+    terminarCarga();
 }
 
 EmployeeManager::~EmployeeManager() {
-    guardarEnArchivo();
+    if (diario) {
+        esperarCompactacion();
+        sincronizarDiario();
+        esperarCompactacion();
+        return;
+    }
+    if (cambiosSinGuardar > 0) guardarEnSegundoPlano();
+    esperarGuardado();
 }
 
 void EmployeeManager::cargarDesdeArchivo() {
-    std::ifstream archivo(archivoGuardado);
-    if (!archivo.is_open()) {
+    metricas::Temporizador temporizador(metricas::Operacion::Carga);
+    MappedFile archivo(archivoGuardado);
+    if (!archivo.abierto()) {
         std::cout << "⚠️  Archivo no encontrado. Iniciando con base de datos vacía.\n";
         return;
     }
 
-    std::string linea;
-    while (std::getline(archivo, linea)) {
-        std::istringstream iss(linea);
-        std::string tipo, campo;
-        std::vector<std::string> campos;
+    if (snapshot::esSnapshot(archivo.contenido())) {
+        std::string error;
+        if (!cargarDesdeSnapshot(archivo.contenido(), error)) {
+            std::cerr << "❌ Instantánea inválida (" << error << "). Iniciando con base de datos vacía.\n";
+            return;
+        }
+        formatoBinario = true;
+        temporizador.detener();
+        metricas::contar(metricas::Evento::FilasCargadas, empleados.size());
+        std::cout << "✅ Cargados " << empleados.size() << " empleados desde instantánea.\n";
+        return;
+    }
+
+    ResultadoAnalisis resultado = analizarEmpleados(archivo.contenido(), pool.get());
+    cargarRegistros(resultado.registros, resultado.errores);
+    temporizador.detener();
+    metricas::contar(metricas::Evento::FilasCargadas, empleados.size());
+    metricas::contar(metricas::Evento::LineasIgnoradas, resultado.errores.size());
 
-        while (std::getline(iss, campo, '|')) {
-            campos.push_back(campo);
+    std::cout << "✅ Cargados " << empleados.size() << " empleados desde archivo.\n";
+    informarErroresCarga(resultado.errores);
+}
+
+void EmployeeManager::cargarRegistros(const std::vector<RegistroTexto>& registros,
+                                      std::vector<ErrorLinea>& errores) {
+    std::size_t total = empleados.size() + registros.size();
+    empleados.reserve(total);
+    indicePorId.reservar(total);
+    columnas.reservar(total);
+
+    for (const RegistroTexto& r : registros) {
+        if (!registrarRegistro(r)) {
+            errores.push_back({r.linea, "ID duplicado " + std::to_string(r.id)});
         }
+    }
+}
 
-        if (campos.size() < 6) continue;
+bool EmployeeManager::cargarDesdeSnapshot(std::string_view imagen, std::string& error) {
+    snapshot::Lector lector;
+    if (!lector.abrir(imagen, error)) return false;
 
-        tipo = campos[0];
-        int id = std::stoi(campos[1]);
-        std::string nombre = campos[2];
-        std::string apellido = campos[3];
-        double salarioBase = std::stod(campos[4]);
-        std::string departamento = campos[5];
+    std::size_t total = empleados.size() + lector.size();
+    empleados.reserve(total);
+    indicePorId.reservar(total);
+    columnas.reservar(total);
 
-        if (tipo == "DEV" && campos.size() >= 8) {
-            double bonus = std::stod(campos[6]);
-            std::vector<std::string> lenguajes;
+    std::string lenguajes;
+    for (std::size_t i = 0; i < lector.size(); ++i) {
+        RegistroTexto r = lector.registro(i);
+        lenguajes.clear();
+        unirLenguajes([&](auto&& f) { lector.paraCadaLenguaje(i, f); }, lenguajes);
+        r.lenguajes = lenguajes;
+        registrarRegistro(r);
+    }
+    siguienteId = std::max(siguienteId, lector.siguienteId());
+    return true;
+}
 
-            std::istringstream langStream(campos[7]);
-            std::string lang;
-            while (std::getline(langStream, lang, ',')) {
-                lenguajes.push_back(lang);
-            }
+bool EmployeeManager::registrarRegistro(const RegistroTexto& r) {
+    if (buscarPorId(r.id)) return false;
 
-            empleados.push_back(std::make_unique<Developer>(
-                id, nombre, apellido, salarioBase, departamento, lenguajes, bonus));
-        } else if (tipo == "MGR" && campos.size() >= 8) {
-            int equipo = std::stoi(campos[6]);
-            double bonus = std::stod(campos[7]);
+    // Solo se usa cargando: el jefe se valida y el equipo se cuenta en terminarCarga()
+    std::unique_ptr<Employee> emp;
+    if (r.tipo == TipoEmpleado::Developer) {
+        emp = std::make_unique<Developer>(
+            r.id, r.nombre, r.apellido, r.salarioBase, r.departamento, r.lenguajes, r.bonus);
+    } else {
+        emp = std::make_unique<Manager>(
+            r.id, r.nombre, r.apellido, r.salarioBase, r.departamento, r.equipo, r.bonus);
+    }
+    emp->setJefe(r.jefe);
+    registrar(std::move(emp));
 
-            empleados.push_back(std::make_unique<Manager>(
-                id, nombre, apellido, salarioBase, departamento, equipo, bonus));
-        }
+    if (r.id >= siguienteId) {
+        siguienteId = r.id + 1;
+    }
+    return true;
+}
 
-        if (id >= siguienteId) {
-            siguienteId = id + 1;
-        }
+void EmployeeManager::informarErroresCarga(std::vector<ErrorLinea>& errores) const {
+    if (errores.empty()) return;
+
+    const std::size_t MAX_MOSTRADOS = 10;
+    std::sort(errores.begin(), errores.end(),
+              [](const ErrorLinea& a, const ErrorLinea& b) { return a.linea < b.linea; });
+
+    std::cout << "⚠️  " << errores.size() << " línea(s) ignoradas en " << archivoGuardado << ":\n";
+    for (std::size_t i = 0; i < errores.size() && i < MAX_MOSTRADOS; ++i) {
+        std::cout << "   Línea " << errores[i].linea << ": " << errores[i].motivo << "\n";
+    }
+    if (errores.size() > MAX_MOSTRADOS) {
+        std::cout << "   ... y " << (errores.size() - MAX_MOSTRADOS) << " más\n";
     }
+}
 
-    archivo.close();
-    std::cout << "✅ Cargados " << empleados.size() << " empleados desde archivo.\n";
+bool EmployeeManager::guardarEnArchivo() {
+    if (diario) return sincronizarDiario();
+    guardarEnSegundoPlano();
+    return esperarGuardado();
 }
 
-void EmployeeManager::guardarEnArchivo() const {
-    std::ofstream archivo(archivoGuardado);
-    if (!archivo.is_open()) {
-        std::cerr << "❌ Error al abrir archivo para guardar.\n";
+void EmployeeManager::guardarEnSegundoPlano() {
+    if (archivoGuardado.empty()) return;
+    // Con diario los cambios ya están anotados: guardar solo cuesta lo pendiente
+    if (diario) {
+        sincronizarDiario();
+        return;
+    }
+
+    if (!guardador) {
+        guardador = std::make_unique<BackgroundSaver>(
+            archivoGuardado, formatoBinario ? BackgroundSaver::Formato::Snapshot : BackgroundSaver::Formato::Texto);
+    }
+    // En este hilo solo se fija la versión; recorrerla y escribirla, en el del guardador
+    VersionedStore::Instantanea version = fijarVersion();
+    if (!version.valida()) {
+        std::cerr << "❌ Demasiadas versiones fijadas; se guardará más tarde\n";
         return;
     }
+    guardador->solicitar(std::move(version));
+    cambiosSinGuardar = 0;
+    proximoAutoguardado = std::chrono::steady_clock::now() + intervaloAutoguardado;
+}
+
+bool EmployeeManager::esperarGuardado() {
+    if (!guardador) return true;
+    std::string error;
+    if (!guardador->esperarTodo(error)) {
+        std::cerr << "❌ Error al guardar: " << error << "\n";
+        return false;
+    }
+    return true;
+}
+
+VersionedStore::Instantanea EmployeeManager::fijarVersion() {
+    versiones.setSiguienteId(siguienteId);
+    return versiones.fijar();
+}
+
+void EmployeeManager::setAutoguardado(std::chrono::seconds intervalo) {
+    intervaloAutoguardado = intervalo;
+    proximoAutoguardado = std::chrono::steady_clock::now() + intervaloAutoguardado;
+}
+
+snapshot::Escritor EmployeeManager::crearEscritor() const {
+    snapshot::Escritor escritor;
+    escritor.reservar(empleados.size());
+    exportar(escritor);
+    return escritor;
+}
 
+void EmployeeManager::exportar(snapshot::Escritor& escritor) const {
+    std::string lenguajes;
     for (const auto& emp : empleados) {
-        archivo << emp->serializar() << "\n";
+        ComponentesSalario c = emp->getComponentesSalario();
+        lenguajes.clear();
+        unirLenguajes(lenguajesDe(*emp), lenguajes);
+        escritor.agregar({c.tipo, emp->getId(), emp->getNombre(), emp->getApellido(), c.salarioBase,
+                          emp->getDepartamento(), c.bonus, c.equipo, emp->getJefe(), lenguajes, 0});
     }
+}
 
-    archivo.close();
+bool EmployeeManager::guardarSnapshot(const std::string& ruta) const {
+    metricas::Temporizador temporizador(metricas::Operacion::Guardado);
+    std::string error;
+    if (!crearEscritor().guardar(ruta, siguienteId, error)) {
+        std::cerr << "❌ Error al guardar instantánea: " << error << "\n";
+        return false;
+    }
+    return true;
 }
 
-Employee* EmployeeManager::buscarPorId(int id) {
-    for (auto& emp : empleados) {
-        if (emp->getId() == id) {
-            return emp.get();
+bool EmployeeManager::cargarSnapshot(const std::string& ruta) {
+    metricas::Temporizador temporizador(metricas::Operacion::Carga);
+    MappedFile archivo(ruta);
+    std::string error = "no se pudo abrir " + ruta;
+    empezarCarga();
+    bool ok = archivo.abierto() && cargarDesdeSnapshot(archivo.contenido(), error);
+    terminarCarga();
+    if (!ok) {
+        std::cerr << "❌ Error al cargar instantánea: " << error << "\n";
+    } else {
+        ++cambiosSinGuardar;
+    }
+    return ok;
+}
+
+void EmployeeManager::abrirDiario() {
+    const std::string rutaDiario = archivoGuardado + ".wal";
+    const std::string rutaAnterior = rutaDiario + ".old";
+
+    // Un segmento .old indica una compactación interrumpida: se reaplica y se
+    // vuelca ya, porque la instantánea en disco puede no incluirlo
+    bool pendienteAnterior = std::filesystem::exists(rutaAnterior);
+    if (pendienteAnterior) {
+        reproducirDiario(rutaAnterior, false);
+    }
+    reproducirDiario(rutaDiario, true);
+    if (pendienteAnterior && guardarSnapshot(archivoGuardado)) {
+        std::filesystem::remove(rutaAnterior);
+    }
+
+    diario = std::make_unique<WriteAheadLog>(rutaDiario);
+    if (!diario->abierto()) {
+        std::cerr << "❌ No se pudo abrir el diario " << rutaDiario << "; se guardará al salir.\n";
+        diario.reset();
+    }
+}
+
+bool EmployeeManager::reproducirDiario(const std::string& ruta, bool truncarCola) {
+    std::size_t aplicadas = 0;
+    std::size_t validos = 0;
+    std::size_t total = 0;
+    {
+        metricas::Temporizador temporizador(metricas::Operacion::ReproduccionDiario);
+        MappedFile archivo(ruta);
+        if (!archivo.abierto()) return false;
+        total = archivo.contenido().size();
+        validos = WriteAheadLog::reproducir(archivo.contenido(), [&](const EntradaDiario& entrada) {
+            aplicarEntrada(entrada);
+            ++aplicadas;
+        });
+    }
+
+    metricas::contar(metricas::Evento::CambiosReaplicados, aplicadas);
+    if (aplicadas > 0) {
+        std::cout << "✅ Reaplicados " << aplicadas << " cambios desde " << ruta << ".\n";
+    }
+    // Una cola rota (corte durante la escritura) se descarta para poder seguir anexando
+    if (validos < total) {
+        std::cout << "⚠️  Descartados " << (total - validos) << " bytes inválidos al final de " << ruta << ".\n";
+        if (truncarCola) {
+            std::error_code ec;
+            std::filesystem::resize_file(ruta, validos, ec);
+        }
+    }
+    return true;
+}
+
+void EmployeeManager::aplicarEntrada(const EntradaDiario& entrada) {
+    switch (entrada.operacion) {
+        case OperacionDiario::Poner: {
+            RegistroTexto r;
+            std::string motivo;
+            if (!analizarLinea(entrada.linea, r, motivo)) return;
+
+            std::size_t pos = indicePorId.buscar(r.id);
+            if (pos != IdIndex::NO_ENCONTRADO) quitar(pos);
+            registrarRegistro(r);
+            break;
+        }
+        case OperacionDiario::Borrar: {
+            std::size_t pos = indicePorId.buscar(entrada.id);
+            if (pos != IdIndex::NO_ENCONTRADO) quitar(pos);
+            break;
+        }
+        case OperacionDiario::Salario:
+            if (Employee* emp = buscarPorId(entrada.id)) emp->setSalarioBase(entrada.salario);
+            break;
+        case OperacionDiario::Masiva:
+            for (std::size_t i = 0; i < entrada.cantidadValores(); ++i) {
+                int id;
+                double valor;
+                entrada.leerValor(i, id, valor);
+                if (Employee* emp = buscarPorId(id)) fijarCampo(*emp, entrada.campo, valor);
+            }
+            break;
+        case OperacionDiario::Jefe: {
+            std::size_t pos = indicePorId.buscar(entrada.id);
+            if (pos == IdIndex::NO_ENCONTRADO) return;
+            empleados[pos]->setJefe(entrada.jefe);
+            versiones.actualizar(pos, registroVersion(*empleados[pos]));
+            break;
+        }
+        case OperacionDiario::Departamento: {
+            Employee* emp = buscarPorId(entrada.id);
+            if (emp && emp->getDepartamento() != entrada.texto) emp->setDepartamento(entrada.texto);
+            break;
+        }
+        case OperacionDiario::Lenguaje: {
+            Employee* emp = buscarPorId(entrada.id);
+            if (!emp || emp->getComponentesSalario().tipo != TipoEmpleado::Developer) return;
+            auto& dev = static_cast<Developer&>(*emp);
+            if (!sabeLenguaje(dev, entrada.texto)) dev.agregarLenguaje(entrada.texto);
+            break;
+        }
+    }
+}
+
+void EmployeeManager::revisarPersistencia() {
+    if (versiones.hayRetirados()) versiones.recoger();
+    if (diario) {
+        revisarDiario();
+    } else if (intervaloAutoguardado.count() > 0 && cambiosSinGuardar > 0 &&
+               std::chrono::steady_clock::now() >= proximoAutoguardado) {
+        guardarEnSegundoPlano();
+    }
+}
+
+bool EmployeeManager::sincronizarDiario() {
+    metricas::Temporizador temporizador(metricas::Operacion::Guardado);
+    std::string error;
+    if (diario->sincronizar(error) && !diarioRoto) return true;
+    if (!diarioRoto) std::cerr << "❌ Error al escribir el diario: " << error << "\n";
+    diarioRoto = true;
+
+    // Los cambios siguen en memoria: una instantánea completa los guarda
+    esperarCompactacion();
+    if (!guardarYVaciarDiario()) return false;
+    diarioRoto = false;
+    return true;
+}
+
+bool EmployeeManager::guardarYVaciarDiario() {
+    // Escrita en este hilo, la instantánea lo incluye todo: si sale bien
+    // sobran los segmentos del diario, también el de una compactación fallida
+    if (!guardarSnapshot(archivoGuardado)) return false;
+    const std::string rutaAnterior = diario->getRuta() + ".old";
+    std::error_code ec;
+    std::filesystem::remove(rutaAnterior, ec);
+    std::string error;
+    if (diario->rotar(rutaAnterior, error)) std::filesystem::remove(rutaAnterior, ec);
+    return true;
+}
+
+void EmployeeManager::revisarDiario() {
+    const std::uint64_t UMBRAL_COMPACTACION = 4u << 20;
+    if (diario->bytes() >= UMBRAL_COMPACTACION && !compactando) {
+        compactar();
+    }
+}
+
+bool EmployeeManager::compactar() {
+    if (!diario || compactando) return false;
+    esperarCompactacion();
+
+    const std::string rutaAnterior = diario->getRuta() + ".old";
+    metricas::contar(metricas::Evento::Compactaciones);
+    // Un .old es de una compactación que falló y puede ser la única copia de
+    // sus cambios: en vez de pisarlo, se guarda aquí mismo y luego sobra
+    if (std::filesystem::exists(rutaAnterior)) return guardarYVaciarDiario();
+
+    std::string error;
+    if (!diario->rotar(rutaAnterior, error)) {
+        std::cerr << "❌ No se pudo rotar el diario: " << error << "\n";
+        return false;
+    }
+
+    // La copia de las columnas se hace aquí; serializar y escribir, en segundo plano
+    compactando = true;
+    compactador = std::thread([this, escritor = crearEscritor(), id = siguienteId, rutaAnterior]() {
+        metricas::Temporizador temporizador(metricas::Operacion::Compactacion);
+        std::string error;
+        if (escritor.guardar(archivoGuardado, id, error)) {
+            std::filesystem::remove(rutaAnterior);
+        } else {
+            std::cerr << "❌ Compactación fallida: " << error << "\n";
         }
+        compactando = false;
+    });
+    return true;
+}
+
+void EmployeeManager::esperarCompactacion() {
+    if (compactador.joinable()) {
+        compactador.join();
     }
-    return nullptr;
+}
+
+Employee* EmployeeManager::buscarPorId(int id) {
+    std::size_t pos = indicePorId.buscar(id);
+    return pos == IdIndex::NO_ENCONTRADO ? nullptr : empleados[pos].get();
+}
+
+const Employee* EmployeeManager::buscarPorId(int id) const {
+    std::size_t pos = indicePorId.buscar(id);
+    return pos == IdIndex::NO_ENCONTRADO ? nullptr : empleados[pos].get();
+}
+
+bool EmployeeManager::registrar(std::unique_ptr<Employee> emp) {
+    if (indicePorId.buscar(emp->getId()) != IdIndex::NO_ENCONTRADO) {
+        return false;
+    }
+    indicePorId.insertar(emp->getId(), empleados.size());
+    const SymbolTable::Simbolo dept = emp->getSimboloDepartamento();
+    indicePorDepartamento.agregar(emp->getId(), dept, emp->calcularSalarioTotal());
+    columnas.agregar(emp->getComponentesSalario(), dept);
+    indicePorLenguaje.agregarEmpleado(emp->getId(), lenguajesDe(*emp), dept);
+    indicePorNombre.agregarEmpleado(emp->getId(), emp->getNombre(), emp->getApellido());
+    emp->setObservador(this);
+    empleados.push_back(std::move(emp));
+
+    const Employee& nuevo = *empleados.back();
+    versiones.agregar(registroVersion(nuevo));
+    ajustarNomina(nuevo.calcularSalarioTotal());
+    if (!cargando) {
+        ordenPorId.insertar(nuevo.getId(), nuevo.getId());
+        ordenPorSalarioTotal.insertar(nuevo.calcularSalarioTotal(), nuevo.getId());
+        ordenPorSalarioBase.insertar(nuevo.getSalarioBase(), nuevo.getId());
+        jerarquia.agregar(nuevo.getId(), nuevo.calcularSalarioTotal(), nuevo.getJefe());
+        if (nuevo.getJefe() != 0) ajustarEquipo(nuevo.getJefe(), 1);
+    }
+    return true;
+}
+
+void EmployeeManager::reservarAltas(std::size_t cantidad) {
+    // Crecimiento geométrico: reservar justo 'total' en cada lote pequeño
+    // (altas de una en una por el servidor) copiaría el vector cada vez
+    std::size_t total = empleados.size() + cantidad;
+    if (total <= empleados.capacity()) return;
+    total = std::max(total, 2 * empleados.capacity());
+    empleados.reserve(total);
+    indicePorId.reservar(total);
+    columnas.reservar(total);
+}
+
+int EmployeeManager::altaSinAviso(const DescriptorEmpleado& d) {
+    const int id = siguienteId;
+    return altaConId(id, d) ? id : 0;
+}
+
+bool EmployeeManager::altaConId(int id, const DescriptorEmpleado& d) {
+    if (d.jefe != 0 && !esManager(d.jefe)) return false;
+    std::unique_ptr<Employee> emp;
+    if (d.tipo == TipoEmpleado::Developer) {
+        emp = std::make_unique<Developer>(
+            id, d.nombre, d.apellido, d.salarioBase, d.departamento, d.lenguajes, d.bonus);
+    } else {
+        emp = std::make_unique<Manager>(id, d.nombre, d.apellido, d.salarioBase, d.departamento, 0, d.bonus);
+    }
+    emp->setJefe(d.jefe);
+    if (!registrar(std::move(emp))) return false;
+    // Fuera de una carga ya lo cuenta registrar(); dentro, el jefe ya está validado
+    if (cargando && d.jefe != 0) ajustarEquipo(d.jefe, 1);
+
+    if (id >= siguienteId) {
+        siguienteId = id + 1;
+    }
+    if (diario) {
+        diario->anotarPoner(empleados.back()->serializar());
+    }
+    ++cambiosSinGuardar;
+    return true;
 }
 
 void EmployeeManager::agregarDeveloper(const std::string& nombre, const std::string& apellido,
                                        double salarioBase, const std::string& departamento,
-                                       const std::vector<std::string>& lenguajes, double bonus) {
-    empleados.push_back(std::make_unique<Developer>(
-        siguienteId++, nombre, apellido, salarioBase, departamento, lenguajes, bonus));
-    std::cout << "✅ Developer agregado con ID: " << (siguienteId - 1) << "\n";
+                                       const std::vector<std::string>& lenguajes, double bonus, int jefe) {
+    metricas::Temporizador temporizador(metricas::Operacion::Alta);
+    const std::string lista = unirLenguajes(lenguajes);
+    int id = altaSinAviso({TipoEmpleado::Developer, nombre, apellido, salarioBase, departamento, bonus, jefe, lista});
+    if (id == 0) {
+        std::cout << "❌ El jefe " << jefe << " no existe o no es manager\n";
+        return;
+    }
+    revisarPersistencia();
+    temporizador.detener();
+    metricas::contar(metricas::Evento::EmpleadosAlta);
+    std::cout << "✅ Developer agregado con ID: " << id << "\n";
 }
 
 void EmployeeManager::agregarManager(const std::string& nombre, const std::string& apellido,
                                      double salarioBase, const std::string& departamento,
-                                     int equipoACargo, double bonus) {
-    empleados.push_back(std::make_unique<Manager>(
-        siguienteId++, nombre, apellido, salarioBase, departamento, equipoACargo, bonus));
-    std::cout << "✅ Manager agregado con ID: " << (siguienteId - 1) << "\n";
+                                     double bonus, int jefe) {
+    metricas::Temporizador temporizador(metricas::Operacion::Alta);
+    int id = altaSinAviso({TipoEmpleado::Manager, nombre, apellido, salarioBase, departamento, bonus,
+                           jefe, std::string_view()});
+    if (id == 0) {
+        std::cout << "❌ El jefe " << jefe << " no existe o no es manager\n";
+        return;
+    }
+    revisarPersistencia();
+    temporizador.detener();
+    metricas::contar(metricas::Evento::EmpleadosAlta);
+    std::cout << "✅ Manager agregado con ID: " << id << "\n";
 }
 
 bool EmployeeManager::eliminarEmpleado(int id) {
-    auto it = std::remove_if(empleados.begin(), empleados.end(),
-                            [id](const std::unique_ptr<Employee>& emp) {
-                                return emp->getId() == id;
-                            });
-
-    if (it != empleados.end()) {
-        empleados.erase(it, empleados.end());
+    if (bajaSinAviso(id)) {
         std::cout << "✅ Empleado con ID " << id << " eliminado.\n";
         return true;
     }
-
     std::cout << "❌ No se encontró empleado con ID " << id << "\n";
     return false;
 }
 
+bool EmployeeManager::bajaSinAviso(int id) {
+    metricas::Temporizador temporizador(metricas::Operacion::Baja);
+    std::size_t pos = indicePorId.buscar(id);
+    if (pos == IdIndex::NO_ENCONTRADO) {
+        metricas::contar(metricas::Evento::BusquedasFallidas);
+        return false;
+    }
+
+    quitar(pos);
+    if (diario) diario->anotarBorrado(id);
+    ++cambiosSinGuardar;
+    revisarPersistencia();
+    return true;
+}
+
+void EmployeeManager::quitar(std::size_t pos) {
+    const Employee& emp = *empleados[pos];
+    const int id = emp.getId();
+    const int jefe = emp.getJefe();
+    const double salarioTotal = emp.calcularSalarioTotal();
+    std::vector<int> subordinados;
+    if (cargando) {
+        bajasDuranteCarga.emplace_back(id, jefe);
+    } else {
+        if (emp.getComponentesSalario().tipo == TipoEmpleado::Manager) subordinados = jerarquia.subordinados(id);
+        jerarquia.quitar(id);
+    }
+    indicePorDepartamento.eliminar(id, emp.getSimboloDepartamento(), emp.calcularSalarioTotal());
+    indicePorLenguaje.quitarEmpleado(id, lenguajesDe(emp), emp.getSimboloDepartamento());
+    indicePorNombre.quitarEmpleado(id, emp.getNombre(), emp.getApellido());
+    if (!cargando) {
+        ordenPorId.eliminar(id, id);
+        ordenPorSalarioTotal.eliminar(emp.calcularSalarioTotal(), id);
+        ordenPorSalarioBase.eliminar(emp.getSalarioBase(), id);
+    }
+
+    // Borrado por intercambio: el último ocupa el hueco, sin desplazar el resto
+    if (pos != empleados.size() - 1) {
+        empleados[pos] = std::move(empleados.back());
+        indicePorId.insertar(empleados[pos]->getId(), pos);
+    }
+    empleados.pop_back();
+    columnas.eliminarIntercambiando(pos);
+    versiones.quitar(pos);
+    indicePorId.eliminar(id);
+    // Ya fuera de las columnas: si el ajuste renueva el total, no lo vuelve a contar
+    ajustarNomina(-salarioTotal);
+
+    // Su equipo pasa a su jefe; en la jerarquía ya cuelga de él
+    for (int subordinado : subordinados) {
+        const std::size_t posSubordinado = indicePorId.buscar(subordinado);
+        empleados[posSubordinado]->setJefe(jefe);
+        versiones.actualizar(posSubordinado, registroVersion(*empleados[posSubordinado]));
+    }
+    if (jefe != 0 && !cargando) ajustarEquipo(jefe, static_cast<int>(subordinados.size()) - 1);
+    if (empleados.empty()) renovarNomina();   // descarta el error acumulado
+}
+
+void EmployeeManager::ajustarNomina(double diferencia) {
+    // Un NaN o un infinito dejaría el total estropeado hasta la próxima
+    // renovación; mejor recalcularlo ya desde los empleados
+    if (!std::isfinite(diferencia) || !std::isfinite(nominaTotal.valor() + diferencia)) {
+        renovarNomina();
+        return;
+    }
+    nominaTotal.sumar(diferencia);
+    const std::size_t AJUSTES_MINIMOS = 4096;
+    if (++ajustesNomina > std::max(empleados.size(), AJUSTES_MINIMOS)) {
+        renovarNomina();
+    }
+}
+
+void EmployeeManager::renovarNomina() {
+    nominaTotal.reiniciar(recalcularNominaTotal());
+    ajustesNomina = 0;
+}
+
+void EmployeeManager::empezarCarga() {
+    cargando = true;
+    indicePorNombre.empezarCarga();
+}
+
+void EmployeeManager::terminarCarga() {
+    // Primero la jerarquía: al contar los equipos cambian salarios
+    construirJerarquia();
+
+    // Ordenar todo de una vez es mucho más barato que insertar registro a registro
+    std::vector<OrderedIndex::Entrada> porId;
+    porId.reserve(empleados.size());
+    for (const auto& emp : empleados) {
+        porId.push_back({static_cast<double>(emp->getId()), emp->getId()});
+    }
+    ordenPorId.construir(std::move(porId));
+    reconstruirOrdenSalarios();
+    indicePorNombre.terminarCarga();
+    renovarNomina();
+    cargando = false;
+}
+
+void EmployeeManager::construirJerarquia() {
+    // Quien apuntaba a un jefe dado de baja durante la carga pasa al jefe de
+    // este, como habría pasado fuera de ella; una cadena más larga que las
+    // bajas solo puede ser un ciclo
+    std::unordered_map<int, int> bajas;
+    for (const auto& [id, jefe] : bajasDuranteCarga) bajas.insert_or_assign(id, jefe);
+    bajasDuranteCarga.clear();
+    bajasDuranteCarga.shrink_to_fit();
+
+    std::size_t descartados = 0;
+    bool hayJefes = false;
+    std::vector<ReportingTree::Enlace> enlaces;
+    enlaces.reserve(empleados.size());
+    for (std::size_t pos = 0; pos < empleados.size(); ++pos) {
+        Employee& emp = *empleados[pos];
+        int jefe = emp.getJefe();
+        hayJefes |= jefe != 0;
+        bool valido = true;
+        for (std::size_t pasos = 0; jefe != 0 && !buscarPorId(jefe); ++pasos) {
+            auto it = bajas.find(jefe);
+            if (it == bajas.end() || pasos > bajas.size()) {
+                valido = false;
+                break;
+            }
+            jefe = it->second;
+        }
+        if (!valido || (jefe != 0 && (jefe == emp.getId() || !esManager(jefe)))) {
+            jefe = 0;
+            ++descartados;
+        }
+        if (jefe != emp.getJefe()) {
+            emp.setJefe(jefe);
+            versiones.actualizar(pos, registroVersion(emp));
+        }
+        enlaces.push_back({emp.getId(), jefe, emp.calcularSalarioTotal()});
+    }
+    for (int id : jerarquia.construir(enlaces)) {   // ciclos
+        const std::size_t pos = indicePorId.buscar(id);
+        empleados[pos]->setJefe(0);
+        versiones.actualizar(pos, registroVersion(*empleados[pos]));
+        ++descartados;
+    }
+
+    // El equipo a cargo se deriva de la jerarquía, no de lo que diga el archivo
+    // (tras reaplicar un diario el de las líneas puede estar atrasado)
+    std::vector<int> equipos(empleados.size(), 0);
+    for (const auto& emp : empleados) {
+        if (emp->getJefe() != 0) ++equipos[indicePorId.buscar(emp->getJefe())];
+    }
+    std::size_t corregidos = 0;
+    for (std::size_t pos = 0; pos < empleados.size(); ++pos) {
+        auto* manager = dynamic_cast<Manager*>(empleados[pos].get());
+        if (!manager || manager->getEquipoACargo() == equipos[pos]) continue;
+        manager->setEquipoACargo(equipos[pos]);
+        jerarquia.fijarSalario(manager->getId(), manager->calcularSalarioTotal());
+        ++corregidos;
+    }
+    if (corregidos > 0) jerarquia.recalcularAgregados();
+
+    if (descartados > 0) {
+        std::cout << "⚠️  " << descartados << " empleado(s) con un jefe inexistente, que no es manager "
+                  << "o que cerraba un ciclo; quedan sin jefe.\n";
+    }
+    // Datos de antes de la jerarquía: el equipo se escribía a mano y ahora queda en 0
+    if (corregidos > 0 && !hayJefes) {
+        std::cout << "⚠️  " << corregidos << " manager(s) con equipo a cargo pero ningún empleado con jefe; "
+                  << "el equipo se deriva ahora de la jerarquía.\n";
+    }
+    // Lo corregido vive solo en memoria: se deduce igual en cada carga y no
+    // cuenta como cambio, así que abrir para consultar (--informe) no reescribe
+    // el archivo ni compacta; se persiste con el siguiente guardado
+}
+
+bool EmployeeManager::esManager(int id) const {
+    const Employee* emp = buscarPorId(id);
+    return emp && emp->getComponentesSalario().tipo == TipoEmpleado::Manager;
+}
+
+void EmployeeManager::ajustarEquipo(int jefe, int diferencia) {
+    // Por el observador se renuevan su salario total, su rama y los agregados
+    auto& manager = static_cast<Manager&>(*buscarPorId(jefe));
+    manager.setEquipoACargo(manager.getEquipoACargo() + diferencia);
+}
+
+void EmployeeManager::reconstruirOrdenSalarios() {
+    std::vector<OrderedIndex::Entrada> porTotal, porBase;
+    porTotal.reserve(empleados.size());
+    porBase.reserve(empleados.size());
+    for (const auto& emp : empleados) {
+        porTotal.push_back({emp->calcularSalarioTotal(), emp->getId()});
+        porBase.push_back({emp->getSalarioBase(), emp->getId()});
+    }
+    ordenPorSalarioTotal.construir(std::move(porTotal));
+    ordenPorSalarioBase.construir(std::move(porBase));
+}
+
 void EmployeeManager::listarTodosEmpleados() const {
+    metricas::Temporizador temporizador(metricas::Operacion::Informe);
     if (empleados.empty()) {
         std::cout << "📭 No hay empleados registrados.\n";
         return;
@@ -132,27 +769,49 @@ void EmployeeManager::listarTodosEmpleados() const {
 
     std::cout << "\n═══════════════════════════════════════════════\n";
     std::cout << "         LISTADO DE EMPLEADOS\n";
-    std::cout << "═══════════════════════════════════════════════\n";
+    std::cout << "═══════════════════════════════════════════════\n" << std::flush;
 
-    for (const auto& emp : empleados) {
-        emp->mostrarInfo();
+    ReportWriter informe(stdout, FormatoInforme::Tabla);
+    informe.empezar();
+    escribirInforme(informe);
+    informe.terminar();
+}
+
+int EmployeeManager::escribirInforme(ReportWriter& informe, int desdeId, std::size_t cantidad) const {
+    metricas::Temporizador temporizador(metricas::Operacion::Informe);
+    auto it = ordenPorId.primeroNoMenor(static_cast<double>(desdeId));
+    for (; it != ordenPorId.end() && cantidad > 0; ++it, --cantidad) {
+        informe.escribir(*empleados[indicePorId.buscar(it->id)]);
     }
+    return it == ordenPorId.end() ? 0 : it->id;
+}
+
+const Employee* EmployeeManager::getEmpleado(int id) const {
+    auto temporizador = metricas::Temporizador::muestreado(metricas::Operacion::Busqueda);
+    const Employee* emp = buscarPorId(id);
+    if (!emp) metricas::contar(metricas::Evento::BusquedasFallidas);
+    return emp;
 }
 
 void EmployeeManager::buscarEmpleado(int id) const {
-    for (const auto& emp : empleados) {
-        if (emp->getId() == id) {
-            emp->mostrarInfo();
-            return;
+    metricas::Temporizador temporizador(metricas::Operacion::Busqueda);
+    const Employee* emp = buscarPorId(id);
+    temporizador.detener();
+    if (emp) {
+        emp->mostrarInfo();
+        if (emp->getComponentesSalario().tipo == TipoEmpleado::Manager) {
+            const ReportingTree::Rama r = jerarquia.rama(id);
+            std::cout << "👥 Rama: " << r.personas - 1 << " personas a su cargo | Nómina de la rama: $"
+                      << std::fixed << std::setprecision(2) << r.nomina << "\n";
         }
+        return;
     }
+    metricas::contar(metricas::Evento::BusquedasFallidas);
     std::cout << "❌ No se encontró empleado con ID " << id << "\n";
 }
 
 bool EmployeeManager::modificarSalario(int id, double nuevoSalario) {
-    Employee* emp = buscarPorId(id);
-    if (emp) {
-        emp->setSalarioBase(nuevoSalario);
+    if (salarioSinAviso(id, nuevoSalario)) {
         std::cout << "✅ Salario actualizado para empleado ID " << id << "\n";
         return true;
     }
@@ -160,26 +819,570 @@ bool EmployeeManager::modificarSalario(int id, double nuevoSalario) {
     return false;
 }
 
-void EmployeeManager::empleadosPorDepartamento() const {
-    std::map<std::string, int> departamentos;
+bool EmployeeManager::salarioSinAviso(int id, double nuevoSalario) {
+    metricas::Temporizador temporizador(metricas::Operacion::CambioSalario);
+    Employee* emp = buscarPorId(id);
+    if (!emp) {
+        metricas::contar(metricas::Evento::BusquedasFallidas);
+        return false;
+    }
 
-    for (const auto& emp : empleados) {
-        departamentos[emp->getDepartamento()]++;
+    emp->setSalarioBase(nuevoSalario);
+    if (diario) diario->anotarSalario(id, nuevoSalario);
+    ++cambiosSinGuardar;
+    revisarPersistencia();
+    return true;
+}
+
+bool EmployeeManager::cambiarJefe(int id, int jefe, std::string& error) {
+    metricas::Temporizador temporizador(metricas::Operacion::CambioJefe);
+    const std::size_t pos = indicePorId.buscar(id);
+    if (pos == IdIndex::NO_ENCONTRADO) {
+        metricas::contar(metricas::Evento::BusquedasFallidas);
+        error = "no existe el empleado " + std::to_string(id);
+        return false;
+    }
+    Employee& emp = *empleados[pos];
+    const int anterior = emp.getJefe();
+    if (jefe == anterior) return true;
+    if (jefe != 0 && !esManager(jefe)) {
+        error = "el jefe " + std::to_string(jefe) + " no existe o no es manager";
+        return false;
+    }
+    if (jefe != 0 && jerarquia.estaEnRama(id, jefe)) {
+        error = "el jefe " + std::to_string(jefe) + " está en la rama de " + std::to_string(id);
+        return false;
+    }
+
+    jerarquia.mover(id, jefe);
+    emp.setJefe(jefe);
+    versiones.actualizar(pos, registroVersion(emp));
+    if (anterior != 0) ajustarEquipo(anterior, -1);
+    if (jefe != 0) ajustarEquipo(jefe, 1);
+    if (diario) diario->anotarJefe(id, jefe);
+    ++cambiosSinGuardar;
+    revisarPersistencia();
+    return true;
+}
+
+bool EmployeeManager::cambiarDepartamento(int id, std::string_view departamento, std::string& error) {
+    metricas::Temporizador temporizador(metricas::Operacion::CambioDepartamento);
+    Employee* emp = buscarPorId(id);
+    if (!emp) {
+        metricas::contar(metricas::Evento::BusquedasFallidas);
+        error = "no existe el empleado " + std::to_string(id);
+        return false;
+    }
+    if (!campoValido(departamento, "|\r\n")) {
+        error = "departamento inválido '" + std::string(departamento) + "'";
+        return false;
+    }
+    if (departamento == emp->getDepartamento()) return true;
+
+    emp->setDepartamento(departamento);   // el observador mueve índices y columnas
+    if (diario) diario->anotarDepartamento(id, departamento);
+    ++cambiosSinGuardar;
+    revisarPersistencia();
+    return true;
+}
+
+bool EmployeeManager::agregarLenguaje(int id, std::string_view lenguaje, std::string& error) {
+    metricas::Temporizador temporizador(metricas::Operacion::CambioLenguajes);
+    Employee* emp = buscarPorId(id);
+    if (!emp) {
+        metricas::contar(metricas::Evento::BusquedasFallidas);
+        error = "no existe el empleado " + std::to_string(id);
+        return false;
+    }
+    if (emp->getComponentesSalario().tipo != TipoEmpleado::Developer) {
+        error = "el empleado " + std::to_string(id) + " no es developer";
+        return false;
+    }
+    if (!campoValido(lenguaje, "|,\r\n")) {
+        error = "lenguaje inválido '" + std::string(lenguaje) + "'";
+        return false;
+    }
+    auto& dev = static_cast<Developer&>(*emp);
+    if (sabeLenguaje(dev, lenguaje)) return true;
+
+    dev.agregarLenguaje(lenguaje);   // el observador renueva el índice y el salario
+    if (diario) diario->anotarLenguaje(id, lenguaje);
+    ++cambiosSinGuardar;
+    revisarPersistencia();
+    return true;
+}
+
+ReportingTree::Rama EmployeeManager::rama(int id) const {
+    auto temporizador = metricas::Temporizador::muestreado(metricas::Operacion::Nomina);
+    return jerarquia.rama(id);
+}
+
+std::vector<int> EmployeeManager::subordinados(int id) const {
+    return jerarquia.subordinados(id);
+}
+
+std::size_t EmployeeManager::actualizarMasivo(const SeleccionEmpleados& seleccion, const CambioMasivo& cambio) {
+    metricas::Temporizador temporizador(metricas::Operacion::CambioMasivo);
+    kernels::FiltroMasivo filtro;
+    filtro.grupo.porTipo = seleccion.porTipo;
+    filtro.grupo.tipo = seleccion.tipo;
+    if (!seleccion.departamento.empty()) {
+        filtro.grupo.porDepartamento = true;
+        filtro.grupo.departamento = indicePorDepartamento.simbolo(seleccion.departamento);
+        if (filtro.grupo.departamento == SymbolTable::NINGUNO) return 0;
+    }
+    filtro.equipoMinimo = seleccion.equipoMinimo;
+    filtro.baseMinima = seleccion.baseMinima;
+    filtro.baseMaxima = seleccion.baseMaxima;
+
+    double factor = 1.0;
+    double sumando = 0.0;
+    switch (cambio.modo) {
+        case ModoCambio::Porcentaje: factor = 1.0 + cambio.valor / 100.0; break;
+        case ModoCambio::Sumar: sumando = cambio.valor; break;
+        case ModoCambio::Fijar: factor = 0.0; sumando = cambio.valor; break;
+    }
+
+    // 1. Pasada filtrada por las columnas: posiciones y valores nuevos
+    std::vector<uint32_t> posiciones;
+    std::vector<double> valores;
+    kernels::calcularMasivo(columnas.vista(), filtro, cambio.campo == CampoMasivo::Bonus,
+                            factor, sumando, posiciones, valores, pool.get());
+    const std::size_t n = posiciones.size();
+    if (n == 0) return 0;
+
+    // 2. Objetos y columnas, repartidos entre hilos: cada posición la toca un
+    // solo hilo. Sin observador, para no mantener los agregados uno a uno;
+    // cada tarea acumula la diferencia de nómina de cada departamento.
+    const std::size_t numDepartamentos = indicePorDepartamento.cantidadSimbolos();
+    const std::size_t MINIMO_POR_TAREA = 4096;
+    const std::size_t tareas = pool ? std::max<std::size_t>(1, std::min<std::size_t>(
+        n / MINIMO_POR_TAREA, (pool->getTrabajadores() + 1) * 4)) : 1;
+    std::vector<double> totalesAnteriores(n);
+    std::vector<double> basesAnteriores(n);
+    std::vector<int> ids(n);
+    std::vector<double> diferencias(tareas * numDepartamentos, 0.0);   // [tarea][departamento]
+
+    auto aplicarTramo = [&](std::size_t t) {
+        double* diferenciasTarea = diferencias.data() + t * numDepartamentos;
+        const uint32_t* departamentos = columnas.getDepartamentos();
+        for (std::size_t j = n * t / tareas; j < n * (t + 1) / tareas; ++j) {
+            const std::size_t pos = posiciones[j];
+            Employee& emp = *empleados[pos];
+            ids[j] = emp.getId();
+            totalesAnteriores[j] = emp.calcularSalarioTotal();
+            basesAnteriores[j] = emp.getSalarioBase();
+
+            emp.setObservador(nullptr);
+            fijarCampo(emp, cambio.campo, valores[j]);
+            emp.setObservador(this);
+            columnas.actualizar(pos, emp.getComponentesSalario());
+            diferenciasTarea[departamentos[pos]] += emp.calcularSalarioTotal() - totalesAnteriores[j];
+        }
+    };
+    if (tareas == 1) {
+        aplicarTramo(0);
+    } else {
+        pool->ejecutar(tareas, aplicarTramo);
+    }
+
+    // 3. Agregados de una vez
+    for (SymbolTable::Simbolo s = 0; s < numDepartamentos; ++s) {
+        double diferencia = 0.0;
+        for (std::size_t t = 0; t < tareas; ++t) diferencia += diferencias[t * numDepartamentos + s];
+        if (diferencia != 0.0) indicePorDepartamento.ajustarNomina(s, diferencia);
+    }
+    renovarNomina();
+
+    // Con muchos cambios reordenar todo sale más barato que moverlos uno a uno
+    if (n > empleados.size() / 16) {
+        reconstruirOrdenSalarios();
+        for (std::size_t j = 0; j < n; ++j) {
+            jerarquia.fijarSalario(ids[j], empleados[posiciones[j]]->calcularSalarioTotal());
+        }
+        jerarquia.recalcularAgregados();
+    } else {
+        for (std::size_t j = 0; j < n; ++j) {
+            const Employee& emp = *empleados[posiciones[j]];
+            if (totalesAnteriores[j] != emp.calcularSalarioTotal()) {
+                ordenPorSalarioTotal.eliminar(totalesAnteriores[j], ids[j]);
+                ordenPorSalarioTotal.insertar(emp.calcularSalarioTotal(), ids[j]);
+                jerarquia.actualizarSalario(ids[j], emp.calcularSalarioTotal());
+            }
+            if (basesAnteriores[j] != emp.getSalarioBase()) {
+                ordenPorSalarioBase.eliminar(basesAnteriores[j], ids[j]);
+                ordenPorSalarioBase.insertar(emp.getSalarioBase(), ids[j]);
+            }
+        }
+    }
+    for (std::size_t j = 0; j < n; ++j) {
+        versiones.actualizar(posiciones[j], registroVersion(*empleados[posiciones[j]]));
+    }
+
+    // 4. Una sola entrada de diario, con los valores ya calculados
+    if (diario) diario->anotarMasiva(cambio.campo, ids.data(), valores.data(), n);
+    cambiosSinGuardar += n;
+    revisarPersistencia();
+    return n;
+}
+
+void EmployeeManager::alCambiarSalario(const Employee& emp, double salarioTotalAnterior) {
+    const std::size_t pos = indicePorId.buscar(emp.getId());
+    if (!cargando) {
+        // Las columnas aún tienen el salario base anterior
+        const double baseAnterior = columnas.getSalariosBase()[pos];
+        if (salarioTotalAnterior != emp.calcularSalarioTotal()) {
+            ordenPorSalarioTotal.eliminar(salarioTotalAnterior, emp.getId());
+            ordenPorSalarioTotal.insertar(emp.calcularSalarioTotal(), emp.getId());
+        }
+        if (baseAnterior != emp.getSalarioBase()) {
+            ordenPorSalarioBase.eliminar(baseAnterior, emp.getId());
+            ordenPorSalarioBase.insertar(emp.getSalarioBase(), emp.getId());
+        }
+        if (salarioTotalAnterior != emp.calcularSalarioTotal()) {
+            jerarquia.actualizarSalario(emp.getId(), emp.calcularSalarioTotal());
+        }
+    }
+    columnas.actualizar(pos, emp.getComponentesSalario());
+    versiones.actualizar(pos, registroVersion(emp));   // también cubre los lenguajes nuevos
+    const double diferencia = emp.calcularSalarioTotal() - salarioTotalAnterior;
+    indicePorDepartamento.ajustarNomina(emp.getSimboloDepartamento(), diferencia);
+    ajustarNomina(diferencia);
+}
+
+void EmployeeManager::alCambiarDepartamento(const Employee& emp, SymbolTable::Simbolo anterior) {
+    const std::size_t pos = indicePorId.buscar(emp.getId());
+    const SymbolTable::Simbolo dept = emp.getSimboloDepartamento();
+    indicePorDepartamento.cambiarDepartamento(emp.getId(), anterior, dept, emp.calcularSalarioTotal());
+    indicePorLenguaje.cambiarDepartamento(emp.getId(), anterior, dept);
+    columnas.setDepartamento(pos, dept);
+    versiones.actualizar(pos, registroVersion(emp));
+}
+
+void EmployeeManager::alAgregarLenguaje(const Employee& emp, SymbolTable::Simbolo lenguaje) {
+    indicePorLenguaje.agregarLenguaje(emp.getId(), lenguaje);
+}
+
+void EmployeeManager::empleadosPorDepartamento() const {
+    metricas::Temporizador temporizador(metricas::Operacion::Informe);
+    // Solo se ordenan los departamentos, el índice ya tiene los agregados
+    std::vector<SymbolTable::Simbolo> simbolos;
+    for (SymbolTable::Simbolo s = 0; s < indicePorDepartamento.cantidadSimbolos(); ++s) {
+        if (indicePorDepartamento.porSimbolo(s).cantidad > 0) {
+            simbolos.push_back(s);
+        }
     }
+    std::sort(simbolos.begin(), simbolos.end(),
+              [this](SymbolTable::Simbolo a, SymbolTable::Simbolo b) {
+                  return indicePorDepartamento.nombre(a) < indicePorDepartamento.nombre(b);
+              });
 
     std::cout << "\n═══════════════════════════════════════════════\n";
     std::cout << "      EMPLEADOS POR DEPARTAMENTO\n";
     std::cout << "═══════════════════════════════════════════════\n";
 
-    for (const auto& [dept, count] : departamentos) {
-        std::cout << "  " << std::setw(20) << std::left << dept << " : " << count << " empleados\n";
+    for (SymbolTable::Simbolo s : simbolos) {
+        const DepartmentIndex::Departamento& dept = indicePorDepartamento.porSimbolo(s);
+        std::cout << "  " << std::setw(20) << std::left << indicePorDepartamento.nombre(s)
+                  << " : " << dept.cantidad << " empleados"
+                  << " | Nómina: $" << std::fixed << std::setprecision(2) << dept.nomina.valor() << "\n";
     }
 }
 
 double EmployeeManager::calcularNominaTotal() const {
-    double total = 0.0;
-    for (const auto& emp : empleados) {
-        total += emp->calcularSalarioTotal();
+    metricas::Temporizador temporizador(metricas::Operacion::Nomina);
+    return nominaTotal.valor();
+}
+
+double EmployeeManager::recalcularNominaTotal() const {
+    return kernels::sumaTotal(columnas.vista(), {}, pool.get());
+}
+
+void EmployeeManager::setHilos(unsigned hilos) {
+    // El hilo que consulta también calcula: N hilos = N - 1 trabajadores
+    if (hilos <= 1) {
+        pool.reset();
+    } else if (hilos != getHilos()) {
+        pool = std::make_unique<ThreadPool>(hilos - 1);
+    }
+}
+
+double EmployeeManager::calcularNominaDepartamento(const std::string& departamento) const {
+    const DepartmentIndex::Departamento* dept = indicePorDepartamento.buscar(departamento);
+    return dept ? dept->nomina.valor() : 0.0;
+}
+
+int EmployeeManager::getCantidadEnDepartamento(const std::string& departamento) const {
+    const DepartmentIndex::Departamento* dept = indicePorDepartamento.buscar(departamento);
+    return dept ? dept->cantidad : 0;
+}
+
+kernels::FiltroSalario EmployeeManager::filtroTipo(TipoEmpleado tipo) const {
+    kernels::FiltroSalario filtro;
+    filtro.porTipo = true;
+    filtro.tipo = tipo;
+    return filtro;
+}
+
+kernels::FiltroSalario EmployeeManager::filtroDepartamento(const std::string& departamento) const {
+    // Un departamento desconocido da NINGUNO, que no aparece en la columna
+    kernels::FiltroSalario filtro;
+    filtro.porDepartamento = true;
+    filtro.departamento = indicePorDepartamento.simbolo(departamento);
+    return filtro;
+}
+
+kernels::EstadisticasSalario EmployeeManager::estadisticasSalario(const kernels::FiltroSalario& filtro) const {
+    return kernels::calcularEstadisticas(columnas.vista(), filtro, pool.get());
+}
+
+std::vector<std::size_t> EmployeeManager::histogramaSalarios(int cubetas,
+                                                             const kernels::FiltroSalario& filtro) const {
+    kernels::EstadisticasSalario e = estadisticasSalario(filtro);
+    return kernels::calcularHistograma(columnas.vista(), filtro, e.minimo, e.maximo, cubetas, pool.get());
+}
+
+std::vector<std::pair<std::string, kernels::EstadisticasSalario>>
+EmployeeManager::estadisticasPorDepartamento() const {
+    std::vector<kernels::EstadisticasSalario> porSimbolo = kernels::estadisticasPorGrupo(
+        columnas.vista(), kernels::Agrupacion::PorDepartamento,
+        indicePorDepartamento.cantidadSimbolos(), pool.get());
+
+    std::vector<std::pair<std::string, kernels::EstadisticasSalario>> resultado;
+    for (SymbolTable::Simbolo s = 0; s < porSimbolo.size(); ++s) {
+        if (porSimbolo[s].cantidad > 0) {
+            resultado.emplace_back(std::string(indicePorDepartamento.nombre(s)), porSimbolo[s]);
+        }
+    }
+    std::sort(resultado.begin(), resultado.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    return resultado;
+}
+
+double EmployeeManager::nominaDe(const VersionedStore::Instantanea& version) {
+    kernels::SumaCompensada suma;
+    version.paraCada([&](const VersionedStore::Registro& r) { suma.sumar(r.salarioTotal); });
+    return suma.valor();
+}
+
+std::vector<std::pair<std::string, kernels::EstadisticasSalario>>
+EmployeeManager::estadisticasPorDepartamento(const VersionedStore::Instantanea& version) {
+    // Una pasada (Welford) agrupando por el símbolo global del departamento
+    struct Acumulado {
+        kernels::EstadisticasSalario e;
+        kernels::SumaCompensada suma;
+        double m2 = 0.0;
+    };
+    std::unordered_map<SymbolTable::Simbolo, Acumulado> grupos;
+    version.paraCada([&](const VersionedStore::Registro& r) {
+        Acumulado& a = grupos[r.departamento];
+        const double x = r.salarioTotal;
+        if (a.e.cantidad == 0) {
+            a.e.minimo = x;
+            a.e.maximo = x;
+        } else {
+            a.e.minimo = std::min(a.e.minimo, x);
+            a.e.maximo = std::max(a.e.maximo, x);
+        }
+        ++a.e.cantidad;
+        a.suma.sumar(x);
+        const double delta = x - a.e.media;
+        a.e.media += delta / static_cast<double>(a.e.cantidad);
+        a.m2 += delta * (x - a.e.media);
+    });
+
+    std::vector<std::pair<std::string, kernels::EstadisticasSalario>> resultado;
+    resultado.reserve(grupos.size());
+    for (auto& [simbolo, a] : grupos) {
+        a.e.suma = a.suma.valor();
+        a.e.media = a.e.suma / static_cast<double>(a.e.cantidad);
+        a.e.varianza = a.m2 / static_cast<double>(a.e.cantidad);
+        resultado.emplace_back(std::string(textoSimbolo(simbolo)), a.e);
+    }
+    std::sort(resultado.begin(), resultado.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    return resultado;
+}
+
+std::vector<std::pair<std::string, kernels::EstadisticasSalario>>
+EmployeeManager::estadisticasPorTipo() const {
+    std::vector<kernels::EstadisticasSalario> porTipo = kernels::estadisticasPorGrupo(
+        columnas.vista(), kernels::Agrupacion::PorTipo, 2, pool.get());
+    return {{"Developers", porTipo[static_cast<std::size_t>(TipoEmpleado::Developer)]},
+            {"Managers", porTipo[static_cast<std::size_t>(TipoEmpleado::Manager)]}};
+}
+
+namespace {
+void imprimirFilaEstadisticas(std::string_view etiqueta, const kernels::EstadisticasSalario& e) {
+    std::cout << "  " << std::setw(20) << std::left << etiqueta
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << e.cantidad
+              << std::setw(12) << e.media
+              << std::setw(12) << e.minimo
+              << std::setw(12) << e.maximo
+              << std::setw(12) << std::sqrt(e.varianza) << std::left << "\n";
+}
+}
+
+void EmployeeManager::informeEstadisticas() const {
+    metricas::Temporizador temporizador(metricas::Operacion::Informe);
+    std::cout << "\n═══════════════════════════════════════════════\n";
+    std::cout << "      ESTADÍSTICAS DE SALARIO TOTAL (" << kernels::nombreNivel(kernels::nivelActivo())
+              << ", " << getHilos() << " hilos)\n";
+    std::cout << "═══════════════════════════════════════════════\n";
+    std::cout << "  " << std::setw(20) << std::left << "Grupo" << std::right
+              << std::setw(8) << "Cant." << std::setw(12) << "Media" << std::setw(12) << "Min."
+              << std::setw(12) << "Max." << std::setw(12) << "Desv." << std::left << "\n";
+
+    // Una pasada para los tipos y otra para todos los departamentos
+    for (const auto& [tipo, e] : estadisticasPorTipo()) {
+        imprimirFilaEstadisticas(tipo, e);
+    }
+    for (const auto& [dept, e] : estadisticasPorDepartamento()) {
+        imprimirFilaEstadisticas(dept, e);
+    }
+
+    std::cout << "  Memoria: " << memoriaActualKB() / 1024 << " MiB actual, "
+              << memoriaPicoKB() / 1024 << " MiB pico; "
+              << SymbolTable::global().size() << " textos internados\n";
+    const VersionedStore::Estadisticas v = versiones.estadisticas();
+    std::cout << "  Versiones: " << v.bytesActuales / 1024 << " KiB en " << v.bloques << " bloques, "
+              << v.bytesRetenidos / 1024 << " KiB retenidos por " << v.instantaneasActivas
+              << " fijadas (" << v.copiasEnEscritura << " copias en escritura)\n";
+}
+
+const OrderedIndex& EmployeeManager::indiceOrden(CampoOrden campo) const {
+    switch (campo) {
+        case CampoOrden::Id: return ordenPorId;
+        case CampoOrden::SalarioBase: return ordenPorSalarioBase;
+        case CampoOrden::SalarioTotal: break;
+    }
+    return ordenPorSalarioTotal;
+}
+
+EmployeeManager::Rango::Iterador::Iterador(const Rango* rango, OrderedIndex::Iterador actual)
+    : rango(rango), actual(actual) {
+    saltarNoCoincidentes();
+}
+
+EmployeeManager::Rango::Iterador& EmployeeManager::Rango::Iterador::operator++() {
+    ++actual;
+    saltarNoCoincidentes();
+    return *this;
+}
+
+void EmployeeManager::Rango::Iterador::saltarNoCoincidentes() {
+    const EmployeeManager& g = *rango->gestor;
+    for (; actual != rango->hasta; ++actual) {
+        posicion = g.indicePorId.buscar(actual->id);
+        if (!rango->porDepartamento || g.columnas.getDepartamentos()[posicion] == rango->departamento) return;
+    }
+}
+
+std::size_t EmployeeManager::Rango::contar() const {
+    // Sin filtro basta con recorrer el índice, sin buscar cada empleado
+    if (!porDepartamento) return static_cast<std::size_t>(std::distance(desde, hasta));
+    return static_cast<std::size_t>(std::distance(begin(), end()));
+}
+
+EmployeeManager::Rango EmployeeManager::rango(CampoOrden campo, double desde, double hasta,
+                                              std::string_view departamento) const {
+    metricas::Temporizador temporizador(metricas::Operacion::Informe);
+    const OrderedIndex& indice = indiceOrden(campo);
+    Rango r;
+    r.gestor = this;
+    r.desde = indice.primeroNoMenor(desde);
+    r.hasta = desde <= hasta ? indice.primeroMayor(hasta) : r.desde;
+    if (!departamento.empty()) {
+        r.porDepartamento = true;
+        r.departamento = indicePorDepartamento.simbolo(departamento);
+        if (r.departamento == SymbolTable::NINGUNO) r.hasta = r.desde;
     }
-    return total;
+    return r;
+}
+
+std::vector<const Employee*> EmployeeManager::topK(std::size_t k, CampoOrden campo,
+                                                   std::string_view departamento) const {
+    metricas::Temporizador temporizador(metricas::Operacion::Informe);
+    std::vector<const Employee*> resultado;
+    if (k == 0) return resultado;
+
+    uint32_t dept = 0;
+    if (!departamento.empty()) {
+        dept = indicePorDepartamento.simbolo(departamento);
+        if (dept == SymbolTable::NINGUNO) return resultado;
+
+        // Un departamento pequeño se resuelve con selección parcial sobre sus
+        // miembros; recorrer el índice entero saltaría casi todo
+        const DepartmentIndex::Departamento& d = indicePorDepartamento.porSimbolo(dept);
+        if (static_cast<std::size_t>(d.cantidad) * 8 < empleados.size()) {
+            auto clave = [campo](const Employee* e) -> OrderedIndex::Entrada {
+                switch (campo) {
+                    case CampoOrden::Id: return {static_cast<double>(e->getId()), e->getId()};
+                    case CampoOrden::SalarioBase: return {e->getSalarioBase(), e->getId()};
+                    case CampoOrden::SalarioTotal: break;
+                }
+                return {e->calcularSalarioTotal(), e->getId()};
+            };
+            resultado.reserve(d.miembros.size());
+            for (int id : d.miembros) resultado.push_back(buscarPorId(id));
+            k = std::min(k, resultado.size());
+            std::partial_sort(resultado.begin(), resultado.begin() + k, resultado.end(),
+                              [&](const Employee* a, const Employee* b) { return clave(b) < clave(a); });
+            resultado.resize(k);
+            return resultado;
+        }
+    }
+
+    // Desde el final del índice hacia atrás: O(k) sin filtro
+    const OrderedIndex& indice = indiceOrden(campo);
+    resultado.reserve(std::min(k, indice.size()));
+    for (auto it = indice.end(); it != indice.begin() && resultado.size() < k;) {
+        --it;
+        std::size_t pos = indicePorId.buscar(it->id);
+        if (departamento.empty() || columnas.getDepartamentos()[pos] == dept) {
+            resultado.push_back(empleados[pos].get());
+        }
+    }
+    return resultado;
+}
+
+bool EmployeeManager::buscarPorLenguajes(std::string_view expresion, RoaringBitmap& ids,
+                                         std::string& error) const {
+    metricas::Temporizador temporizador(metricas::Operacion::Busqueda);
+    return indicePorLenguaje.evaluar(expresion, ids, error);
+}
+
+std::vector<const Employee*> EmployeeManager::buscarPorPrefijo(std::string_view consulta,
+                                                              std::size_t limite) const {
+    metricas::Temporizador temporizador(metricas::Operacion::Busqueda);
+    std::vector<const Employee*> resultado;
+    for (int id : indicePorNombre.buscarPrefijo(consulta, limite)) resultado.push_back(buscarPorId(id));
+    if (resultado.empty()) metricas::contar(metricas::Evento::BusquedasFallidas);
+    return resultado;
+}
+
+std::vector<std::pair<const Employee*, double>> EmployeeManager::buscarPorNombre(std::string_view consulta,
+                                                                                 std::size_t limite) const {
+    metricas::Temporizador temporizador(metricas::Operacion::Busqueda);
+    std::vector<std::pair<const Employee*, double>> resultado;
+    for (const NameIndex::Coincidencia& c : indicePorNombre.buscarAproximado(consulta, limite)) {
+        resultado.push_back({buscarPorId(c.id), c.puntuacion});
+    }
+    if (resultado.empty()) metricas::contar(metricas::Evento::BusquedasFallidas);
+    return resultado;
+}
+
+uint64_t EmployeeManager::contarLenguaje(std::string_view lenguaje, std::string_view departamento) const {
+    if (departamento.empty()) return indicePorLenguaje.contar(lenguaje);
+    SymbolTable::Simbolo dept = indicePorDepartamento.simbolo(departamento);
+    return dept == SymbolTable::NINGUNO ? 0 : indicePorLenguaje.contar(lenguaje, dept);
+}
+
+std::vector<std::pair<std::string, uint64_t>> EmployeeManager::conteoLenguajes(std::string_view departamento) const {
+    metricas::Temporizador temporizador(metricas::Operacion::Informe);
+    if (departamento.empty()) return indicePorLenguaje.conteos();
+    SymbolTable::Simbolo dept = indicePorDepartamento.simbolo(departamento);
+    if (dept == SymbolTable::NINGUNO) return {};
+    return indicePorLenguaje.conteos(dept);
 }
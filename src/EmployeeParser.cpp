@@ -0,0 +1,210 @@
+#include "EmployeeParser.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <type_traits>
+
+namespace {
+
+constexpr std::size_t CAMPOS_POR_REGISTRO = 8;
+constexpr std::size_t CAMPOS_CON_JEFE = 9;   // el ID del jefe es opcional, al final
+constexpr std::size_t BYTES_MINIMOS_POR_TROZO = 1 << 20;
+
+// Separa la línea por '|' en vistas; devuelve cuántos campos hay
+std::size_t separarCampos(std::string_view linea, std::string_view* campos, std::size_t maximo) {
+    std::size_t n = 0;
+    while (true) {
+        std::size_t barra = linea.find('|');
+        if (n < maximo) campos[n] = linea.substr(0, barra);
+        ++n;
+        if (barra == std::string_view::npos) return n;
+        linea.remove_prefix(barra + 1);
+    }
+}
+
+template <typename T>
+bool leerNumero(std::string_view campo, T& valor) {
+    const char* fin = campo.data() + campo.size();
+    auto [ptr, ec] = std::from_chars(campo.data(), fin, valor);
+    if (ec != std::errc() || ptr != fin) return false;
+    // from_chars acepta "nan" e "inf", que no son importes válidos
+    if constexpr (std::is_floating_point_v<T>) return std::isfinite(valor);
+    return true;
+}
+
+// Analiza [inicio, fin) del texto; 'fin' siempre cae justo después de un '\n' o al final
+void analizarTrozo(std::string_view texto, ResultadoAnalisis& resultado, std::size_t& lineas) {
+    RegistroTexto registro;
+    std::string motivo;
+    lineas = 0;
+
+    while (!texto.empty()) {
+        std::size_t salto = texto.find('\n');
+        std::string_view linea = texto.substr(0, salto);
+        texto.remove_prefix(salto == std::string_view::npos ? texto.size() : salto + 1);
+        ++lineas;
+
+        if (!linea.empty() && linea.back() == '\r') linea.remove_suffix(1);
+        if (linea.empty()) continue;
+
+        if (analizarLinea(linea, registro, motivo)) {
+            registro.linea = lineas;
+            resultado.registros.push_back(registro);
+        } else {
+            resultado.errores.push_back({lineas, motivo});
+        }
+    }
+}
+
+} // namespace
+
+bool analizarLinea(std::string_view linea, RegistroTexto& r, std::string& motivo) {
+    std::string_view campos[CAMPOS_CON_JEFE];
+    std::size_t n = separarCampos(linea, campos, CAMPOS_CON_JEFE);
+
+    if (campos[0] == "DEV") {
+        r.tipo = TipoEmpleado::Developer;
+    } else if (campos[0] == "MGR") {
+        r.tipo = TipoEmpleado::Manager;
+    } else {
+        motivo = "tipo desconocido '" + std::string(campos[0]) + "'";
+        return false;
+    }
+
+    if (n != CAMPOS_POR_REGISTRO && n != CAMPOS_CON_JEFE) {
+        motivo = "se esperaban " + std::to_string(CAMPOS_POR_REGISTRO) + " o " +
+                 std::to_string(CAMPOS_CON_JEFE) + " campos y hay " + std::to_string(n);
+        return false;
+    }
+    if (!leerNumero(campos[1], r.id)) {
+        motivo = "ID inválido '" + std::string(campos[1]) + "'";
+        return false;
+    }
+    if (!leerNumero(campos[4], r.salarioBase)) {
+        motivo = "salario base inválido '" + std::string(campos[4]) + "'";
+        return false;
+    }
+
+    r.nombre = campos[2];
+    r.apellido = campos[3];
+    r.departamento = campos[5];
+    r.equipo = 0;
+    r.jefe = 0;
+    r.lenguajes = std::string_view();
+    if (n == CAMPOS_CON_JEFE && (!leerNumero(campos[8], r.jefe) || r.jefe < 0)) {
+        motivo = "jefe inválido '" + std::string(campos[8]) + "'";
+        return false;
+    }
+
+    if (r.tipo == TipoEmpleado::Developer) {
+        if (!leerNumero(campos[6], r.bonus)) {
+            motivo = "bonus inválido '" + std::string(campos[6]) + "'";
+            return false;
+        }
+        r.lenguajes = campos[7];
+    } else {
+        if (!leerNumero(campos[6], r.equipo)) {
+            motivo = "equipo inválido '" + std::string(campos[6]) + "'";
+            return false;
+        }
+        if (!leerNumero(campos[7], r.bonus)) {
+            motivo = "bonus inválido '" + std::string(campos[7]) + "'";
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace {
+
+template <typename T>
+void anadirNumero(std::string& destino, T valor) {
+    char buffer[32];
+    auto [fin, ec] = std::to_chars(buffer, buffer + sizeof(buffer), valor);
+    destino.append(buffer, ec == std::errc() ? fin : buffer);
+}
+
+} // namespace
+
+void formatearRegistro(const RegistroTexto& r, std::string& destino) {
+    const bool esDeveloper = r.tipo == TipoEmpleado::Developer;
+    destino += esDeveloper ? "DEV|" : "MGR|";
+    anadirNumero(destino, r.id);
+    destino += '|';
+    destino += r.nombre;
+    destino += '|';
+    destino += r.apellido;
+    destino += '|';
+    anadirNumero(destino, r.salarioBase);
+    destino += '|';
+    destino += r.departamento;
+    destino += '|';
+    if (esDeveloper) {
+        anadirNumero(destino, r.bonus);
+        destino += '|';
+        destino += r.lenguajes;
+    } else {
+        anadirNumero(destino, r.equipo);
+        destino += '|';
+        anadirNumero(destino, r.bonus);
+    }
+    if (r.jefe != 0) {
+        destino += '|';
+        anadirNumero(destino, r.jefe);
+    }
+}
+
+ResultadoAnalisis analizarEmpleados(std::string_view texto, ThreadPool* pool) {
+    // Cortes aproximados, desplazados hasta el siguiente '\n' para no partir líneas
+    std::size_t trozos = 1;
+    if (pool) {
+        trozos = std::min<std::size_t>((pool->getTrabajadores() + 1) * 4,
+                                       std::max<std::size_t>(1, texto.size() / BYTES_MINIMOS_POR_TROZO));
+    }
+
+    std::vector<std::size_t> cortes{0};
+    for (std::size_t t = 1; t < trozos; ++t) {
+        std::size_t corte = std::max(cortes.back(), texto.size() * t / trozos);
+        std::size_t salto = texto.find('\n', corte);
+        corte = (salto == std::string_view::npos) ? texto.size() : salto + 1;
+        if (corte > cortes.back()) cortes.push_back(corte);
+    }
+    if (cortes.back() != texto.size() || cortes.size() == 1) cortes.push_back(texto.size());
+    trozos = cortes.size() - 1;
+
+    std::vector<ResultadoAnalisis> parciales(trozos);
+    std::vector<std::size_t> lineas(trozos, 0);
+    auto analizar = [&](std::size_t t) {
+        analizarTrozo(texto.substr(cortes[t], cortes[t + 1] - cortes[t]), parciales[t], lineas[t]);
+    };
+    if (trozos == 1 || !pool) {
+        for (std::size_t t = 0; t < trozos; ++t) analizar(t);
+    } else {
+        pool->ejecutar(trozos, analizar);
+    }
+
+    if (trozos == 1) return std::move(parciales[0]);
+
+    // Concatenación en orden, pasando los números de línea a absolutos
+    ResultadoAnalisis resultado;
+    std::size_t totalRegistros = 0;
+    for (const ResultadoAnalisis& p : parciales) totalRegistros += p.registros.size();
+    resultado.registros.reserve(totalRegistros);
+
+    // Cada parcial se libera nada más copiarlo, así el pico no llega al doble
+    std::size_t desplazamiento = 0;
+    for (std::size_t t = 0; t < trozos; ++t) {
+        for (RegistroTexto& r : parciales[t].registros) {
+            r.linea += desplazamiento;
+            resultado.registros.push_back(r);
+        }
+        std::vector<RegistroTexto>().swap(parciales[t].registros);
+        for (ErrorLinea& e : parciales[t].errores) {
+            e.linea += desplazamiento;
+            resultado.errores.push_back(std::move(e));
+        }
+        desplazamiento += lineas[t];
+    }
+    return resultado;
+}
@@ -0,0 +1,96 @@
+#include "IdIndex.h"
+
+namespace {
+constexpr std::size_t CAPACIDAD_MINIMA = 16;
+
+// Factor de carga máximo: 7/10
+bool excedeCarga(std::size_t ocupadas, std::size_t capacidad) {
+    return ocupadas * 10 >= capacidad * 7;
+}
+}
+
+IdIndex::IdIndex()
+    : tabla(CAPACIDAD_MINIMA, Entrada{0, VACIA}), mascara(CAPACIDAD_MINIMA - 1), ocupadas(0) {}
+
+std::size_t IdIndex::celdaInicial(int id) const {
+    // Hash de Fibonacci: dispersa bien IDs consecutivos
+    uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<std::size_t>(h >> 32) & mascara;
+}
+
+std::size_t IdIndex::buscar(int id) const {
+    for (std::size_t i = celdaInicial(id);; i = (i + 1) & mascara) {
+        const Entrada& e = tabla[i];
+        if (e.posicion == VACIA) return NO_ENCONTRADO;
+        if (e.id == id) return e.posicion;
+    }
+}
+
+void IdIndex::insertar(int id, std::size_t posicion) {
+    for (std::size_t i = celdaInicial(id);; i = (i + 1) & mascara) {
+        Entrada& e = tabla[i];
+        if (e.posicion == VACIA) {
+            // Solo crece si de verdad se ocupa una celda más, no al actualizar
+            if (excedeCarga(ocupadas + 1, tabla.size())) {
+                redimensionar(tabla.size() * 2);
+                insertar(id, posicion);
+                return;
+            }
+            e = Entrada{id, static_cast<uint32_t>(posicion)};
+            ++ocupadas;
+            return;
+        }
+        if (e.id == id) {
+            e.posicion = static_cast<uint32_t>(posicion);
+            return;
+        }
+    }
+}
+
+bool IdIndex::eliminar(int id) {
+    std::size_t i = celdaInicial(id);
+    while (true) {
+        if (tabla[i].posicion == VACIA) return false;
+        if (tabla[i].id == id) break;
+        i = (i + 1) & mascara;
+    }
+
+    // Desplazamiento hacia atrás: se rellena el hueco con las entradas
+    // posteriores del grupo cuya celda ideal no queda "detrás" del hueco
+    std::size_t hueco = i;
+    for (std::size_t j = (hueco + 1) & mascara; tabla[j].posicion != VACIA; j = (j + 1) & mascara) {
+        std::size_t ideal = celdaInicial(tabla[j].id);
+        bool puedeMoverse = (hueco <= j) ? (ideal <= hueco || ideal > j)
+                                         : (ideal <= hueco && ideal > j);
+        if (puedeMoverse) {
+            tabla[hueco] = tabla[j];
+            hueco = j;
+        }
+    }
+    tabla[hueco].posicion = VACIA;
+    --ocupadas;
+    return true;
+}
+
+void IdIndex::reservar(std::size_t cantidad) {
+    std::size_t capacidad = tabla.size();
+    while (excedeCarga(cantidad, capacidad)) capacidad *= 2;
+    if (capacidad != tabla.size()) redimensionar(capacidad);
+}
+
+void IdIndex::limpiar() {
+    tabla.assign(CAPACIDAD_MINIMA, Entrada{0, VACIA});
+    mascara = CAPACIDAD_MINIMA - 1;
+    ocupadas = 0;
+}
+
+void IdIndex::redimensionar(std::size_t nuevaCapacidad) {
+    std::vector<Entrada> anterior(nuevaCapacidad, Entrada{0, VACIA});
+    anterior.swap(tabla);
+    mascara = nuevaCapacidad - 1;
+    ocupadas = 0;
+
+    for (const Entrada& e : anterior) {
+        if (e.posicion != VACIA) insertar(e.id, e.posicion);
+    }
+}
@@ -0,0 +1,189 @@
+#include "LanguageIndex.h"
+#include <algorithm>
+
+namespace {
+
+const RoaringBitmap VACIO;
+
+// Un factor de la expresión: un mapa del índice (sin copiar) o uno calculado,
+// quizá negado. La negación se resuelve al combinar el término.
+struct Operando {
+    const RoaringBitmap* referencia = nullptr;
+    RoaringBitmap propio;
+    bool negado = false;
+
+    const RoaringBitmap& valor() const { return referencia ? *referencia : propio; }
+};
+
+bool esOperador(char c) {
+    return c == '&' || c == '|' || c == '!' || c == '(' || c == ')';
+}
+
+} // namespace
+
+class LanguageIndex::Analizador {
+public:
+    Analizador(const LanguageIndex& indice, std::string_view texto) : indice(indice), texto(texto) {}
+
+    bool analizar(RoaringBitmap& resultado, std::string& error) {
+        resultado = expresion();
+        saltarEspacios();
+        if (this->error.empty() && pos < texto.size()) fallar("carácter inesperado '" + std::string(1, texto[pos]) + "'");
+        error = this->error;
+        return error.empty();
+    }
+
+private:
+    const LanguageIndex& indice;
+    std::string_view texto;
+    std::size_t pos = 0;
+    std::string error;
+
+    void saltarEspacios() {
+        while (pos < texto.size() && (texto[pos] == ' ' || texto[pos] == '\t')) ++pos;
+    }
+
+    bool consumir(char c) {
+        saltarEspacios();
+        if (pos < texto.size() && texto[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    void fallar(std::string motivo) {
+        if (error.empty()) error = motivo + " (posición " + std::to_string(pos + 1) + ")";
+    }
+
+    // expresion := termino ('|' termino)*
+    RoaringBitmap expresion() {
+        RoaringBitmap resultado = termino();
+        while (error.empty() && consumir('|')) {
+            resultado = RoaringBitmap::unir(resultado, termino());
+        }
+        return resultado;
+    }
+
+    // termino := factor ('&' factor)*
+    RoaringBitmap termino() {
+        std::vector<Operando> positivos;
+        std::vector<Operando> negativos;
+        do {
+            Operando o = factor();
+            (o.negado ? negativos : positivos).push_back(std::move(o));
+        } while (error.empty() && consumir('&'));
+        if (!error.empty()) return {};
+
+        // Intersección de menor a mayor: los resultados parciales se achican pronto
+        std::sort(positivos.begin(), positivos.end(), [](const Operando& a, const Operando& b) {
+            return a.valor().cardinalidad() < b.valor().cardinalidad();
+        });
+        RoaringBitmap resultado = positivos.empty() ? indice.todos : positivos[0].valor();
+        for (std::size_t i = 1; i < positivos.size() && !resultado.empty(); ++i) {
+            resultado = RoaringBitmap::interseccion(resultado, positivos[i].valor());
+        }
+        for (const Operando& o : negativos) {
+            if (resultado.empty()) break;
+            resultado = RoaringBitmap::diferencia(resultado, o.valor());
+        }
+        return resultado;
+    }
+
+    // factor := '!' factor | '(' expresion ')' | lenguaje
+    Operando factor() {
+        if (consumir('!')) {
+            Operando o = factor();
+            o.negado = !o.negado;
+            return o;
+        }
+        Operando o;
+        if (consumir('(')) {
+            o.propio = expresion();
+            if (error.empty() && !consumir(')')) fallar("falta ')'");
+            return o;
+        }
+
+        saltarEspacios();
+        std::size_t inicio = pos;
+        while (pos < texto.size() && !esOperador(texto[pos])) ++pos;
+        std::string_view nombre = texto.substr(inicio, pos - inicio);
+        while (!nombre.empty() && (nombre.back() == ' ' || nombre.back() == '\t')) nombre.remove_suffix(1);
+        if (nombre.empty()) {
+            fallar("se esperaba un lenguaje");
+            o.referencia = &VACIO;
+            return o;
+        }
+        const RoaringBitmap* mapa = indice.lenguaje(nombre);
+        o.referencia = mapa ? mapa : &VACIO;
+        return o;
+    }
+};
+
+RoaringBitmap& LanguageIndex::departamento(Simbolo simbolo) {
+    if (simbolo >= porDepartamento.size()) porDepartamento.resize(simbolo + 1);
+    return porDepartamento[simbolo];
+}
+
+const RoaringBitmap* LanguageIndex::lenguaje(std::string_view nombre) const {
+    Simbolo s = SymbolTable::global().buscar(nombre);
+    return s < porLenguaje.size() ? &porLenguaje[s] : nullptr;
+}
+
+void LanguageIndex::agregarEmpleado(int id, const std::vector<Simbolo>& lenguajes, Simbolo dept) {
+    const uint32_t valor = static_cast<uint32_t>(id);
+    todos.agregar(valor);
+    departamento(dept).agregar(valor);
+    for (Simbolo lang : lenguajes) agregarLenguaje(id, lang);
+}
+
+void LanguageIndex::quitarEmpleado(int id, const std::vector<Simbolo>& lenguajes, Simbolo dept) {
+    const uint32_t valor = static_cast<uint32_t>(id);
+    todos.quitar(valor);
+    departamento(dept).quitar(valor);
+    for (Simbolo lang : lenguajes) {
+        if (lang < porLenguaje.size()) porLenguaje[lang].quitar(valor);
+    }
+}
+
+void LanguageIndex::agregarLenguaje(int id, Simbolo lang) {
+    if (textoSimbolo(lang).empty()) return;
+    if (lang >= porLenguaje.size()) porLenguaje.resize(lang + 1);
+    porLenguaje[lang].agregar(static_cast<uint32_t>(id));
+}
+
+void LanguageIndex::cambiarDepartamento(int id, Simbolo anterior, Simbolo nuevo) {
+    departamento(anterior).quitar(static_cast<uint32_t>(id));
+    departamento(nuevo).agregar(static_cast<uint32_t>(id));
+}
+
+bool LanguageIndex::evaluar(std::string_view expresion, RoaringBitmap& resultado, std::string& error) const {
+    return Analizador(*this, expresion).analizar(resultado, error);
+}
+
+uint64_t LanguageIndex::contar(std::string_view nombre, Simbolo dept) const {
+    const RoaringBitmap* mapa = lenguaje(nombre);
+    return mapa ? contar(*mapa, dept) : 0;
+}
+
+uint64_t LanguageIndex::contar(const RoaringBitmap& mapa, Simbolo dept) const {
+    if (dept == SymbolTable::NINGUNO) return mapa.cardinalidad();
+    return dept < porDepartamento.size() ? RoaringBitmap::cardinalidadInterseccion(mapa, porDepartamento[dept]) : 0;
+}
+
+std::vector<std::pair<std::string, uint64_t>> LanguageIndex::conteos(Simbolo dept) const {
+    std::vector<std::pair<std::string, uint64_t>> resultado;
+    for (Simbolo s = 0; s < porLenguaje.size(); ++s) {
+        uint64_t n = contar(porLenguaje[s], dept);
+        if (n > 0) resultado.emplace_back(std::string(textoSimbolo(s)), n);
+    }
+    std::sort(resultado.begin(), resultado.end());
+    return resultado;
+}
+
+std::size_t LanguageIndex::bytesUsados() const {
+    std::size_t total = todos.bytesUsados();
+    for (const RoaringBitmap& m : porLenguaje) total += m.bytesUsados();
+    for (const RoaringBitmap& m : porDepartamento) total += m.bytesUsados();
+    return total;
+}
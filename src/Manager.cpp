@@ -1,18 +1,24 @@
 #include "Manager.h"
-#include <sstream>
+#include "EmployeeParser.h"
 #include <iomanip>
 
-Manager::Manager(int id, const std::string& nombre, const std::string& apellido,
-                 double salarioBase, const std::string& departamento,
+Manager::Manager(int id, std::string_view nombre, std::string_view apellido,
+                 double salarioBase, std::string_view departamento,
                  int equipoACargo, double bonusGestion)
     : Employee(id, nombre, apellido, salarioBase, departamento),
-      equipoACargo(equipoACargo), bonusGestion(bonusGestion) {}
+      equipoACargo(equipoACargo), bonusGestion(bonusGestion) {
+    salarioTotal = recalcularSalarioTotal();
+}
 
-double Manager::calcularSalarioTotal() const {
+double Manager::recalcularSalarioTotal() const {
     // Salario base + bonus de gestión + bonus por cada persona en el equipo
     return salarioBase + bonusGestion + (equipoACargo * 300.0);
 }
 
+ComponentesSalario Manager::getComponentesSalario() const {
+    return {TipoEmpleado::Manager, salarioBase, bonusGestion, 0, equipoACargo};
+}
+
 void Manager::mostrarInfo() const {
     Employee::mostrarInfo();
     std::cout << "│ Equipo a Cargo: " << std::setw(24) << std::left << equipoACargo << "│\n";
@@ -21,9 +27,20 @@ void Manager::mostrarInfo() const {
 }
 
 std::string Manager::serializar() const {
-    std::ostringstream oss;
-    oss << "MGR|" << id << "|" << nombre << "|" << apellido << "|"
-        << salarioBase << "|" << departamento << "|" << equipoACargo << "|"
-        << bonusGestion;
-    return oss.str();
+    std::string linea;
+    formatearRegistro({TipoEmpleado::Manager, id, getNombre(), getApellido(), salarioBase,
+                       getDepartamento(), bonusGestion, equipoACargo, jefe, {}, 0}, linea);
+    return linea;
+}
+
+void Manager::setEquipoACargo(int equipo) {
+    double anterior = calcularSalarioTotal();
+    equipoACargo = equipo;
+    notificarCambioSalario(anterior);
+}
+
+void Manager::setBonusGestion(double bonus) {
+    double anterior = calcularSalarioTotal();
+    bonusGestion = bonus;
+    notificarCambioSalario(anterior);
 }
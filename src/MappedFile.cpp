@@ -0,0 +1,60 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& ruta) {
+    std::ifstream archivo(ruta, std::ios::binary);
+    if (!archivo.is_open()) return;
+
+    copia.assign(std::istreambuf_iterator<char>(archivo), std::istreambuf_iterator<char>());
+    datos = copia.data();
+    tamano = copia.size();
+    estaAbierto = true;
+}
+
+MappedFile::~MappedFile() = default;
+
+#else
+
+MappedFile::MappedFile(const std::string& ruta) {
+    int fd = ::open(ruta.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0) {
+        tamano = static_cast<std::size_t>(info.st_size);
+        estaAbierto = true;
+
+        // mmap no admite longitud 0: un archivo vacío queda abierto y sin datos
+        if (tamano > 0) {
+            void* p = ::mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                estaAbierto = false;
+                tamano = 0;
+            } else {
+                ::madvise(p, tamano, MADV_SEQUENTIAL);
+                datos = static_cast<const char*>(p);
+                proyectado = true;
+            }
+        }
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (proyectado) {
+        ::munmap(const_cast<char*>(datos), tamano);
+    }
+}
+
+#endif
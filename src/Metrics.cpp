@@ -0,0 +1,367 @@
+#include "Metrics.h"
+#include "ProcessStats.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace metricas {
+
+const char* nombreOperacion(Operacion operacion) {
+    static const char* const NOMBRES[] = {
+        "carga", "guardado", "busqueda", "alta", "alta_lote", "baja", "cambio_salario",
+        "nomina", "informe", "reproduccion_diario", "compactacion",
+        "cambio_masivo", "cambio_jefe", "cambio_departamento", "cambio_lenguajes",
+    };
+    static_assert(sizeof(NOMBRES) / sizeof(NOMBRES[0]) == static_cast<std::size_t>(Operacion::CANTIDAD),
+                  "falta el nombre de alguna operación");
+    return NOMBRES[static_cast<std::size_t>(operacion)];
+}
+
+const char* nombreEvento(Evento evento) {
+    static const char* const NOMBRES[] = {
+        "filas_cargadas", "lineas_ignoradas", "busquedas_fallidas", "empleados_alta",
+        "cambios_reaplicados", "compactaciones",
+    };
+    static_assert(sizeof(NOMBRES) / sizeof(NOMBRES[0]) == static_cast<std::size_t>(Evento::CANTIDAD),
+                  "falta el nombre de algún evento");
+    return NOMBRES[static_cast<std::size_t>(evento)];
+}
+
+Formato formatoPorRuta(const std::string& ruta) {
+    const std::string ext = ".json";
+    bool json = ruta.size() >= ext.size() && ruta.compare(ruta.size() - ext.size(), ext.size(), ext) == 0;
+    return json ? Formato::Json : Formato::Prometheus;
+}
+
+bool volcar(const std::string& destino, Formato formato, std::string& error) {
+    if (destino == "-") {
+        escribir(std::cout, formato);
+        std::cout.flush();
+        return true;
+    }
+    std::ofstream archivo(destino);
+    if (!archivo.is_open()) {
+        error = "no se pudo crear " + destino;
+        return false;
+    }
+    escribir(archivo, formato);
+    if (!archivo) {
+        error = "error al escribir " + destino;
+        return false;
+    }
+    return true;
+}
+
+} // namespace metricas
+
+#ifndef SIN_METRICAS
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+namespace metricas {
+namespace {
+
+constexpr unsigned BITS_SUBCUBETA = 5;
+constexpr uint64_t SUBCUBETAS = uint64_t(1) << BITS_SUBCUBETA;        // 32 por potencia de dos
+constexpr unsigned BITS_MAXIMO = 40;                                  // ~18 minutos en ns
+constexpr uint64_t VALOR_MAXIMO = (uint64_t(1) << BITS_MAXIMO) - 1;
+constexpr std::size_t CUBETAS = (BITS_MAXIMO - BITS_SUBCUBETA + 1) * SUBCUBETAS;
+constexpr std::size_t OPERACIONES = static_cast<std::size_t>(Operacion::CANTIDAD);
+constexpr std::size_t EVENTOS = static_cast<std::size_t>(Evento::CANTIDAD);
+constexpr std::size_t FRANJAS = 8;
+
+unsigned bitMasAlto(uint64_t v) {
+#if defined(__GNUC__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(v));
+#else
+    unsigned b = 0;
+    while (v >>= 1) ++b;
+    return b;
+#endif
+}
+
+// Valores < 64 tienen cubeta propia; por encima, cada potencia de dos se
+// divide en 32 cubetas del mismo ancho
+std::size_t cubeta(uint64_t valor) {
+    if (valor > VALOR_MAXIMO) valor = VALOR_MAXIMO;
+    if (valor < 2 * SUBCUBETAS) return static_cast<std::size_t>(valor);
+    unsigned desplazamiento = bitMasAlto(valor) - BITS_SUBCUBETA;
+    return static_cast<std::size_t>((desplazamiento + 1) * SUBCUBETAS + (valor >> desplazamiento) - SUBCUBETAS);
+}
+
+// Mayor valor que cae en la cubeta (el "valor equivalente más alto" de HDR)
+uint64_t limiteSuperior(std::size_t indice) {
+    if (indice < 2 * SUBCUBETAS) return indice;
+    uint64_t desplazamiento = indice / SUBCUBETAS - 1;
+    uint64_t sub = indice % SUBCUBETAS + SUBCUBETAS;
+    return ((sub + 1) << desplazamiento) - 1;
+}
+
+// Todo con inicialización constante: el operador new puede usarlo antes de main
+struct alignas(64) Franja {
+    std::atomic<uint64_t> cubetas[OPERACIONES][CUBETAS];
+    std::atomic<uint64_t> cantidad[OPERACIONES];
+    std::atomic<uint64_t> sumaNs[OPERACIONES];
+    std::atomic<uint64_t> maximoNs[OPERACIONES];
+    std::atomic<uint64_t> asignacionesOperacion[OPERACIONES];
+    std::atomic<uint64_t> eventos[EVENTOS];
+    std::atomic<uint64_t> asignaciones;
+    std::atomic<uint64_t> liberaciones;
+    std::atomic<uint64_t> bytesAsignados;
+};
+
+Franja franjas[FRANJAS];
+std::atomic<unsigned> siguienteFranja{0};
+
+thread_local unsigned franjaHilo = 0;          // 0 = sin asignar
+thread_local uint64_t asignacionesHilo = 0;    // para atribuir asignaciones a operaciones
+thread_local uint32_t llamadasMuestreo = 0;
+
+Franja& franjaActual() {
+    if (franjaHilo == 0) {
+        franjaHilo = 1 + siguienteFranja.fetch_add(1, std::memory_order_relaxed) % FRANJAS;
+    }
+    return franjas[franjaHilo - 1];
+}
+
+void sumar(std::atomic<uint64_t>& contador, uint64_t cantidad) {
+    contador.fetch_add(cantidad, std::memory_order_relaxed);
+}
+
+uint64_t leer(const std::atomic<uint64_t>& contador) {
+    return contador.load(std::memory_order_relaxed);
+}
+
+int64_t ahoraNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+constexpr uint32_t PERIODO_MUESTREO = 64;
+
+// Resumen de una operación sumando todas las franjas
+struct Resumen {
+    std::vector<uint64_t> cubetas = std::vector<uint64_t>(CUBETAS);
+    uint64_t cantidad = 0;
+    uint64_t sumaNs = 0;
+    uint64_t maximoNs = 0;
+    uint64_t asignaciones = 0;
+
+    uint64_t percentil(double q) const {
+        if (cantidad == 0) return 0;
+        uint64_t objetivo = static_cast<uint64_t>(q * static_cast<double>(cantidad) + 0.5);
+        if (objetivo == 0) objetivo = 1;
+        uint64_t acumulado = 0;
+        for (std::size_t i = 0; i < CUBETAS; ++i) {
+            acumulado += cubetas[i];
+            if (acumulado >= objetivo) return std::min(limiteSuperior(i), maximoNs);
+        }
+        return maximoNs;
+    }
+};
+
+Resumen resumir(Operacion operacion) {
+    const std::size_t op = static_cast<std::size_t>(operacion);
+    Resumen r;
+    for (const Franja& f : franjas) {
+        for (std::size_t i = 0; i < CUBETAS; ++i) r.cubetas[i] += leer(f.cubetas[op][i]);
+        r.cantidad += leer(f.cantidad[op]);
+        r.sumaNs += leer(f.sumaNs[op]);
+        r.maximoNs = std::max(r.maximoNs, leer(f.maximoNs[op]));
+        r.asignaciones += leer(f.asignacionesOperacion[op]);
+    }
+    return r;
+}
+
+uint64_t totalEvento(Evento evento) {
+    uint64_t total = 0;
+    for (const Franja& f : franjas) total += leer(f.eventos[static_cast<std::size_t>(evento)]);
+    return total;
+}
+
+struct Memoria {
+    uint64_t asignaciones = 0;
+    uint64_t liberaciones = 0;
+    uint64_t bytesAsignados = 0;
+};
+
+Memoria totalMemoria() {
+    Memoria m;
+    for (const Franja& f : franjas) {
+        m.asignaciones += leer(f.asignaciones);
+        m.liberaciones += leer(f.liberaciones);
+        m.bytesAsignados += leer(f.bytesAsignados);
+    }
+    return m;
+}
+
+const double CUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+const char* const NOMBRES_CUANTILES[] = {"p50", "p90", "p99", "p999"};
+
+void escribirPrometheus(std::ostream& out) {
+    out << "# HELP empleados_operacion_segundos Latencia de las operaciones de EmployeeManager\n"
+        << "# TYPE empleados_operacion_segundos summary\n";
+    std::array<Resumen, OPERACIONES> resumenes;
+    for (std::size_t op = 0; op < OPERACIONES; ++op) {
+        resumenes[op] = resumir(static_cast<Operacion>(op));
+        const Resumen& r = resumenes[op];
+        const char* nombre = nombreOperacion(static_cast<Operacion>(op));
+        for (double q : CUANTILES) {
+            out << "empleados_operacion_segundos{operacion=\"" << nombre << "\",quantile=\"" << q << "\"} "
+                << static_cast<double>(r.percentil(q)) * 1e-9 << "\n";
+        }
+        out << "empleados_operacion_segundos_sum{operacion=\"" << nombre << "\"} "
+            << static_cast<double>(r.sumaNs) * 1e-9 << "\n";
+        out << "empleados_operacion_segundos_count{operacion=\"" << nombre << "\"} " << r.cantidad << "\n";
+    }
+
+    out << "# HELP empleados_operacion_asignaciones_total Asignaciones de memoria hechas dentro de cada operación\n"
+        << "# TYPE empleados_operacion_asignaciones_total counter\n";
+    for (std::size_t op = 0; op < OPERACIONES; ++op) {
+        out << "empleados_operacion_asignaciones_total{operacion=\""
+            << nombreOperacion(static_cast<Operacion>(op)) << "\"} " << resumenes[op].asignaciones << "\n";
+    }
+
+    out << "# HELP empleados_eventos_total Contadores de eventos\n"
+        << "# TYPE empleados_eventos_total counter\n";
+    for (std::size_t e = 0; e < EVENTOS; ++e) {
+        out << "empleados_eventos_total{evento=\"" << nombreEvento(static_cast<Evento>(e)) << "\"} "
+            << totalEvento(static_cast<Evento>(e)) << "\n";
+    }
+
+    Memoria m = totalMemoria();
+    out << "# HELP empleados_asignaciones_total Llamadas al operador new global\n"
+        << "# TYPE empleados_asignaciones_total counter\n"
+        << "empleados_asignaciones_total " << m.asignaciones << "\n"
+        << "# HELP empleados_liberaciones_total Llamadas al operador delete global\n"
+        << "# TYPE empleados_liberaciones_total counter\n"
+        << "empleados_liberaciones_total " << m.liberaciones << "\n"
+        << "# HELP empleados_asignados_bytes_total Bytes pedidos al operador new global\n"
+        << "# TYPE empleados_asignados_bytes_total counter\n"
+        << "empleados_asignados_bytes_total " << m.bytesAsignados << "\n"
+        << "# HELP empleados_memoria_residente_bytes Memoria residente del proceso\n"
+        << "# TYPE empleados_memoria_residente_bytes gauge\n"
+        << "empleados_memoria_residente_bytes " << uint64_t(memoriaActualKB()) * 1024 << "\n"
+        << "# HELP empleados_memoria_residente_pico_bytes Máximo de memoria residente\n"
+        << "# TYPE empleados_memoria_residente_pico_bytes gauge\n"
+        << "empleados_memoria_residente_pico_bytes " << uint64_t(memoriaPicoKB()) * 1024 << "\n";
+}
+
+void escribirJson(std::ostream& out) {
+    out << "{\n  \"activas\": true,\n  \"operaciones\": {";
+    for (std::size_t op = 0; op < OPERACIONES; ++op) {
+        Resumen r = resumir(static_cast<Operacion>(op));
+        out << (op ? ",\n" : "\n") << "    \"" << nombreOperacion(static_cast<Operacion>(op)) << "\": {"
+            << "\"cantidad\": " << r.cantidad << ", \"suma_ns\": " << r.sumaNs
+            << ", \"max_ns\": " << r.maximoNs;
+        for (std::size_t i = 0; i < sizeof(CUANTILES) / sizeof(CUANTILES[0]); ++i) {
+            out << ", \"" << NOMBRES_CUANTILES[i] << "_ns\": " << r.percentil(CUANTILES[i]);
+        }
+        out << ", \"asignaciones\": " << r.asignaciones << "}";
+    }
+    out << "\n  },\n  \"eventos\": {";
+    for (std::size_t e = 0; e < EVENTOS; ++e) {
+        out << (e ? ",\n" : "\n") << "    \"" << nombreEvento(static_cast<Evento>(e)) << "\": "
+            << totalEvento(static_cast<Evento>(e));
+    }
+    Memoria m = totalMemoria();
+    out << "\n  },\n  \"memoria\": {\n"
+        << "    \"asignaciones\": " << m.asignaciones << ",\n"
+        << "    \"liberaciones\": " << m.liberaciones << ",\n"
+        << "    \"bytes_asignados\": " << m.bytesAsignados << ",\n"
+        << "    \"residente_kb\": " << memoriaActualKB() << ",\n"
+        << "    \"pico_kb\": " << memoriaPicoKB() << "\n"
+        << "  }\n}\n";
+}
+
+} // namespace
+
+Temporizador::Temporizador(Operacion operacion, uint32_t peso)
+    : operacion(operacion), peso(peso), inicio(peso ? ahoraNs() : 0), asignacionesInicio(asignacionesHilo) {}
+
+Temporizador Temporizador::muestreado(Operacion operacion) {
+    bool medir = (++llamadasMuestreo % PERIODO_MUESTREO) == 0;
+    return Temporizador(operacion, medir ? PERIODO_MUESTREO : 0);
+}
+
+void Temporizador::detener() {
+    if (peso == 0) return;
+    uint64_t ns = static_cast<uint64_t>(ahoraNs() - inicio);
+    uint64_t asignadas = asignacionesHilo - asignacionesInicio;
+
+    const std::size_t op = static_cast<std::size_t>(operacion);
+    Franja& f = franjaActual();
+    sumar(f.cubetas[op][cubeta(ns)], peso);
+    sumar(f.cantidad[op], peso);
+    sumar(f.sumaNs[op], ns * peso);
+    sumar(f.asignacionesOperacion[op], asignadas * peso);
+    uint64_t maximo = leer(f.maximoNs[op]);
+    while (ns > maximo && !f.maximoNs[op].compare_exchange_weak(maximo, ns, std::memory_order_relaxed)) {
+    }
+    peso = 0;
+}
+
+void contar(Evento evento, uint64_t cantidad) {
+    sumar(franjaActual().eventos[static_cast<std::size_t>(evento)], cantidad);
+}
+
+void escribir(std::ostream& salida, Formato formato) {
+    // std::cout puede venir con std::fixed y 2 decimales del menú
+    std::ios_base::fmtflags banderas = salida.flags(std::ios_base::dec);
+    std::streamsize precision = salida.precision(9);
+    if (formato == Formato::Json) {
+        escribirJson(salida);
+    } else {
+        escribirPrometheus(salida);
+    }
+    salida.flags(banderas);
+    salida.precision(precision);
+}
+
+} // namespace metricas
+
+// Operador new global con recuento: una suma relajada en la franja del hilo
+void* operator new(std::size_t tamano) {
+    metricas::Franja& f = metricas::franjaActual();
+    metricas::sumar(f.asignaciones, 1);
+    metricas::sumar(f.bytesAsignados, tamano);
+    ++metricas::asignacionesHilo;
+    if (tamano == 0) tamano = 1;
+    while (true) {
+        if (void* p = std::malloc(tamano)) return p;
+        std::new_handler manejador = std::get_new_handler();
+        if (!manejador) throw std::bad_alloc();
+        manejador();
+    }
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    metricas::sumar(metricas::franjaActual().liberaciones, 1);
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+#else
+
+namespace metricas {
+
+void escribir(std::ostream& salida, Formato formato) {
+    if (formato == Formato::Json) {
+        salida << "{\"activas\": false}\n";
+    } else {
+        salida << "# Métricas desactivadas al compilar (SIN_METRICAS)\n";
+    }
+}
+
+} // namespace metricas
+
+#endif
@@ -0,0 +1,411 @@
+#include "NameIndex.h"
+#include <algorithm>
+
+namespace {
+
+constexpr std::size_t MAX_RECIENTES = 1024;
+constexpr std::size_t MIN_SIN_EMPLEADOS = 4096;   // no compensa compactar por menos
+constexpr std::size_t MAX_VARIANTES = 8;        // por palabra de la consulta
+constexpr std::size_t MAX_COMBINACIONES = 512;
+
+// U+00C0 a U+00FF (0xC3 seguido de 0x80..0xBF) sin acento; "" (× y ÷) separa palabras
+const char* const LATIN1[64] = {
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+    "d", "n", "o", "o", "o", "o", "o", "",  "o", "u", "u", "u", "u", "y", "th", "ss",
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+    "d", "n", "o", "o", "o", "o", "o", "",  "o", "u", "u", "u", "u", "y", "th", "y",
+};
+
+// Palabras de un texto ya normalizado (separadas por un espacio)
+template <typename Funcion>
+void paraCadaPalabra(std::string_view normalizado, Funcion&& f) {
+    while (!normalizado.empty()) {
+        const std::size_t fin = normalizado.find(' ');
+        f(normalizado.substr(0, fin));
+        if (fin == std::string_view::npos) return;
+        normalizado.remove_prefix(fin + 1);
+    }
+}
+
+std::vector<std::string_view> palabrasDe(std::string_view normalizado) {
+    std::vector<std::string_view> lista;
+    paraCadaPalabra(normalizado, [&](std::string_view palabra) { lista.push_back(palabra); });
+    return lista;
+}
+
+bool empiezaPor(std::string_view texto, std::string_view prefijo) {
+    return texto.size() >= prefijo.size() && texto.compare(0, prefijo.size(), prefijo) == 0;
+}
+
+// Trigramas de "$$palabra$$" (n + 2 para n bytes), empaquetados en 24 bits
+template <typename Funcion>
+void paraCadaTrigrama(std::string_view palabra, Funcion&& f) {
+    auto byte = [&](std::size_t k) -> uint32_t {
+        return k < 2 || k >= palabra.size() + 2 ? '$' : static_cast<unsigned char>(palabra[k - 2]);
+    };
+    for (std::size_t k = 0; k < palabra.size() + 2; ++k) {
+        f((byte(k) << 16) | (byte(k + 1) << 8) | byte(k + 2));
+    }
+}
+
+// Distancia de Damerau (transposiciones de letras vecinas) acotada: si pasa
+// de 'maximo' devuelve maximo + 1. Las filas se reutilizan entre llamadas.
+class Distancia {
+public:
+    std::size_t calcular(std::string_view a, std::string_view b, std::size_t maximo) {
+        const std::size_t m = b.size();
+        if ((a.size() > m ? a.size() - m : m - a.size()) > maximo) return maximo + 1;
+        anterior2.assign(m + 1, 0);
+        anterior.resize(m + 1);
+        actual.resize(m + 1);
+        for (std::size_t j = 0; j <= m; ++j) anterior[j] = j;
+
+        for (std::size_t i = 1; i <= a.size(); ++i) {
+            actual[0] = i;
+            std::size_t minimoFila = i;
+            for (std::size_t j = 1; j <= m; ++j) {
+                const std::size_t coste = a[i - 1] == b[j - 1] ? 0 : 1;
+                std::size_t d = std::min({anterior[j] + 1, actual[j - 1] + 1, anterior[j - 1] + coste});
+                if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                    d = std::min(d, anterior2[j - 2] + 1);
+                }
+                actual[j] = d;
+                minimoFila = std::min(minimoFila, d);
+            }
+            if (minimoFila > maximo) return maximo + 1;
+            std::swap(anterior2, anterior);
+            std::swap(anterior, actual);
+        }
+        return std::min(anterior[m], maximo + 1);
+    }
+
+private:
+    std::vector<std::size_t> anterior2, anterior, actual;
+};
+
+} // namespace
+
+void NameIndex::normalizar(std::string_view texto, std::string& resultado) {
+    bool enPalabra = false;
+    auto anadir = [&](const char* letras, std::size_t n) {
+        if (!enPalabra && !resultado.empty()) resultado += ' ';
+        enPalabra = true;
+        resultado.append(letras, n);
+    };
+
+    for (std::size_t i = 0; i < texto.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(texto[i]);
+        if (c < 0x80) {
+            if (c >= 'A' && c <= 'Z') {
+                const char minuscula = static_cast<char>(c - 'A' + 'a');
+                anadir(&minuscula, 1);
+            } else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+                anadir(&texto[i], 1);
+            } else if (c != '\'') {
+                enPalabra = false;   // "O'Brien" -> "obrien"
+            }
+        } else if (c == 0xC3 && i + 1 < texto.size() && (static_cast<unsigned char>(texto[i + 1]) & 0xC0) == 0x80) {
+            const char* letra = LATIN1[static_cast<unsigned char>(texto[++i]) - 0x80];
+            if (*letra) anadir(letra, std::char_traits<char>::length(letra));
+            else enPalabra = false;
+        } else if (texto.compare(i, 3, "\xE2\x80\x99") == 0) {
+            i += 2;   // apóstrofo tipográfico
+        } else {
+            anadir(&texto[i], 1);   // el resto de UTF-8 se conserva tal cual
+        }
+    }
+}
+
+NameIndex::Simbolo NameIndex::registrarPalabra(std::string_view palabra) {
+    const std::size_t antes = palabras.size();
+    const Simbolo s = palabras.internar(palabra);
+    if (s < antes) {
+        if (empleadosPorPalabra[s].empty()) --sinEmpleados;   // vuelve a usarse
+        return s;
+    }
+
+    empleadosPorPalabra.emplace_back();
+    // Los símbolos crecen, así que cada lista queda en orden sin reordenar
+    paraCadaTrigrama(palabras.texto(s), [&](uint32_t trigrama) {
+        std::vector<Simbolo>& lista = porTrigrama[trigrama];
+        if (lista.empty() || lista.back() != s) lista.push_back(s);
+    });
+
+    if (cargando) {
+        recientes.push_back(s);   // se ordenan en terminarCarga()
+        return s;
+    }
+    auto pos = std::upper_bound(recientes.begin(), recientes.end(), palabras.texto(s),
+                                [this](std::string_view texto, Simbolo otra) { return texto < palabras.texto(otra); });
+    recientes.insert(pos, s);
+    if (recientes.size() > std::max(MAX_RECIENTES, ordenadas.size() / 64)) fundirRecientes();
+    return s;
+}
+
+void NameIndex::fundirRecientes() {
+    std::vector<Simbolo> todas;
+    todas.reserve(ordenadas.size() + recientes.size());
+    std::merge(ordenadas.begin(), ordenadas.end(), recientes.begin(), recientes.end(), std::back_inserter(todas),
+               [this](Simbolo a, Simbolo b) { return palabras.texto(a) < palabras.texto(b); });
+    ordenadas.swap(todas);
+    recientes.clear();
+}
+
+void NameIndex::compactar() {
+    // Se renumeran las vivas conservando el orden de sus símbolos: las listas
+    // de trigramas siguen en orden de símbolo y 'ordenadas' y 'recientes',
+    // que no cambian de texto, siguen en orden alfabético
+    std::vector<Simbolo> nuevo(palabras.size(), StringInterner::NINGUNO);
+    StringInterner vivas;
+    std::vector<RoaringBitmap> mapas;
+    for (Simbolo s = 0; s < palabras.size(); ++s) {
+        if (empleadosPorPalabra[s].empty()) continue;
+        nuevo[s] = vivas.internar(palabras.texto(s));
+        mapas.push_back(std::move(empleadosPorPalabra[s]));
+    }
+
+    auto renumerar = [&](std::vector<Simbolo>& lista) {
+        std::size_t n = 0;
+        for (Simbolo s : lista) {
+            if (nuevo[s] != StringInterner::NINGUNO) lista[n++] = nuevo[s];
+        }
+        lista.resize(n);
+    };
+    for (auto it = porTrigrama.begin(); it != porTrigrama.end();) {
+        renumerar(it->second);
+        it = it->second.empty() ? porTrigrama.erase(it) : std::next(it);
+    }
+    renumerar(ordenadas);
+    renumerar(recientes);
+
+    palabras = std::move(vivas);
+    empleadosPorPalabra = std::move(mapas);
+    sinEmpleados = 0;
+}
+
+void NameIndex::empezarCarga() {
+    cargando = true;
+}
+
+void NameIndex::terminarCarga() {
+    std::sort(recientes.begin(), recientes.end(),
+              [this](Simbolo a, Simbolo b) { return palabras.texto(a) < palabras.texto(b); });
+    fundirRecientes();
+    cargando = false;
+}
+
+void NameIndex::agregarEmpleado(int id, std::string_view nombre, std::string_view apellido) {
+    temporal.clear();
+    normalizar(nombre, temporal);
+    normalizar(apellido, temporal);
+    paraCadaPalabra(temporal, [&](std::string_view palabra) {
+        empleadosPorPalabra[registrarPalabra(palabra)].agregar(static_cast<uint32_t>(id));
+    });
+}
+
+void NameIndex::quitarEmpleado(int id, std::string_view nombre, std::string_view apellido) {
+    // Sin IDs la palabra no aparece en los resultados; se descarta al compactar
+    temporal.clear();
+    normalizar(nombre, temporal);
+    normalizar(apellido, temporal);
+    paraCadaPalabra(temporal, [&](std::string_view palabra) {
+        const Simbolo s = palabras.buscar(palabra);
+        if (s == StringInterner::NINGUNO || empleadosPorPalabra[s].empty()) return;
+        empleadosPorPalabra[s].quitar(static_cast<uint32_t>(id));
+        if (empleadosPorPalabra[s].empty()) ++sinEmpleados;
+    });
+    if (sinEmpleados > std::max(MIN_SIN_EMPLEADOS, palabras.size() / 2)) compactar();
+}
+
+template <typename Funcion>
+void NameIndex::paraCadaConPrefijo(std::string_view prefijo, Funcion&& f) const {
+    auto menor = [this](Simbolo s, std::string_view texto) { return palabras.texto(s) < texto; };
+    auto a = std::lower_bound(ordenadas.begin(), ordenadas.end(), prefijo, menor);
+    auto b = std::lower_bound(recientes.begin(), recientes.end(), prefijo, menor);
+
+    // Mezcla de los dos arreglos mientras sigan empezando por el prefijo
+    while (true) {
+        const bool hayA = a != ordenadas.end() && empiezaPor(palabras.texto(*a), prefijo);
+        const bool hayB = b != recientes.end() && empiezaPor(palabras.texto(*b), prefijo);
+        if (!hayA && !hayB) return;
+        const bool tomarA = hayA && (!hayB || palabras.texto(*a) < palabras.texto(*b));
+        const Simbolo s = tomarA ? *a++ : *b++;
+        if (!empleadosPorPalabra[s].empty() && !f(s)) return;
+    }
+}
+
+std::vector<int> NameIndex::buscarPrefijo(std::string_view consulta, std::size_t limite) const {
+    std::string normalizada;
+    normalizar(consulta, normalizada);
+    const std::vector<std::string_view> prefijos = palabrasDe(normalizada);
+    std::vector<int> ids;
+    if (prefijos.empty() || limite == 0) return ids;
+
+    // Una palabra: se recorre por orden alfabético y se para al llegar al límite
+    if (prefijos.size() == 1) {
+        RoaringBitmap vistos;
+        paraCadaConPrefijo(prefijos[0], [&](Simbolo s) {
+            return empleadosPorPalabra[s].paraCadaMientras([&](uint32_t id) {
+                if (!vistos.contiene(id)) {
+                    vistos.agregar(id);
+                    ids.push_back(static_cast<int>(id));
+                }
+                return ids.size() < limite;
+            });
+        });
+        return ids;
+    }
+
+    // Varias: el conjunto de cada prefijo y la intersección de todos
+    RoaringBitmap resultado;
+    for (std::size_t k = 0; k < prefijos.size(); ++k) {
+        std::vector<uint32_t> valores;
+        paraCadaConPrefijo(prefijos[k], [&](Simbolo s) {
+            empleadosPorPalabra[s].paraCada([&](uint32_t id) { valores.push_back(id); });
+            return true;
+        });
+        std::sort(valores.begin(), valores.end());
+        valores.erase(std::unique(valores.begin(), valores.end()), valores.end());
+        RoaringBitmap conjunto;
+        for (uint32_t id : valores) conjunto.agregar(id);
+
+        resultado = k == 0 ? std::move(conjunto) : RoaringBitmap::interseccion(resultado, conjunto);
+        if (resultado.empty()) return ids;
+    }
+    resultado.paraCadaMientras([&](uint32_t id) {
+        ids.push_back(static_cast<int>(id));
+        return ids.size() < limite;
+    });
+    return ids;
+}
+
+std::vector<std::pair<NameIndex::Simbolo, double>> NameIndex::variantes(std::string_view palabra,
+                                                                        std::size_t maximo) const {
+    std::vector<std::pair<Simbolo, double>> resultado;
+    const std::size_t n = palabra.size();
+    const std::size_t d = n <= 2 ? 0 : n <= 6 ? 1 : 2;   // ediciones admitidas
+    if (d == 0) {
+        const Simbolo s = palabras.buscar(palabra);
+        if (s != StringInterner::NINGUNO && !empleadosPorPalabra[s].empty()) resultado.push_back({s, 1.0});
+        return resultado;
+    }
+
+    // Listas de los trigramas distintos de la consulta, de la más corta a la más larga
+    static const std::vector<Simbolo> NINGUNA;
+    std::vector<uint32_t> trigramas;
+    paraCadaTrigrama(palabra, [&](uint32_t t) { trigramas.push_back(t); });
+    std::sort(trigramas.begin(), trigramas.end());
+    trigramas.erase(std::unique(trigramas.begin(), trigramas.end()), trigramas.end());
+    std::vector<const std::vector<Simbolo>*> listas;
+    for (uint32_t t : trigramas) {
+        auto it = porTrigrama.find(t);
+        listas.push_back(it == porTrigrama.end() ? &NINGUNA : &it->second);
+    }
+    std::sort(listas.begin(), listas.end(),
+              [](const auto* a, const auto* b) { return a->size() < b->size(); });
+
+    // Cada edición quita como mucho 4 trigramas (una transposición toca los 4
+    // que cubren sus dos letras): una palabra a distancia <= d comparte al
+    // menos t - 4d, así que aparece en alguna de las 4d + 1 listas más cortas.
+    // Con el doble relleno y los umbrales de d, t - 4d >= 1 siempre.
+    const std::size_t t = listas.size();
+    const std::size_t minimoComun = t > 4 * d ? t - 4 * d : 1;
+    std::vector<Simbolo> candidatos;
+    for (std::size_t k = 0; k < t - minimoComun + 1; ++k) {
+        candidatos.insert(candidatos.end(), listas[k]->begin(), listas[k]->end());
+    }
+    std::sort(candidatos.begin(), candidatos.end());
+    candidatos.erase(std::unique(candidatos.begin(), candidatos.end()), candidatos.end());
+
+    Distancia distancia;
+    for (Simbolo s : candidatos) {
+        if (empleadosPorPalabra[s].empty()) continue;
+        const std::string_view texto = palabras.texto(s);
+        const std::size_t e = distancia.calcular(palabra, texto, d);
+        if (e > d) continue;
+        resultado.push_back({s, 1.0 - static_cast<double>(e) / static_cast<double>(std::max(n, texto.size()))});
+    }
+    std::sort(resultado.begin(), resultado.end(), [this](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : palabras.texto(a.first) < palabras.texto(b.first);
+    });
+    if (resultado.size() > maximo) resultado.resize(maximo);
+    return resultado;
+}
+
+std::vector<NameIndex::Coincidencia> NameIndex::buscarAproximado(std::string_view consulta,
+                                                                 std::size_t limite) const {
+    std::string normalizada;
+    normalizar(consulta, normalizada);
+    const std::vector<std::string_view> consultaPalabras = palabrasDe(normalizada);
+    std::vector<Coincidencia> resultado;
+    if (consultaPalabras.empty() || limite == 0) return resultado;
+
+    // Menos variantes por palabra cuantas más palabras, para acotar las combinaciones
+    const std::size_t w = consultaPalabras.size();
+    std::size_t porPalabra = MAX_VARIANTES;
+    auto combinaciones = [w](std::size_t base) {
+        std::size_t total = 1;
+        for (std::size_t k = 0; k < w && total <= MAX_COMBINACIONES; ++k) total *= base;
+        return total;
+    };
+    while (porPalabra > 1 && combinaciones(porPalabra) > MAX_COMBINACIONES) --porPalabra;
+
+    std::vector<std::vector<std::pair<Simbolo, double>>> opciones;
+    for (std::string_view palabra : consultaPalabras) {
+        opciones.push_back(variantes(palabra, porPalabra));
+        if (opciones.back().empty()) return resultado;   // todas las palabras deben aparecer
+    }
+
+    // Todas las combinaciones (una variante por palabra), de mejor a peor media
+    struct Combinacion {
+        double puntuacion;
+        std::vector<std::size_t> eleccion;
+    };
+    std::vector<Combinacion> todas;
+    std::vector<std::size_t> eleccion(w, 0);
+    while (true) {
+        double suma = 0.0;
+        for (std::size_t k = 0; k < w; ++k) suma += opciones[k][eleccion[k]].second;
+        todas.push_back({suma / static_cast<double>(w), eleccion});
+
+        std::size_t k = 0;
+        while (k < w && ++eleccion[k] == opciones[k].size()) eleccion[k++] = 0;
+        if (k == w) break;
+    }
+    std::stable_sort(todas.begin(), todas.end(),
+                     [](const Combinacion& a, const Combinacion& b) { return a.puntuacion > b.puntuacion; });
+
+    // Un empleado sale con su mejor combinación: la primera en que aparece
+    RoaringBitmap vistos;
+    std::vector<const RoaringBitmap*> conjuntos(w);
+    for (const Combinacion& c : todas) {
+        for (std::size_t k = 0; k < w; ++k) conjuntos[k] = &empleadosPorPalabra[opciones[k][c.eleccion[k]].first];
+        std::sort(conjuntos.begin(), conjuntos.end(),
+                  [](const RoaringBitmap* a, const RoaringBitmap* b) { return a->cardinalidad() < b->cardinalidad(); });
+        RoaringBitmap interseccion;
+        if (w > 1) {
+            interseccion = RoaringBitmap::interseccion(*conjuntos[0], *conjuntos[1]);
+            for (std::size_t k = 2; k < w && !interseccion.empty(); ++k) {
+                interseccion = RoaringBitmap::interseccion(interseccion, *conjuntos[k]);
+            }
+        }
+        const RoaringBitmap& ids = w > 1 ? interseccion : *conjuntos[0];
+        const bool seguir = ids.paraCadaMientras([&](uint32_t id) {
+            if (!vistos.contiene(id)) {
+                vistos.agregar(id);
+                resultado.push_back({static_cast<int>(id), c.puntuacion});
+            }
+            return resultado.size() < limite;
+        });
+        if (!seguir) break;
+    }
+    return resultado;
+}
+
+std::size_t NameIndex::bytesUsados() const {
+    std::size_t total = (ordenadas.capacity() + recientes.capacity()) * sizeof(Simbolo);
+    for (const RoaringBitmap& m : empleadosPorPalabra) total += sizeof(RoaringBitmap) + m.bytesUsados();
+    for (const auto& [trigrama, lista] : porTrigrama) total += sizeof(trigrama) + sizeof(lista) + lista.capacity() * sizeof(Simbolo);
+    for (std::size_t s = 0; s < palabras.size(); ++s) total += sizeof(std::string) + palabras.texto(static_cast<Simbolo>(s)).size();
+    return total;
+}
@@ -0,0 +1,119 @@
+#include "OrderedIndex.h"
+#include <algorithm>
+#include <climits>
+
+OrderedIndex::Iterador& OrderedIndex::Iterador::operator++() {
+    if (++pos == (*hojas)[hoja].size()) {
+        ++hoja;
+        pos = 0;
+    }
+    return *this;
+}
+
+OrderedIndex::Iterador& OrderedIndex::Iterador::operator--() {
+    if (pos == 0) {
+        --hoja;
+        pos = (*hojas)[hoja].size() - 1;
+    } else {
+        --pos;
+    }
+    return *this;
+}
+
+std::size_t OrderedIndex::hojaPara(const Entrada& e) const {
+    // Última hoja cuyo primer elemento no es mayor que 'e' (o la primera)
+    auto it = std::upper_bound(primeros.begin(), primeros.end(), e);
+    return it == primeros.begin() ? 0 : static_cast<std::size_t>(it - primeros.begin()) - 1;
+}
+
+OrderedIndex::Iterador OrderedIndex::cotaInferior(const Entrada& e) const {
+    if (hojas.empty()) return end();
+    std::size_t h = hojaPara(e);
+    const std::vector<Entrada>& hoja = hojas[h];
+    std::size_t pos = static_cast<std::size_t>(std::lower_bound(hoja.begin(), hoja.end(), e) - hoja.begin());
+    if (pos == hoja.size()) return Iterador(&hojas, h + 1, 0);
+    return Iterador(&hojas, h, pos);
+}
+
+OrderedIndex::Iterador OrderedIndex::primeroNoMenor(double clave) const {
+    return cotaInferior({clave, INT_MIN});
+}
+
+OrderedIndex::Iterador OrderedIndex::primeroMayor(double clave) const {
+    Iterador it = cotaInferior({clave, INT_MAX});
+    while (it != end() && it->clave == clave) ++it;
+    return it;
+}
+
+void OrderedIndex::insertar(double clave, int id) {
+    const Entrada e{clave, id};
+    ++cantidad;
+    if (hojas.empty()) {
+        hojas.push_back({e});
+        primeros.push_back(e);
+        return;
+    }
+
+    std::size_t h = hojaPara(e);
+    std::vector<Entrada>& hoja = hojas[h];
+    hoja.insert(std::lower_bound(hoja.begin(), hoja.end(), e), e);
+    primeros[h] = hoja.front();
+
+    // Una hoja llena se parte en dos mitades
+    if (hoja.size() > 2 * TAMANO_HOJA) {
+        std::vector<Entrada> mitad(hoja.begin() + TAMANO_HOJA, hoja.end());
+        hoja.resize(TAMANO_HOJA);
+        primeros.insert(primeros.begin() + h + 1, mitad.front());
+        hojas.insert(hojas.begin() + h + 1, std::move(mitad));
+    }
+}
+
+bool OrderedIndex::eliminar(double clave, int id) {
+    if (hojas.empty()) return false;
+    const Entrada e{clave, id};
+    std::size_t h = hojaPara(e);
+    std::vector<Entrada>& hoja = hojas[h];
+    auto it = std::lower_bound(hoja.begin(), hoja.end(), e);
+    if (it == hoja.end() || !(*it == e)) return false;
+
+    hoja.erase(it);
+    --cantidad;
+    if (hoja.empty()) {
+        hojas.erase(hojas.begin() + h);
+        primeros.erase(primeros.begin() + h);
+        return true;
+    }
+    primeros[h] = hoja.front();
+
+    // Una hoja casi vacía se une a su vecina si caben juntas
+    if (hoja.size() < TAMANO_HOJA / 4) {
+        std::size_t izquierda = (h + 1 < hojas.size()) ? h : h - (h > 0);
+        std::size_t derecha = izquierda + 1;
+        if (derecha < hojas.size() && hojas[izquierda].size() + hojas[derecha].size() <= 2 * TAMANO_HOJA) {
+            hojas[izquierda].insert(hojas[izquierda].end(), hojas[derecha].begin(), hojas[derecha].end());
+            hojas.erase(hojas.begin() + derecha);
+            primeros.erase(primeros.begin() + derecha);
+        }
+    }
+    return true;
+}
+
+void OrderedIndex::construir(std::vector<Entrada> entradas) {
+    std::sort(entradas.begin(), entradas.end());
+    limpiar();
+    cantidad = entradas.size();
+
+    // Hojas a medio llenar: dejan sitio para insertar sin partir enseguida
+    hojas.reserve((entradas.size() + TAMANO_HOJA - 1) / TAMANO_HOJA);
+    for (std::size_t i = 0; i < entradas.size(); i += TAMANO_HOJA) {
+        std::size_t fin = std::min(entradas.size(), i + TAMANO_HOJA);
+        hojas.emplace_back(entradas.begin() + i, entradas.begin() + fin);
+        primeros.push_back(entradas[i]);
+    }
+}
+
+void OrderedIndex::limpiar() {
+    hojas.clear();
+    primeros.clear();
+    cantidad = 0;
+}
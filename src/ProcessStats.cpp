@@ -0,0 +1,36 @@
+#include "ProcessStats.h"
+
+#ifndef _WIN32
+#include <cstdio>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+std::size_t memoriaPicoKB() { return 0; }
+std::size_t memoriaActualKB() { return 0; }
+
+#else
+
+std::size_t memoriaPicoKB() {
+    struct rusage uso;
+    if (::getrusage(RUSAGE_SELF, &uso) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<std::size_t>(uso.ru_maxrss) / 1024;   // en bytes
+#else
+    return static_cast<std::size_t>(uso.ru_maxrss);          // en KiB
+#endif
+}
+
+std::size_t memoriaActualKB() {
+    std::FILE* f = std::fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    unsigned long total = 0, residentes = 0;
+    int leidos = std::fscanf(f, "%lu %lu", &total, &residentes);
+    std::fclose(f);
+    if (leidos != 2) return 0;
+    return residentes * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) / 1024;
+}
+
+#endif
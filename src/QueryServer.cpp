@@ -0,0 +1,406 @@
+#include "QueryServer.h"
+#include "BatchProcessor.h"
+#include "Protocol.h"
+
+#ifdef __linux__
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t LECTURA_MAXIMA_POR_VUELTA = 256 * 1024;   // reparto justo entre conexiones
+constexpr std::size_t SALIDA_MAXIMA = 4 << 20;   // con más pendiente se deja de leer
+constexpr int EVENTOS_POR_VUELTA = 128;
+
+std::string errorSistema(const std::string& que) {
+    return que + ": " + std::strerror(errno);
+}
+
+void responder(std::string& salida, protocolo::Estado estado) {
+    std::size_t t = protocolo::abrirTrama(salida, static_cast<uint8_t>(estado));
+    protocolo::cerrarTrama(salida, t);
+}
+
+void responderInvalida(std::string& salida, std::string_view motivo) {
+    std::size_t t = protocolo::abrirTrama(salida, static_cast<uint8_t>(protocolo::Estado::Invalida));
+    salida += motivo;
+    protocolo::cerrarTrama(salida, t);
+}
+
+bool leerId(std::string_view& datos, int& id) {
+    uint32_t v;
+    if (!protocolo::leerU32(datos, v)) return false;
+    id = static_cast<int>(v);
+    return true;
+}
+
+} // namespace
+
+QueryServer::QueryServer(EmployeeManager& manager) : manager(manager) {
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    despertadorFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd >= 0 && despertadorFd >= 0) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = despertadorFd;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, despertadorFd, &ev);
+    }
+}
+
+QueryServer::~QueryServer() {
+    for (auto& [fd, c] : conexiones) ::close(fd);
+    if (escuchaFd >= 0) ::close(escuchaFd);
+    if (!rutaUnix.empty()) ::unlink(rutaUnix.c_str());
+    if (despertadorFd >= 0) ::close(despertadorFd);
+    if (epollFd >= 0) ::close(epollFd);
+}
+
+bool QueryServer::escuchar(const std::string& direccion, std::string& error) {
+    if (epollFd < 0 || despertadorFd < 0) {
+        error = "no se pudo crear epoll/eventfd";
+        return false;
+    }
+    if (escuchaFd >= 0) {
+        error = "el servidor ya está escuchando";
+        return false;
+    }
+
+    if (direccion.compare(0, 5, "unix:") == 0) {
+        std::string ruta = direccion.substr(5);
+        sockaddr_un dir{};
+        if (ruta.empty() || ruta.size() >= sizeof(dir.sun_path)) {
+            error = "ruta de socket inválida '" + ruta + "'";
+            return false;
+        }
+        dir.sun_family = AF_UNIX;
+        std::memcpy(dir.sun_path, ruta.c_str(), ruta.size() + 1);
+
+        escuchaFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        ::unlink(ruta.c_str());   // restos de una ejecución anterior
+        if (escuchaFd < 0 || ::bind(escuchaFd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir)) != 0) {
+            error = errorSistema("no se pudo abrir " + ruta);
+            return false;
+        }
+        rutaUnix = ruta;
+    } else if (direccion.compare(0, 4, "tcp:") == 0) {
+        int puerto = std::atoi(direccion.c_str() + 4);
+        if (puerto <= 0 || puerto > 65535) {
+            error = "puerto inválido '" + direccion.substr(4) + "'";
+            return false;
+        }
+        sockaddr_in dir{};
+        dir.sin_family = AF_INET;
+        dir.sin_port = htons(static_cast<uint16_t>(puerto));
+        dir.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        escuchaFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int uno = 1;
+        if (escuchaFd >= 0) ::setsockopt(escuchaFd, SOL_SOCKET, SO_REUSEADDR, &uno, sizeof(uno));
+        if (escuchaFd < 0 || ::bind(escuchaFd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir)) != 0) {
+            error = errorSistema("no se pudo abrir 127.0.0.1:" + std::to_string(puerto));
+            return false;
+        }
+    } else {
+        error = "dirección inválida '" + direccion + "' (use unix:/ruta o tcp:puerto)";
+        return false;
+    }
+
+    if (::listen(escuchaFd, SOMAXCONN) != 0) {
+        error = errorSistema("listen");
+        return false;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = escuchaFd;
+    if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, escuchaFd, &ev) != 0) {
+        error = errorSistema("epoll_ctl");
+        return false;
+    }
+    return true;
+}
+
+void QueryServer::detener() {
+    uint64_t uno = 1;
+    ssize_t escrito = ::write(despertadorFd, &uno, sizeof(uno));
+    (void)escrito;
+}
+
+bool QueryServer::ejecutar(std::string& error) {
+    if (escuchaFd < 0) {
+        error = "el servidor no está escuchando";
+        return false;
+    }
+
+    epoll_event eventos[EVENTOS_POR_VUELTA];
+    std::vector<int> porEnviar;
+    while (true) {
+        int n = ::epoll_wait(epollFd, eventos, EVENTOS_POR_VUELTA, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            error = errorSistema("epoll_wait");
+            return false;
+        }
+
+        porEnviar.clear();
+        bool modifico = false;
+        bool detenido = false;
+        for (int i = 0; i < n; ++i) {
+            const int fd = eventos[i].data.fd;
+            if (fd == despertadorFd) {
+                detenido = true;   // se termina la vuelta para no dejar cambios sin sincronizar
+                continue;
+            }
+            if (fd == escuchaFd) {
+                aceptar();
+                continue;
+            }
+
+            auto it = conexiones.find(fd);
+            if (it == conexiones.end()) continue;
+            Conexion& c = *it->second;
+            const uint32_t ev = eventos[i].events;
+
+            if (ev & EPOLLIN) {
+                // Tras un cierre de escritura del cliente aún se envían las respuestas pendientes
+                c.finLectura = !leer(c);
+                if (!procesarTramas(c, modifico) || (c.finLectura && c.salida.size() == c.enviado)) {
+                    cerrar(fd);
+                    continue;
+                }
+            } else if (ev & (EPOLLERR | EPOLLHUP)) {
+                cerrar(fd);
+                continue;
+            }
+            if (c.salida.size() > c.enviado) porEnviar.push_back(fd);
+        }
+
+        // Confirmación en grupo: un solo fsync del diario por vuelta, antes de responder
+        if (modifico && manager.tieneDiario()) {
+            ++sincronizaciones;
+            // Sin fsync no se puede confirmar nada: se cierra sin responder
+            if (!manager.guardarEnArchivo()) {
+                error = "no se pudo sincronizar el diario";
+                return false;
+            }
+        }
+
+        for (int fd : porEnviar) {
+            auto it = conexiones.find(fd);
+            if (it != conexiones.end() && !enviar(*it->second)) cerrar(fd);
+        }
+        if (detenido) return true;
+    }
+}
+
+void QueryServer::aceptar() {
+    while (true) {
+        int fd = ::accept4(escuchaFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;   // EAGAIN: no quedan pendientes
+
+        if (rutaUnix.empty()) {
+            int uno = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            ::close(fd);
+            continue;
+        }
+        auto c = std::make_unique<Conexion>();
+        c->fd = fd;
+        c->eventos = EPOLLIN;
+        conexiones[fd] = std::move(c);
+        ++conexionesAceptadas;
+    }
+}
+
+// false si el otro extremo cerró o hubo un error
+bool QueryServer::leer(Conexion& c) {
+    char buffer[64 * 1024];
+    std::size_t leidos = 0;
+    while (leidos < LECTURA_MAXIMA_POR_VUELTA) {
+        ssize_t r = ::recv(c.fd, buffer, sizeof(buffer), 0);
+        if (r > 0) {
+            c.entrada.append(buffer, static_cast<std::size_t>(r));
+            leidos += static_cast<std::size_t>(r);
+            continue;
+        }
+        if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+        if (r < 0 && errno == EINTR) continue;
+        return false;
+    }
+    return true;
+}
+
+bool QueryServer::procesarTramas(Conexion& c, bool& modifico) {
+    std::size_t consumido = 0;
+    while (c.entrada.size() - consumido >= protocolo::CABECERA) {
+        uint32_t longitud = protocolo::decodificarU32(c.entrada.data() + consumido);
+        if (longitud == 0 || longitud > protocolo::TRAMA_MAXIMA) return false;
+        if (c.entrada.size() - consumido - protocolo::CABECERA < longitud) break;
+
+        const char* trama = c.entrada.data() + consumido + protocolo::CABECERA;
+        std::string_view datos(trama + 1, longitud - 1);
+        modifico |= atender(static_cast<uint8_t>(trama[0]), datos, c.salida);
+        ++peticiones;
+        consumido += protocolo::CABECERA + longitud;
+    }
+    c.entrada.erase(0, consumido);
+    return true;
+}
+
+// Devuelve true si la petición modificó datos
+bool QueryServer::atender(uint8_t operacion, std::string_view datos, std::string& salida) {
+    using protocolo::Estado;
+    using protocolo::Operacion;
+    int id = 0;
+
+    switch (static_cast<Operacion>(operacion)) {
+        case Operacion::Buscar: {
+            if (!leerId(datos, id)) break;
+            if (const Employee* emp = manager.getEmpleado(id)) {
+                std::size_t t = protocolo::abrirTrama(salida, static_cast<uint8_t>(Estado::Ok));
+                salida += emp->serializar();
+                protocolo::cerrarTrama(salida, t);
+            } else {
+                responder(salida, Estado::NoEncontrado);
+            }
+            return false;
+        }
+        case Operacion::Alta: {
+            DescriptorEmpleado d;
+            std::string motivo;
+            if (!BatchProcessor::analizarAlta(datos, d, motivo)) {
+                responderInvalida(salida, motivo);
+                return false;
+            }
+            int nuevo = manager.agregarLote(&d, &d + 1);
+            if (!manager.getEmpleado(nuevo)) {
+                responderInvalida(salida, "el jefe " + std::to_string(d.jefe) + " no existe o no es manager");
+                return false;
+            }
+            std::size_t t = protocolo::abrirTrama(salida, static_cast<uint8_t>(Estado::Ok));
+            protocolo::anadirU32(salida, static_cast<uint32_t>(nuevo));
+            protocolo::cerrarTrama(salida, t);
+            return true;
+        }
+        case Operacion::Salario: {
+            double salario = 0;
+            if (!leerId(datos, id) || !protocolo::leerF64(datos, salario) || !std::isfinite(salario) || salario < 0) break;
+            bool ok = manager.salarioSinAviso(id, salario);
+            responder(salida, ok ? Estado::Ok : Estado::NoEncontrado);
+            return ok;
+        }
+        case Operacion::Baja: {
+            if (!leerId(datos, id)) break;
+            bool ok = manager.bajaSinAviso(id);
+            responder(salida, ok ? Estado::Ok : Estado::NoEncontrado);
+            return ok;
+        }
+        case Operacion::Nomina: {
+            std::size_t t = protocolo::abrirTrama(salida, static_cast<uint8_t>(Estado::Ok));
+            protocolo::anadirF64(salida, manager.calcularNominaTotal());
+            protocolo::anadirU32(salida, static_cast<uint32_t>(manager.getCantidadEmpleados()));
+            protocolo::cerrarTrama(salida, t);
+            return false;
+        }
+        case Operacion::Departamentos: {
+            auto estadisticas = manager.estadisticasPorDepartamento();
+            std::size_t t = protocolo::abrirTrama(salida, static_cast<uint8_t>(Estado::Ok));
+            protocolo::anadirU32(salida, static_cast<uint32_t>(estadisticas.size()));
+            for (const auto& [nombre, e] : estadisticas) {
+                protocolo::anadirU16(salida, static_cast<uint16_t>(nombre.size()));
+                salida += nombre;
+                protocolo::anadirU32(salida, static_cast<uint32_t>(e.cantidad));
+                for (double valor : {e.suma, e.media, e.minimo, e.maximo}) protocolo::anadirF64(salida, valor);
+            }
+            protocolo::cerrarTrama(salida, t);
+            return false;
+        }
+        case Operacion::Ping:
+            responder(salida, Estado::Ok);
+            return false;
+        default:
+            responderInvalida(salida, "operación desconocida");
+            return false;
+    }
+    responderInvalida(salida, "datos incompletos");
+    return false;
+}
+
+bool QueryServer::enviar(Conexion& c) {
+    while (c.enviado < c.salida.size()) {
+        ssize_t w = ::send(c.fd, c.salida.data() + c.enviado, c.salida.size() - c.enviado, MSG_NOSIGNAL);
+        if (w > 0) {
+            c.enviado += static_cast<std::size_t>(w);
+            continue;
+        }
+        if (w < 0 && errno == EINTR) continue;
+        if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        return false;
+    }
+
+    const std::size_t pendiente = c.salida.size() - c.enviado;
+    if (pendiente == 0) {
+        c.salida.clear();
+        c.enviado = 0;
+    } else if (c.enviado > c.salida.size() / 2) {
+        c.salida.erase(0, c.enviado);
+        c.enviado = 0;
+    }
+
+    if (pendiente == 0 && c.finLectura) return false;
+
+    // Con salida pendiente se espera EPOLLOUT; si se acumula demasiada, se
+    // deja de leer hasta que el cliente consuma (contrapresión)
+    uint32_t deseados = 0;
+    if (!c.finLectura && pendiente <= SALIDA_MAXIMA) deseados |= EPOLLIN;
+    if (pendiente > 0) deseados |= EPOLLOUT;
+    if (deseados != c.eventos) {
+        epoll_event ev{};
+        ev.events = deseados;
+        ev.data.fd = c.fd;
+        ::epoll_ctl(epollFd, EPOLL_CTL_MOD, c.fd, &ev);
+        c.eventos = deseados;
+    }
+    return true;
+}
+
+void QueryServer::cerrar(int fd) {
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    conexiones.erase(fd);
+}
+
+#else
+
+QueryServer::QueryServer(EmployeeManager& manager) : manager(manager) {}
+QueryServer::~QueryServer() {}
+
+bool QueryServer::escuchar(const std::string&, std::string& error) {
+    error = "el servidor necesita Linux (epoll)";
+    return false;
+}
+
+bool QueryServer::ejecutar(std::string& error) {
+    error = "el servidor necesita Linux (epoll)";
+    return false;
+}
+
+void QueryServer::detener() {}
+
+#endif
@@ -0,0 +1,248 @@
+#include "ReportWriter.h"
+#include "Developer.h"
+#include "EmployeeParser.h"
+#include <charconv>
+#include <cmath>
+
+namespace {
+
+constexpr std::size_t ANCHO_ID = 8;
+constexpr std::size_t ANCHO_TIPO = 11;
+constexpr std::size_t ANCHO_NOMBRE = 26;
+constexpr std::size_t ANCHO_DEPARTAMENTO = 16;
+constexpr std::size_t ANCHO_IMPORTE = 15;
+
+// Formato más corto que se vuelve a leer igual (CSV, JSON)
+template <typename T>
+std::string_view numero(char (&buffer)[32], T valor) {
+    auto [fin, ec] = std::to_chars(buffer, buffer + sizeof(buffer), valor);
+    return std::string_view(buffer, ec == std::errc() ? static_cast<std::size_t>(fin - buffer) : 0);
+}
+
+std::string_view importe(char (&buffer)[32], double valor) {
+    auto [fin, ec] = std::to_chars(buffer, buffer + sizeof(buffer), valor, std::chars_format::fixed, 2);
+    return std::string_view(buffer, ec == std::errc() ? static_cast<std::size_t>(fin - buffer) : 0);
+}
+
+// Caracteres en pantalla de un texto UTF-8 (no cuenta los bytes de continuación)
+std::size_t anchoVisible(std::string_view texto) {
+    std::size_t ancho = 0;
+    for (unsigned char c : texto) ancho += (c & 0xC0) != 0x80;
+    return ancho;
+}
+
+void alinearIzquierda(std::string& destino, std::string_view texto, std::size_t ancho) {
+    destino += texto;
+    std::size_t visible = anchoVisible(texto);
+    if (visible < ancho) destino.append(ancho - visible, ' ');
+}
+
+void alinearDerecha(std::string& destino, std::string_view texto, std::size_t ancho) {
+    if (texto.size() < ancho) destino.append(ancho - texto.size(), ' ');
+    destino += texto;
+}
+
+void campoCsv(std::string& destino, std::string_view texto) {
+    if (texto.find_first_of(",\"\r\n") == std::string_view::npos) {
+        destino += texto;
+        return;
+    }
+    destino += '"';
+    for (char c : texto) {
+        if (c == '"') destino += '"';
+        destino += c;
+    }
+    destino += '"';
+}
+
+void cadenaJson(std::string& destino, std::string_view texto) {
+    static const char HEX[] = "0123456789abcdef";
+    destino += '"';
+    for (char c : texto) {
+        const unsigned char u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            destino += '\\';
+            destino += c;
+        } else if (u < 0x20) {
+            destino += "\\u00";
+            destino += HEX[u >> 4];
+            destino += HEX[u & 0xF];
+        } else {
+            destino += c;
+        }
+    }
+    destino += '"';
+}
+
+void numeroJson(std::string& destino, double valor) {
+    char buffer[32];
+    if (std::isfinite(valor)) destino += numero(buffer, valor);
+    else destino += "null";
+}
+
+} // namespace
+
+bool formatoInformePorNombre(std::string_view nombre, FormatoInforme& formato) {
+    if (nombre == "tabla") formato = FormatoInforme::Tabla;
+    else if (nombre == "csv") formato = FormatoInforme::Csv;
+    else if (nombre == "jsonl") formato = FormatoInforme::JsonLineas;
+    else return false;
+    return true;
+}
+
+ReportWriter::ReportWriter(std::FILE* salida, FormatoInforme formato)
+    : salida(salida), formato(formato) {
+    buffer.reserve(TAMANO_BUFFER + 4096);
+}
+
+ReportWriter::~ReportWriter() {
+    vaciar();
+}
+
+void ReportWriter::vaciar() {
+    if (buffer.empty()) return;
+    std::fwrite(buffer.data(), 1, buffer.size(), salida);
+    buffer.clear();
+}
+
+void ReportWriter::empezar() {
+    if (formato == FormatoInforme::Csv) {
+        buffer += "id,tipo,nombre,apellido,departamento,salario_base,salario_total,bonus,equipo,lenguajes\n";
+    } else if (formato == FormatoInforme::Tabla) {
+        alinearDerecha(buffer, "ID", ANCHO_ID);
+        buffer += "  ";
+        alinearIzquierda(buffer, "Tipo", ANCHO_TIPO);
+        alinearIzquierda(buffer, "Nombre", ANCHO_NOMBRE);
+        alinearIzquierda(buffer, "Departamento", ANCHO_DEPARTAMENTO);
+        alinearDerecha(buffer, "Salario base", ANCHO_IMPORTE);
+        alinearDerecha(buffer, "Salario total", ANCHO_IMPORTE);
+        buffer += "  Detalle\n";
+        const std::size_t ancho = ANCHO_ID + 2 + ANCHO_TIPO + ANCHO_NOMBRE + ANCHO_DEPARTAMENTO
+                                + 2 * ANCHO_IMPORTE + 2 + 30;
+        for (std::size_t i = 0; i < ancho; ++i) buffer += "─";
+        buffer += '\n';
+    }
+}
+
+void ReportWriter::escribir(const Employee& emp) {
+    const ComponentesSalario c = emp.getComponentesSalario();
+    static const Developer::Lenguajes NINGUNO;
+    const Developer::Lenguajes& lenguajes = c.tipo == TipoEmpleado::Developer
+        ? static_cast<const Developer&>(emp).getLenguajes() : NINGUNO;
+
+    switch (formato) {
+        case FormatoInforme::Tabla: filaTabla(emp, c, lenguajes); break;
+        case FormatoInforme::Csv: filaCsv(emp, c, lenguajes); break;
+        case FormatoInforme::JsonLineas: filaJson(emp, c, lenguajes); break;
+    }
+    ++filas;
+    if (buffer.size() >= TAMANO_BUFFER) vaciar();
+}
+
+bool ReportWriter::terminar() {
+    if (formato == FormatoInforme::Tabla) {
+        char texto[32];
+        buffer += "\nTotal: ";
+        buffer += numero(texto, filas);
+        buffer += filas == 1 ? " empleado\n" : " empleados\n";
+    }
+    vaciar();
+    return std::fflush(salida) == 0 && !std::ferror(salida);
+}
+
+void ReportWriter::filaTabla(const Employee& emp, const ComponentesSalario& c, const Developer::Lenguajes& lenguajes) {
+    char texto[32];
+    alinearDerecha(buffer, numero(texto, emp.getId()), ANCHO_ID);
+    buffer += "  ";
+    alinearIzquierda(buffer, emp.getTipo(), ANCHO_TIPO);
+
+    const std::size_t inicioNombre = buffer.size();
+    buffer += emp.getNombre();
+    buffer += ' ';
+    buffer += emp.getApellido();
+    const std::size_t visible = anchoVisible(std::string_view(buffer).substr(inicioNombre));
+    buffer.append(visible < ANCHO_NOMBRE ? ANCHO_NOMBRE - visible : 1, ' ');
+
+    alinearIzquierda(buffer, emp.getDepartamento(), ANCHO_DEPARTAMENTO);
+    alinearDerecha(buffer, importe(texto, c.salarioBase), ANCHO_IMPORTE);
+    alinearDerecha(buffer, importe(texto, emp.calcularSalarioTotal()), ANCHO_IMPORTE);
+    buffer += "  ";
+
+    if (c.tipo == TipoEmpleado::Developer) {
+        buffer += "bonus ";
+        buffer += importe(texto, c.bonus);
+        buffer += " · ";
+        bool primero = true;
+        for (SymbolTable::Simbolo lang : lenguajes) {
+            if (!primero) buffer += ", ";
+            buffer += textoSimbolo(lang);
+            primero = false;
+        }
+    } else {
+        buffer += "equipo ";
+        buffer += numero(texto, c.equipo);
+        buffer += " · bonus ";
+        buffer += importe(texto, c.bonus);
+    }
+    buffer += '\n';
+}
+
+void ReportWriter::filaCsv(const Employee& emp, const ComponentesSalario& c, const Developer::Lenguajes& lenguajes) {
+    char texto[32];
+    buffer += numero(texto, emp.getId());
+    buffer += ',';
+    buffer += emp.getTipo();
+    buffer += ',';
+    campoCsv(buffer, emp.getNombre());
+    buffer += ',';
+    campoCsv(buffer, emp.getApellido());
+    buffer += ',';
+    campoCsv(buffer, emp.getDepartamento());
+    buffer += ',';
+    buffer += numero(texto, c.salarioBase);
+    buffer += ',';
+    buffer += numero(texto, emp.calcularSalarioTotal());
+    buffer += ',';
+    buffer += numero(texto, c.bonus);
+    buffer += ',';
+    buffer += numero(texto, c.equipo);
+    buffer += ',';
+    lista.clear();
+    unirLenguajes(lenguajes, lista);
+    campoCsv(buffer, lista);
+    buffer += '\n';
+}
+
+void ReportWriter::filaJson(const Employee& emp, const ComponentesSalario& c, const Developer::Lenguajes& lenguajes) {
+    char texto[32];
+    buffer += "{\"id\":";
+    buffer += numero(texto, emp.getId());
+    buffer += ",\"tipo\":";
+    cadenaJson(buffer, emp.getTipo());
+    buffer += ",\"nombre\":";
+    cadenaJson(buffer, emp.getNombre());
+    buffer += ",\"apellido\":";
+    cadenaJson(buffer, emp.getApellido());
+    buffer += ",\"departamento\":";
+    cadenaJson(buffer, emp.getDepartamento());
+    buffer += ",\"salarioBase\":";
+    numeroJson(buffer, c.salarioBase);
+    buffer += ",\"salarioTotal\":";
+    numeroJson(buffer, emp.calcularSalarioTotal());
+    buffer += ",\"bonus\":";
+    numeroJson(buffer, c.bonus);
+    if (c.tipo == TipoEmpleado::Developer) {
+        buffer += ",\"lenguajes\":[";
+        bool primero = true;
+        for (SymbolTable::Simbolo lang : lenguajes) {
+            if (!primero) buffer += ',';
+            cadenaJson(buffer, textoSimbolo(lang));
+            primero = false;
+        }
+        buffer += ']';
+    } else {
+        buffer += ",\"equipo\":";
+        buffer += numero(texto, c.equipo);
+    }
+    buffer += "}\n";
+}
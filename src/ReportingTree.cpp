@@ -0,0 +1,362 @@
+#include "ReportingTree.h"
+#include <utility>
+
+uint32_t ReportingTree::aleatorio() {
+    // xorshift32: basta con que las prioridades no sigan el orden de llegada
+    semilla ^= semilla << 13;
+    semilla ^= semilla >> 17;
+    semilla ^= semilla << 5;
+    return semilla;
+}
+
+void ReportingTree::recalcular(uint32_t t) {
+    Nodo& n = nodos[t];
+    const bool apertura = (t & 1) == 0;
+    double nomina = 0.0;
+    n.tamano = 1;
+    n.personas = apertura ? 1 : 0;
+    if (n.izq != NULO) {
+        Nodo& hijo = nodos[n.izq];
+        hijo.padre = t;
+        n.tamano += hijo.tamano;
+        n.personas += hijo.personas;
+        nomina += hijo.nomina;
+    }
+    if (apertura) nomina += salarios[t >> 1];
+    if (n.der != NULO) {
+        Nodo& hijo = nodos[n.der];
+        hijo.padre = t;
+        n.tamano += hijo.tamano;
+        n.personas += hijo.personas;
+        nomina += hijo.nomina;
+    }
+    n.nomina = nomina;
+}
+
+uint32_t ReportingTree::posicion(uint32_t t) const {
+    uint32_t p = tamano(nodos[t].izq);
+    for (uint32_t q = nodos[t].padre; q != NULO; t = q, q = nodos[q].padre) {
+        if (nodos[q].der == t) p += tamano(nodos[q].izq) + 1;
+    }
+    return p;
+}
+
+uint32_t ReportingTree::sucesor(uint32_t t) const {
+    if (nodos[t].der != NULO) {
+        t = nodos[t].der;
+        while (nodos[t].izq != NULO) t = nodos[t].izq;
+        return t;
+    }
+    uint32_t q = nodos[t].padre;
+    while (q != NULO && nodos[q].der == t) {
+        t = q;
+        q = nodos[q].padre;
+    }
+    return q;
+}
+
+// Las raíces que salen de dividir() y unir() quedan sin padre; la llamada
+// de arriba las adopta al recalcular
+void ReportingTree::dividir(uint32_t t, uint32_t k, uint32_t& primeros, uint32_t& resto) {
+    if (t == NULO) {
+        primeros = resto = NULO;
+        return;
+    }
+    Nodo& n = nodos[t];
+    if (tamano(n.izq) < k) {
+        dividir(n.der, k - tamano(n.izq) - 1, n.der, resto);
+        primeros = t;
+    } else {
+        dividir(n.izq, k, primeros, n.izq);
+        resto = t;
+    }
+    recalcular(t);
+    nodos[t].padre = NULO;
+}
+
+uint32_t ReportingTree::unir(uint32_t a, uint32_t b) {
+    if (a == NULO || b == NULO) {
+        const uint32_t t = a == NULO ? b : a;
+        if (t != NULO) nodos[t].padre = NULO;
+        return t;
+    }
+    uint32_t t;
+    if (nodos[a].prioridad > nodos[b].prioridad) {
+        t = a;
+        nodos[a].der = unir(nodos[a].der, b);
+    } else {
+        t = b;
+        nodos[b].izq = unir(a, nodos[b].izq);
+    }
+    recalcular(t);
+    nodos[t].padre = NULO;
+    return t;
+}
+
+void ReportingTree::sumarRango(uint32_t t, int64_t desde, int64_t hasta, Rama& total) const {
+    if (t == NULO || hasta < 0 || desde >= static_cast<int64_t>(nodos[t].tamano)) return;
+    const Nodo& n = nodos[t];
+    if (desde <= 0 && hasta >= static_cast<int64_t>(n.tamano) - 1) {
+        total.personas += n.personas;
+        total.nomina += n.nomina;
+        return;
+    }
+    const int64_t i = tamano(n.izq);
+    sumarRango(n.izq, desde, hasta, total);
+    if ((t & 1) == 0 && desde <= i && i <= hasta) {
+        total.personas += 1;
+        total.nomina += salarios[t >> 1];
+    }
+    sumarRango(n.der, desde - i - 1, hasta - i - 1, total);
+}
+
+void ReportingTree::insertarTras(uint32_t abrirJefe, uint32_t tramo) {
+    if (abrirJefe == NULO) {
+        raiz = unir(raiz, tramo);
+        return;
+    }
+    uint32_t antes, despues;
+    dividir(raiz, posicion(abrirJefe) + 1, antes, despues);
+    raiz = unir(unir(antes, tramo), despues);
+}
+
+uint32_t ReportingTree::cortar(uint32_t hueco) {
+    const uint32_t desde = posicion(2 * hueco);
+    const uint32_t hasta = posicion(2 * hueco + 1);
+    uint32_t antes, resto, tramo, despues;
+    dividir(raiz, desde, antes, resto);
+    dividir(resto, hasta - desde + 1, tramo, despues);
+    raiz = unir(antes, despues);
+    return tramo;
+}
+
+uint32_t ReportingTree::nuevoHueco(int id, double salario) {
+    uint32_t h;
+    if (!libres.empty()) {
+        h = libres.back();
+        libres.pop_back();
+        ids[h] = id;
+        salarios[h] = salario;
+    } else {
+        h = static_cast<uint32_t>(ids.size());
+        ids.push_back(id);
+        salarios.push_back(salario);
+        nodos.resize(nodos.size() + 2);
+    }
+    for (uint32_t t = 2 * h; t <= 2 * h + 1; ++t) {
+        nodos[t] = Nodo{};
+        nodos[t].prioridad = aleatorio();
+        recalcular(t);
+    }
+    indice.insertar(id, h);
+    return h;
+}
+
+bool ReportingTree::agregar(int id, double salario, int jefe) {
+    if (contiene(id)) return false;
+    uint32_t abrirJefe = NULO;
+    if (jefe != 0) {
+        const std::size_t hj = indice.buscar(jefe);
+        if (hj == IdIndex::NO_ENCONTRADO) return false;
+        abrirJefe = static_cast<uint32_t>(2 * hj);
+    }
+    const uint32_t h = nuevoHueco(id, salario);
+    insertarTras(abrirJefe, unir(2 * h, 2 * h + 1));
+    return true;
+}
+
+bool ReportingTree::quitar(int id) {
+    const std::size_t hueco = indice.buscar(id);
+    if (hueco == IdIndex::NO_ENCONTRADO) return false;
+    const uint32_t h = static_cast<uint32_t>(hueco);
+
+    // Se quitan solo las dos marcas: lo que había entre ellas queda dentro
+    // de la rama del jefe
+    const uint32_t desde = posicion(2 * h);
+    const uint32_t hasta = posicion(2 * h + 1);
+    uint32_t antes, resto, abrir, medio, cerrar, despues;
+    dividir(raiz, desde, antes, resto);
+    dividir(resto, 1, abrir, resto);
+    dividir(resto, hasta - desde - 1, medio, resto);
+    dividir(resto, 1, cerrar, despues);
+    raiz = unir(unir(antes, medio), despues);
+
+    indice.eliminar(id);
+    libres.push_back(h);
+    return true;
+}
+
+bool ReportingTree::mover(int id, int jefe) {
+    const std::size_t h = indice.buscar(id);
+    if (h == IdIndex::NO_ENCONTRADO) return false;
+    uint32_t abrirJefe = NULO;
+    if (jefe != 0) {
+        const std::size_t hj = indice.buscar(jefe);
+        if (hj == IdIndex::NO_ENCONTRADO || estaEnRama(id, jefe)) return false;
+        abrirJefe = static_cast<uint32_t>(2 * hj);
+    }
+    insertarTras(abrirJefe, cortar(static_cast<uint32_t>(h)));
+    return true;
+}
+
+void ReportingTree::actualizarSalario(int id, double salario) {
+    const std::size_t h = indice.buscar(id);
+    if (h == IdIndex::NO_ENCONTRADO) return;
+    salarios[h] = salario;
+    for (uint32_t t = static_cast<uint32_t>(2 * h); t != NULO; t = nodos[t].padre) {
+        recalcular(t);
+    }
+}
+
+ReportingTree::Rama ReportingTree::rama(int id) const {
+    Rama total;
+    const std::size_t h = indice.buscar(id);
+    if (h == IdIndex::NO_ENCONTRADO) return total;
+    sumarRango(raiz, posicion(static_cast<uint32_t>(2 * h)), posicion(static_cast<uint32_t>(2 * h + 1)), total);
+    return total;
+}
+
+bool ReportingTree::estaEnRama(int jefe, int id) const {
+    const std::size_t hj = indice.buscar(jefe);
+    const std::size_t h = indice.buscar(id);
+    if (hj == IdIndex::NO_ENCONTRADO || h == IdIndex::NO_ENCONTRADO) return false;
+    const uint32_t p = posicion(static_cast<uint32_t>(2 * h));
+    return posicion(static_cast<uint32_t>(2 * hj)) <= p && p <= posicion(static_cast<uint32_t>(2 * hj + 1));
+}
+
+std::vector<int> ReportingTree::subordinados(int id) const {
+    std::vector<int> resultado;
+    const std::size_t h = indice.buscar(id);
+    if (h == IdIndex::NO_ENCONTRADO) return resultado;
+    // Tras cada apertura se salta hasta su cierre: solo quedan los directos
+    const uint32_t cierre = static_cast<uint32_t>(2 * h + 1);
+    for (uint32_t t = sucesor(static_cast<uint32_t>(2 * h)); t != cierre; t = sucesor(t + 1)) {
+        resultado.push_back(ids[t >> 1]);
+    }
+    return resultado;
+}
+
+std::vector<int> ReportingTree::construir(const std::vector<Enlace>& enlaces) {
+    limpiar();
+    const uint32_t n = static_cast<uint32_t>(enlaces.size());
+    std::vector<int> sinJefe;
+    ids.resize(n);
+    salarios.resize(n);
+    nodos.resize(2 * static_cast<std::size_t>(n));
+    indice.reservar(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        ids[i] = enlaces[i].id;
+        salarios[i] = enlaces[i].salario;
+        indice.insertar(enlaces[i].id, i);
+    }
+
+    // Hijos de cada hueco en formato compacto (inicio[h] .. inicio[h + 1])
+    std::vector<uint32_t> jefeDe(n, NULO);
+    std::vector<uint32_t> inicio(n + 1, 0);
+    for (uint32_t i = 0; i < n; ++i) {
+        const int jefe = enlaces[i].jefe;
+        if (jefe == 0) continue;
+        const std::size_t hj = indice.buscar(jefe);
+        if (hj == IdIndex::NO_ENCONTRADO || jefe == enlaces[i].id) {
+            sinJefe.push_back(enlaces[i].id);
+            continue;
+        }
+        jefeDe[i] = static_cast<uint32_t>(hj);
+        ++inicio[hj + 1];
+    }
+    for (uint32_t i = 0; i < n; ++i) inicio[i + 1] += inicio[i];
+    std::vector<uint32_t> hijos(inicio[n]);
+    std::vector<uint32_t> cursor(inicio.begin(), inicio.end() - 1);
+    for (uint32_t i = 0; i < n; ++i) {
+        if (jefeDe[i] != NULO) hijos[cursor[jefeDe[i]]++] = i;
+    }
+
+    // Recorrido de Euler en profundidad, sin recursión
+    enum : uint8_t { PENDIENTE, EN_CAMINO, VISITADO };
+    std::vector<uint8_t> estado(n, PENDIENTE);
+    std::vector<uint32_t> orden;
+    orden.reserve(2 * static_cast<std::size_t>(n));
+    std::vector<std::pair<uint32_t, uint32_t>> pila;   // (hueco, siguiente hijo)
+    auto recorrer = [&](uint32_t r) {
+        estado[r] = VISITADO;
+        orden.push_back(2 * r);
+        pila.push_back({r, inicio[r]});
+        while (!pila.empty()) {
+            const uint32_t h = pila.back().first;
+            if (pila.back().second < inicio[h + 1]) {
+                const uint32_t hijo = hijos[pila.back().second++];
+                if (estado[hijo] == VISITADO) continue;   // cierra un ciclo
+                estado[hijo] = VISITADO;
+                orden.push_back(2 * hijo);
+                pila.push_back({hijo, inicio[hijo]});
+            } else {
+                orden.push_back(2 * h + 1);
+                pila.pop_back();
+            }
+        }
+    };
+    for (uint32_t i = 0; i < n; ++i) {
+        if (jefeDe[i] == NULO) recorrer(i);
+    }
+    // Lo que queda cuelga de un ciclo: se sube por los jefes hasta repetir y
+    // ese empleado, que está en el ciclo, pierde su jefe
+    for (uint32_t i = 0; i < n; ++i) {
+        if (estado[i] == VISITADO) continue;
+        uint32_t h = i;
+        while (estado[h] != EN_CAMINO) {
+            estado[h] = EN_CAMINO;
+            h = jefeDe[h];
+        }
+        jefeDe[h] = NULO;
+        sinJefe.push_back(ids[h]);
+        recorrer(h);
+    }
+
+    // Árbol cartesiano por prioridad en una pasada con pila
+    std::vector<uint32_t> derecha;
+    for (uint32_t t : orden) {
+        nodos[t].prioridad = aleatorio();
+        uint32_t ultimo = NULO;
+        while (!derecha.empty() && nodos[derecha.back()].prioridad < nodos[t].prioridad) {
+            ultimo = derecha.back();
+            derecha.pop_back();
+        }
+        nodos[t].izq = ultimo;
+        if (!derecha.empty()) nodos[derecha.back()].der = t;
+        derecha.push_back(t);
+    }
+    raiz = derecha.empty() ? NULO : derecha.front();
+    recalcularAgregados();
+    return sinJefe;
+}
+
+void ReportingTree::fijarSalario(int id, double salario) {
+    const std::size_t h = indice.buscar(id);
+    if (h != IdIndex::NO_ENCONTRADO) salarios[h] = salario;
+}
+
+void ReportingTree::recalcularAgregados() {
+    if (raiz == NULO) return;
+    // En orden inverso a un recorrido desde la raíz cada hijo va antes que su padre
+    std::vector<uint32_t> pendientes{raiz};
+    std::vector<uint32_t> orden;
+    orden.reserve(nodos.size());
+    while (!pendientes.empty()) {
+        const uint32_t t = pendientes.back();
+        pendientes.pop_back();
+        orden.push_back(t);
+        if (nodos[t].izq != NULO) pendientes.push_back(nodos[t].izq);
+        if (nodos[t].der != NULO) pendientes.push_back(nodos[t].der);
+    }
+    for (auto it = orden.rbegin(); it != orden.rend(); ++it) recalcular(*it);
+    nodos[raiz].padre = NULO;
+}
+
+void ReportingTree::limpiar() {
+    nodos.clear();
+    salarios.clear();
+    ids.clear();
+    libres.clear();
+    indice.limpiar();
+    raiz = NULO;
+}
@@ -0,0 +1,299 @@
+#include "RoaringBitmap.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+inline uint16_t alto(uint32_t v) { return static_cast<uint16_t>(v >> 16); }
+inline uint16_t bajo(uint32_t v) { return static_cast<uint16_t>(v & 0xFFFF); }
+
+inline bool bitActivo(const std::vector<uint64_t>& bits, uint16_t b) {
+    return (bits[b >> 6] >> (b & 63)) & 1u;
+}
+
+uint32_t contarBits(const std::vector<uint64_t>& bits) {
+    uint32_t total = 0;
+    for (uint64_t w : bits) total += static_cast<uint32_t>(__builtin_popcountll(w));
+    return total;
+}
+
+} // namespace
+
+bool RoaringBitmap::Contenedor::contiene(uint16_t b) const {
+    if (esMapa()) return bitActivo(bits, b);
+    return std::binary_search(arreglo.begin(), arreglo.end(), b);
+}
+
+void RoaringBitmap::Contenedor::aMapa() {
+    bits.assign(PALABRAS, 0);
+    for (uint16_t b : arreglo) bits[b >> 6] |= uint64_t{1} << (b & 63);
+    arreglo.clear();
+    arreglo.shrink_to_fit();
+}
+
+void RoaringBitmap::Contenedor::normalizar() {
+    if (esMapa() && cardinalidad <= MAXIMO_ARREGLO) {
+        arreglo.clear();
+        arreglo.reserve(cardinalidad);
+        for (std::size_t w = 0; w < PALABRAS; ++w) {
+            for (uint64_t palabra = bits[w]; palabra != 0; palabra &= palabra - 1) {
+                arreglo.push_back(static_cast<uint16_t>(w * 64 + static_cast<std::size_t>(__builtin_ctzll(palabra))));
+            }
+        }
+        bits.clear();
+        bits.shrink_to_fit();
+    } else if (!esMapa() && arreglo.size() > MAXIMO_ARREGLO) {
+        aMapa();
+    }
+}
+
+RoaringBitmap::Contenedor* RoaringBitmap::buscar(uint16_t clave) {
+    auto it = std::lower_bound(contenedores.begin(), contenedores.end(), clave,
+                               [](const Contenedor& c, uint16_t k) { return c.clave < k; });
+    return (it != contenedores.end() && it->clave == clave) ? &*it : nullptr;
+}
+
+const RoaringBitmap::Contenedor* RoaringBitmap::buscar(uint16_t clave) const {
+    return const_cast<RoaringBitmap*>(this)->buscar(clave);
+}
+
+void RoaringBitmap::agregar(uint32_t valor) {
+    const uint16_t clave = alto(valor);
+    const uint16_t b = bajo(valor);
+    auto it = std::lower_bound(contenedores.begin(), contenedores.end(), clave,
+                               [](const Contenedor& c, uint16_t k) { return c.clave < k; });
+    if (it == contenedores.end() || it->clave != clave) {
+        it = contenedores.insert(it, Contenedor{});
+        it->clave = clave;
+    }
+
+    Contenedor& c = *it;
+    if (c.esMapa()) {
+        uint64_t& palabra = c.bits[b >> 6];
+        const uint64_t mascara = uint64_t{1} << (b & 63);
+        if (!(palabra & mascara)) {
+            palabra |= mascara;
+            ++c.cardinalidad;
+        }
+        return;
+    }
+    // Los IDs suelen llegar en orden creciente: el caso común es añadir al final
+    if (c.arreglo.empty() || c.arreglo.back() < b) {
+        c.arreglo.push_back(b);
+    } else {
+        auto pos = std::lower_bound(c.arreglo.begin(), c.arreglo.end(), b);
+        if (*pos == b) return;
+        c.arreglo.insert(pos, b);
+    }
+    ++c.cardinalidad;
+    if (c.arreglo.size() > MAXIMO_ARREGLO) c.aMapa();
+}
+
+bool RoaringBitmap::quitar(uint32_t valor) {
+    auto it = std::lower_bound(contenedores.begin(), contenedores.end(), alto(valor),
+                               [](const Contenedor& c, uint16_t k) { return c.clave < k; });
+    if (it == contenedores.end() || it->clave != alto(valor)) return false;
+
+    Contenedor& c = *it;
+    const uint16_t b = bajo(valor);
+    if (c.esMapa()) {
+        uint64_t& palabra = c.bits[b >> 6];
+        const uint64_t mascara = uint64_t{1} << (b & 63);
+        if (!(palabra & mascara)) return false;
+        palabra &= ~mascara;
+    } else {
+        auto pos = std::lower_bound(c.arreglo.begin(), c.arreglo.end(), b);
+        if (pos == c.arreglo.end() || *pos != b) return false;
+        c.arreglo.erase(pos);
+    }
+
+    if (--c.cardinalidad == 0) {
+        contenedores.erase(it);
+    } else if (c.esMapa() && c.cardinalidad <= MAXIMO_ARREGLO / 2) {
+        c.normalizar();   // con margen, para no oscilar entre formatos
+    }
+    return true;
+}
+
+bool RoaringBitmap::contiene(uint32_t valor) const {
+    const Contenedor* c = buscar(alto(valor));
+    return c && c->contiene(bajo(valor));
+}
+
+uint64_t RoaringBitmap::cardinalidad() const {
+    uint64_t total = 0;
+    for (const Contenedor& c : contenedores) total += c.cardinalidad;
+    return total;
+}
+
+std::size_t RoaringBitmap::bytesUsados() const {
+    std::size_t total = contenedores.capacity() * sizeof(Contenedor);
+    for (const Contenedor& c : contenedores) {
+        total += c.arreglo.capacity() * sizeof(uint16_t) + c.bits.capacity() * sizeof(uint64_t);
+    }
+    return total;
+}
+
+RoaringBitmap::Contenedor RoaringBitmap::intersecar(const Contenedor& a, const Contenedor& b) {
+    Contenedor r;
+    r.clave = a.clave;
+    if (a.esMapa() && b.esMapa()) {
+        r.bits.resize(PALABRAS);
+        for (std::size_t w = 0; w < PALABRAS; ++w) r.bits[w] = a.bits[w] & b.bits[w];
+        r.cardinalidad = contarBits(r.bits);
+        r.normalizar();
+        return r;
+    }
+    if (!a.esMapa() && !b.esMapa()) {
+        std::set_intersection(a.arreglo.begin(), a.arreglo.end(), b.arreglo.begin(), b.arreglo.end(),
+                              std::back_inserter(r.arreglo));
+    } else {
+        const Contenedor& arreglo = a.esMapa() ? b : a;
+        const Contenedor& mapa = a.esMapa() ? a : b;
+        for (uint16_t v : arreglo.arreglo) {
+            if (bitActivo(mapa.bits, v)) r.arreglo.push_back(v);
+        }
+    }
+    r.cardinalidad = static_cast<uint32_t>(r.arreglo.size());
+    return r;
+}
+
+RoaringBitmap::Contenedor RoaringBitmap::unirContenedores(const Contenedor& a, const Contenedor& b) {
+    Contenedor r;
+    r.clave = a.clave;
+    if (!a.esMapa() && !b.esMapa()) {
+        std::set_union(a.arreglo.begin(), a.arreglo.end(), b.arreglo.begin(), b.arreglo.end(),
+                       std::back_inserter(r.arreglo));
+        r.cardinalidad = static_cast<uint32_t>(r.arreglo.size());
+        r.normalizar();
+        return r;
+    }
+    if (a.esMapa() && b.esMapa()) {
+        r.bits.resize(PALABRAS);
+        for (std::size_t w = 0; w < PALABRAS; ++w) r.bits[w] = a.bits[w] | b.bits[w];
+    } else {
+        const Contenedor& arreglo = a.esMapa() ? b : a;
+        r.bits = (a.esMapa() ? a : b).bits;
+        for (uint16_t v : arreglo.arreglo) r.bits[v >> 6] |= uint64_t{1} << (v & 63);
+    }
+    r.cardinalidad = contarBits(r.bits);
+    return r;
+}
+
+RoaringBitmap::Contenedor RoaringBitmap::restar(const Contenedor& a, const Contenedor& b) {
+    Contenedor r;
+    r.clave = a.clave;
+    if (!a.esMapa()) {
+        if (b.esMapa()) {
+            for (uint16_t v : a.arreglo) {
+                if (!bitActivo(b.bits, v)) r.arreglo.push_back(v);
+            }
+        } else {
+            std::set_difference(a.arreglo.begin(), a.arreglo.end(), b.arreglo.begin(), b.arreglo.end(),
+                                std::back_inserter(r.arreglo));
+        }
+        r.cardinalidad = static_cast<uint32_t>(r.arreglo.size());
+        return r;
+    }
+
+    r.bits = a.bits;
+    if (b.esMapa()) {
+        for (std::size_t w = 0; w < PALABRAS; ++w) r.bits[w] &= ~b.bits[w];
+    } else {
+        for (uint16_t v : b.arreglo) r.bits[v >> 6] &= ~(uint64_t{1} << (v & 63));
+    }
+    r.cardinalidad = contarBits(r.bits);
+    r.normalizar();
+    return r;
+}
+
+uint64_t RoaringBitmap::contarInterseccion(const Contenedor& a, const Contenedor& b) {
+    if (a.esMapa() && b.esMapa()) {
+        uint64_t total = 0;
+        for (std::size_t w = 0; w < PALABRAS; ++w) {
+            total += static_cast<uint64_t>(__builtin_popcountll(a.bits[w] & b.bits[w]));
+        }
+        return total;
+    }
+    uint64_t total = 0;
+    if (!a.esMapa() && !b.esMapa()) {
+        auto i = a.arreglo.begin();
+        auto j = b.arreglo.begin();
+        while (i != a.arreglo.end() && j != b.arreglo.end()) {
+            if (*i < *j) ++i;
+            else if (*j < *i) ++j;
+            else { ++total; ++i; ++j; }
+        }
+        return total;
+    }
+    const Contenedor& arreglo = a.esMapa() ? b : a;
+    const Contenedor& mapa = a.esMapa() ? a : b;
+    for (uint16_t v : arreglo.arreglo) total += bitActivo(mapa.bits, v);
+    return total;
+}
+
+RoaringBitmap RoaringBitmap::interseccion(const RoaringBitmap& a, const RoaringBitmap& b) {
+    RoaringBitmap r;
+    auto i = a.contenedores.begin();
+    auto j = b.contenedores.begin();
+    while (i != a.contenedores.end() && j != b.contenedores.end()) {
+        if (i->clave < j->clave) {
+            ++i;
+        } else if (j->clave < i->clave) {
+            ++j;
+        } else {
+            Contenedor c = intersecar(*i, *j);
+            if (c.cardinalidad > 0) r.contenedores.push_back(std::move(c));
+            ++i;
+            ++j;
+        }
+    }
+    return r;
+}
+
+RoaringBitmap RoaringBitmap::unir(const RoaringBitmap& a, const RoaringBitmap& b) {
+    RoaringBitmap r;
+    auto i = a.contenedores.begin();
+    auto j = b.contenedores.begin();
+    while (i != a.contenedores.end() || j != b.contenedores.end()) {
+        if (j == b.contenedores.end() || (i != a.contenedores.end() && i->clave < j->clave)) {
+            r.contenedores.push_back(*i++);
+        } else if (i == a.contenedores.end() || j->clave < i->clave) {
+            r.contenedores.push_back(*j++);
+        } else {
+            r.contenedores.push_back(unirContenedores(*i++, *j++));
+        }
+    }
+    return r;
+}
+
+RoaringBitmap RoaringBitmap::diferencia(const RoaringBitmap& a, const RoaringBitmap& b) {
+    RoaringBitmap r;
+    auto j = b.contenedores.begin();
+    for (const Contenedor& c : a.contenedores) {
+        while (j != b.contenedores.end() && j->clave < c.clave) ++j;
+        if (j == b.contenedores.end() || j->clave != c.clave) {
+            r.contenedores.push_back(c);
+            continue;
+        }
+        Contenedor resto = restar(c, *j);
+        if (resto.cardinalidad > 0) r.contenedores.push_back(std::move(resto));
+    }
+    return r;
+}
+
+uint64_t RoaringBitmap::cardinalidadInterseccion(const RoaringBitmap& a, const RoaringBitmap& b) {
+    uint64_t total = 0;
+    auto i = a.contenedores.begin();
+    auto j = b.contenedores.begin();
+    while (i != a.contenedores.end() && j != b.contenedores.end()) {
+        if (i->clave < j->clave) {
+            ++i;
+        } else if (j->clave < i->clave) {
+            ++j;
+        } else {
+            total += contarInterseccion(*i++, *j++);
+        }
+    }
+    return total;
+}
@@ -0,0 +1,744 @@
+#include "SalaryKernels.h"
+#include "EmployeeColumns.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace kernels {
+
+namespace {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+constexpr double K_LENGUAJE = EmployeeColumns::BONUS_POR_LENGUAJE;
+constexpr double K_PERSONA = EmployeeColumns::BONUS_POR_PERSONA;
+
+// ─── Versión escalar: define el orden de operaciones de referencia ───
+
+inline double totalEscalar(const ColumnasSalario& c, std::size_t i) {
+    return c.base[i] + c.bonus[i] + K_LENGUAJE * c.lenguajes[i] + K_PERSONA * c.equipos[i];
+}
+
+inline bool coincide(const ColumnasSalario& c, const FiltroSalario& f, std::size_t i) {
+    return (!f.porTipo || c.tipos[i] == f.tipo) &&
+           (!f.porDepartamento || c.departamentos[i] == f.departamento);
+}
+
+inline void pasoKahan(double& suma, double& compensacion, double x) {
+    double y = x - compensacion;
+    double t = suma + y;
+    compensacion = (t - suma) - y;
+    suma = t;
+}
+
+// Carriles de Kahan de un bloque. Las versiones SIMD vuelcan aquí sus
+// registros para procesar la cola con el mismo código escalar.
+struct Carriles {
+    double suma[4] = {0.0, 0.0, 0.0, 0.0};
+    double comp[4] = {0.0, 0.0, 0.0, 0.0};
+
+    double resultado() const { return (suma[0] + suma[1]) + (suma[2] + suma[3]); }
+};
+
+void colaSuma(const ColumnasSalario& c, const FiltroSalario& f, std::size_t inicioBloque,
+              std::size_t desde, std::size_t fin, Carriles& k, ResumenParcial& r) {
+    for (std::size_t i = desde; i < fin; ++i) {
+        if (!coincide(c, f, i)) continue;
+        double x = totalEscalar(c, i);
+        r.cantidad++;
+        r.minimo = std::min(r.minimo, x);
+        r.maximo = std::max(r.maximo, x);
+        std::size_t carril = (i - inicioBloque) & 3;
+        pasoKahan(k.suma[carril], k.comp[carril], x);
+    }
+}
+
+void colaCuadrados(const ColumnasSalario& c, const FiltroSalario& f, double media,
+                   std::size_t inicioBloque, std::size_t desde, std::size_t fin, Carriles& k) {
+    for (std::size_t i = desde; i < fin; ++i) {
+        if (!coincide(c, f, i)) continue;
+        double d = totalEscalar(c, i) - media;
+        std::size_t carril = (i - inicioBloque) & 3;
+        pasoKahan(k.suma[carril], k.comp[carril], d * d);
+    }
+}
+
+inline int cubetaDe(double x, double minimo, double escala, int numCubetas) {
+    double q = (x - minimo) * escala;
+    q = std::min(std::max(q, 0.0), static_cast<double>(numCubetas - 1));
+    return static_cast<int>(q);
+}
+
+void colaHistograma(const ColumnasSalario& c, const FiltroSalario& f, double minimo, double escala,
+                    std::size_t desde, std::size_t fin, std::size_t* cubetas, int numCubetas) {
+    for (std::size_t i = desde; i < fin; ++i) {
+        if (coincide(c, f, i)) {
+            cubetas[cubetaDe(totalEscalar(c, i), minimo, escala, numCubetas)]++;
+        }
+    }
+}
+
+double bloqueSumaEscalar(const ColumnasSalario& c, const FiltroSalario& f,
+                         std::size_t ini, std::size_t fin, ResumenParcial& r) {
+    Carriles k;
+    colaSuma(c, f, ini, ini, fin, k, r);
+    return k.resultado();
+}
+
+double bloqueCuadradosEscalar(const ColumnasSalario& c, const FiltroSalario& f, double media,
+                              std::size_t ini, std::size_t fin) {
+    Carriles k;
+    colaCuadrados(c, f, media, ini, ini, fin, k);
+    return k.resultado();
+}
+
+void histogramaEscalar(const ColumnasSalario& c, const FiltroSalario& f, double minimo,
+                       double escala, std::size_t ini, std::size_t fin,
+                       std::size_t* cubetas, int numCubetas) {
+    colaHistograma(c, f, minimo, escala, ini, fin, cubetas, numCubetas);
+}
+
+#ifdef KERNELS_X86
+
+// ─── SSE2: dos registros de 2 doubles forman los 4 carriles ───
+
+inline __m128d mascaraSse2(const ColumnasSalario& c, const FiltroSalario& f, std::size_t i) {
+    return _mm_castsi128_pd(_mm_set_epi64x(coincide(c, f, i + 1) ? -1 : 0,
+                                           coincide(c, f, i) ? -1 : 0));
+}
+
+inline __m128d totalSse2(const ColumnasSalario& c, std::size_t i) {
+    __m128d langs = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(c.lenguajes + i)));
+    __m128d equipo = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(c.equipos + i)));
+    __m128d x = _mm_add_pd(_mm_loadu_pd(c.base + i), _mm_loadu_pd(c.bonus + i));
+    x = _mm_add_pd(x, _mm_mul_pd(_mm_set1_pd(K_LENGUAJE), langs));
+    return _mm_add_pd(x, _mm_mul_pd(_mm_set1_pd(K_PERSONA), equipo));
+}
+
+inline void kahanSse2(__m128d& s, __m128d& comp, __m128d x) {
+    __m128d y = _mm_sub_pd(x, comp);
+    __m128d t = _mm_add_pd(s, y);
+    comp = _mm_sub_pd(_mm_sub_pd(t, s), y);
+    s = t;
+}
+
+inline __m128d elegirSse2(__m128d mascara, __m128d si, __m128d no) {
+    return _mm_or_pd(_mm_and_pd(mascara, si), _mm_andnot_pd(mascara, no));
+}
+
+// Los carriles fuera del filtro conservan su suma y su compensación,
+// igual que la versión escalar, que simplemente se los salta
+inline void kahanSse2(__m128d& s, __m128d& comp, __m128d x, __m128d mascara) {
+    __m128d y = _mm_sub_pd(x, comp);
+    __m128d t = _mm_add_pd(s, y);
+    comp = elegirSse2(mascara, _mm_sub_pd(_mm_sub_pd(t, s), y), comp);
+    s = elegirSse2(mascara, t, s);
+}
+
+template <bool Filtrado>
+double bloqueSumaSse2(const ColumnasSalario& c, const FiltroSalario& f,
+                      std::size_t ini, std::size_t fin, ResumenParcial& r) {
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    __m128d c0 = _mm_setzero_pd(), c1 = _mm_setzero_pd();
+    __m128d vmin = _mm_set1_pd(INF), vmax = _mm_set1_pd(-INF);
+    const __m128d inf = _mm_set1_pd(INF), menosInf = _mm_set1_pd(-INF);
+    std::size_t cantidad = 0;
+
+    std::size_t i = ini;
+    for (; i + 4 <= fin; i += 4) {
+        __m128d x0 = totalSse2(c, i);
+        __m128d x1 = totalSse2(c, i + 2);
+        if constexpr (Filtrado) {
+            __m128d m0 = mascaraSse2(c, f, i);
+            __m128d m1 = mascaraSse2(c, f, i + 2);
+            cantidad += __builtin_popcount(_mm_movemask_pd(m0)) + __builtin_popcount(_mm_movemask_pd(m1));
+            vmin = _mm_min_pd(vmin, _mm_min_pd(elegirSse2(m0, x0, inf), elegirSse2(m1, x1, inf)));
+            vmax = _mm_max_pd(vmax, _mm_max_pd(elegirSse2(m0, x0, menosInf), elegirSse2(m1, x1, menosInf)));
+            kahanSse2(s0, c0, x0, m0);
+            kahanSse2(s1, c1, x1, m1);
+        } else {
+            cantidad += 4;
+            vmin = _mm_min_pd(vmin, _mm_min_pd(x0, x1));
+            vmax = _mm_max_pd(vmax, _mm_max_pd(x0, x1));
+            kahanSse2(s0, c0, x0);
+            kahanSse2(s1, c1, x1);
+        }
+    }
+
+    Carriles k;
+    _mm_storeu_pd(k.suma, s0);
+    _mm_storeu_pd(k.suma + 2, s1);
+    _mm_storeu_pd(k.comp, c0);
+    _mm_storeu_pd(k.comp + 2, c1);
+    double mn[2], mx[2];
+    _mm_storeu_pd(mn, vmin);
+    _mm_storeu_pd(mx, vmax);
+    r.cantidad += cantidad;
+    r.minimo = std::min(r.minimo, std::min(mn[0], mn[1]));
+    r.maximo = std::max(r.maximo, std::max(mx[0], mx[1]));
+
+    colaSuma(c, f, ini, i, fin, k, r);
+    return k.resultado();
+}
+
+template <bool Filtrado>
+double bloqueCuadradosSse2(const ColumnasSalario& c, const FiltroSalario& f, double media,
+                           std::size_t ini, std::size_t fin) {
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    __m128d c0 = _mm_setzero_pd(), c1 = _mm_setzero_pd();
+    const __m128d vmedia = _mm_set1_pd(media);
+
+    std::size_t i = ini;
+    for (; i + 4 <= fin; i += 4) {
+        __m128d d0 = _mm_sub_pd(totalSse2(c, i), vmedia);
+        __m128d d1 = _mm_sub_pd(totalSse2(c, i + 2), vmedia);
+        __m128d x0 = _mm_mul_pd(d0, d0);
+        __m128d x1 = _mm_mul_pd(d1, d1);
+        if constexpr (Filtrado) {
+            kahanSse2(s0, c0, x0, mascaraSse2(c, f, i));
+            kahanSse2(s1, c1, x1, mascaraSse2(c, f, i + 2));
+        } else {
+            kahanSse2(s0, c0, x0);
+            kahanSse2(s1, c1, x1);
+        }
+    }
+
+    Carriles k;
+    _mm_storeu_pd(k.suma, s0);
+    _mm_storeu_pd(k.suma + 2, s1);
+    _mm_storeu_pd(k.comp, c0);
+    _mm_storeu_pd(k.comp + 2, c1);
+    colaCuadrados(c, f, media, ini, i, fin, k);
+    return k.resultado();
+}
+
+double bloqueSumaSse2Desp(const ColumnasSalario& c, const FiltroSalario& f,
+                          std::size_t ini, std::size_t fin, ResumenParcial& r) {
+    return (f.porTipo || f.porDepartamento) ? bloqueSumaSse2<true>(c, f, ini, fin, r)
+                                            : bloqueSumaSse2<false>(c, f, ini, fin, r);
+}
+
+double bloqueCuadradosSse2Desp(const ColumnasSalario& c, const FiltroSalario& f, double media,
+                               std::size_t ini, std::size_t fin) {
+    return (f.porTipo || f.porDepartamento) ? bloqueCuadradosSse2<true>(c, f, media, ini, fin)
+                                            : bloqueCuadradosSse2<false>(c, f, media, ini, fin);
+}
+
+void histogramaSse2(const ColumnasSalario& c, const FiltroSalario& f, double minimo,
+                    double escala, std::size_t ini, std::size_t fin,
+                    std::size_t* cubetas, int numCubetas) {
+    const __m128d vmin = _mm_set1_pd(minimo), vescala = _mm_set1_pd(escala);
+    const __m128d cero = _mm_setzero_pd(), tope = _mm_set1_pd(numCubetas - 1);
+
+    std::size_t i = ini;
+    for (; i + 2 <= fin; i += 2) {
+        __m128d q = _mm_mul_pd(_mm_sub_pd(totalSse2(c, i), vmin), vescala);
+        q = _mm_min_pd(_mm_max_pd(q, cero), tope);
+        alignas(16) int32_t idx[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(idx), _mm_cvttpd_epi32(q));
+        if (coincide(c, f, i)) cubetas[idx[0]]++;
+        if (coincide(c, f, i + 1)) cubetas[idx[1]]++;
+    }
+    colaHistograma(c, f, minimo, escala, i, fin, cubetas, numCubetas);
+}
+
+// ─── AVX2: un registro de 4 doubles = los 4 carriles ───
+
+__attribute__((target("avx2")))
+inline __m256d totalAvx2(const ColumnasSalario& c, std::size_t i) {
+    __m256d langs = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(c.lenguajes + i)));
+    __m256d equipo = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(c.equipos + i)));
+    __m256d x = _mm256_add_pd(_mm256_loadu_pd(c.base + i), _mm256_loadu_pd(c.bonus + i));
+    x = _mm256_add_pd(x, _mm256_mul_pd(_mm256_set1_pd(K_LENGUAJE), langs));
+    return _mm256_add_pd(x, _mm256_mul_pd(_mm256_set1_pd(K_PERSONA), equipo));
+}
+
+__attribute__((target("avx2")))
+inline __m256d mascaraAvx2(const ColumnasSalario& c, const FiltroSalario& f, std::size_t i) {
+    __m256i m = _mm256_set1_epi64x(-1);
+    if (f.porTipo) {
+        int32_t bytes;
+        std::memcpy(&bytes, c.tipos + i, sizeof(bytes));
+        __m128i tipos = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes));
+        __m128i eq = _mm_cmpeq_epi32(tipos, _mm_set1_epi32(static_cast<int>(f.tipo)));
+        m = _mm256_and_si256(m, _mm256_cvtepi32_epi64(eq));
+    }
+    if (f.porDepartamento) {
+        __m128i dept = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c.departamentos + i));
+        __m128i eq = _mm_cmpeq_epi32(dept, _mm_set1_epi32(static_cast<int>(f.departamento)));
+        m = _mm256_and_si256(m, _mm256_cvtepi32_epi64(eq));
+    }
+    return _mm256_castsi256_pd(m);
+}
+
+__attribute__((target("avx2")))
+inline void kahanAvx2(__m256d& s, __m256d& comp, __m256d x) {
+    __m256d y = _mm256_sub_pd(x, comp);
+    __m256d t = _mm256_add_pd(s, y);
+    comp = _mm256_sub_pd(_mm256_sub_pd(t, s), y);
+    s = t;
+}
+
+__attribute__((target("avx2")))
+inline void kahanAvx2(__m256d& s, __m256d& comp, __m256d x, __m256d mascara) {
+    __m256d y = _mm256_sub_pd(x, comp);
+    __m256d t = _mm256_add_pd(s, y);
+    comp = _mm256_blendv_pd(comp, _mm256_sub_pd(_mm256_sub_pd(t, s), y), mascara);
+    s = _mm256_blendv_pd(s, t, mascara);
+}
+
+template <bool Filtrado>
+__attribute__((target("avx2")))
+double bloqueSumaAvx2(const ColumnasSalario& c, const FiltroSalario& f,
+                      std::size_t ini, std::size_t fin, ResumenParcial& r) {
+    __m256d s = _mm256_setzero_pd(), comp = _mm256_setzero_pd();
+    __m256d vmin = _mm256_set1_pd(INF), vmax = _mm256_set1_pd(-INF);
+    const __m256d inf = _mm256_set1_pd(INF), menosInf = _mm256_set1_pd(-INF);
+    std::size_t cantidad = 0;
+
+    std::size_t i = ini;
+    for (; i + 4 <= fin; i += 4) {
+        __m256d x = totalAvx2(c, i);
+        if constexpr (Filtrado) {
+            __m256d m = mascaraAvx2(c, f, i);
+            cantidad += __builtin_popcount(_mm256_movemask_pd(m));
+            vmin = _mm256_min_pd(vmin, _mm256_blendv_pd(inf, x, m));
+            vmax = _mm256_max_pd(vmax, _mm256_blendv_pd(menosInf, x, m));
+            kahanAvx2(s, comp, x, m);
+        } else {
+            cantidad += 4;
+            vmin = _mm256_min_pd(vmin, x);
+            vmax = _mm256_max_pd(vmax, x);
+            kahanAvx2(s, comp, x);
+        }
+    }
+
+    Carriles k;
+    _mm256_storeu_pd(k.suma, s);
+    _mm256_storeu_pd(k.comp, comp);
+    double mn[4], mx[4];
+    _mm256_storeu_pd(mn, vmin);
+    _mm256_storeu_pd(mx, vmax);
+    r.cantidad += cantidad;
+    r.minimo = std::min(r.minimo, *std::min_element(mn, mn + 4));
+    r.maximo = std::max(r.maximo, *std::max_element(mx, mx + 4));
+
+    colaSuma(c, f, ini, i, fin, k, r);
+    return k.resultado();
+}
+
+template <bool Filtrado>
+__attribute__((target("avx2")))
+double bloqueCuadradosAvx2(const ColumnasSalario& c, const FiltroSalario& f, double media,
+                           std::size_t ini, std::size_t fin) {
+    __m256d s = _mm256_setzero_pd(), comp = _mm256_setzero_pd();
+    const __m256d vmedia = _mm256_set1_pd(media);
+
+    std::size_t i = ini;
+    for (; i + 4 <= fin; i += 4) {
+        __m256d d = _mm256_sub_pd(totalAvx2(c, i), vmedia);
+        __m256d x = _mm256_mul_pd(d, d);
+        if constexpr (Filtrado) {
+            kahanAvx2(s, comp, x, mascaraAvx2(c, f, i));
+        } else {
+            kahanAvx2(s, comp, x);
+        }
+    }
+
+    Carriles k;
+    _mm256_storeu_pd(k.suma, s);
+    _mm256_storeu_pd(k.comp, comp);
+    colaCuadrados(c, f, media, ini, i, fin, k);
+    return k.resultado();
+}
+
+__attribute__((target("avx2")))
+double bloqueSumaAvx2Desp(const ColumnasSalario& c, const FiltroSalario& f,
+                          std::size_t ini, std::size_t fin, ResumenParcial& r) {
+    return (f.porTipo || f.porDepartamento) ? bloqueSumaAvx2<true>(c, f, ini, fin, r)
+                                            : bloqueSumaAvx2<false>(c, f, ini, fin, r);
+}
+
+__attribute__((target("avx2")))
+double bloqueCuadradosAvx2Desp(const ColumnasSalario& c, const FiltroSalario& f, double media,
+                               std::size_t ini, std::size_t fin) {
+    return (f.porTipo || f.porDepartamento) ? bloqueCuadradosAvx2<true>(c, f, media, ini, fin)
+                                            : bloqueCuadradosAvx2<false>(c, f, media, ini, fin);
+}
+
+__attribute__((target("avx2")))
+void histogramaAvx2(const ColumnasSalario& c, const FiltroSalario& f, double minimo,
+                    double escala, std::size_t ini, std::size_t fin,
+                    std::size_t* cubetas, int numCubetas) {
+    const bool filtrado = f.porTipo || f.porDepartamento;
+    const __m256d vmin = _mm256_set1_pd(minimo), vescala = _mm256_set1_pd(escala);
+    const __m256d cero = _mm256_setzero_pd(), tope = _mm256_set1_pd(numCubetas - 1);
+
+    std::size_t i = ini;
+    for (; i + 4 <= fin; i += 4) {
+        __m256d q = _mm256_mul_pd(_mm256_sub_pd(totalAvx2(c, i), vmin), vescala);
+        q = _mm256_min_pd(_mm256_max_pd(q, cero), tope);
+        alignas(16) int32_t idx[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(idx), _mm256_cvttpd_epi32(q));
+        int bits = filtrado ? _mm256_movemask_pd(mascaraAvx2(c, f, i)) : 0xF;
+        for (int j = 0; j < 4; ++j) {
+            if (bits & (1 << j)) cubetas[idx[j]]++;
+        }
+    }
+    colaHistograma(c, f, minimo, escala, i, fin, cubetas, numCubetas);
+}
+
+#endif // KERNELS_X86
+
+// ─── Despacho ───
+
+using FnSuma = double (*)(const ColumnasSalario&, const FiltroSalario&,
+                          std::size_t, std::size_t, ResumenParcial&);
+using FnCuadrados = double (*)(const ColumnasSalario&, const FiltroSalario&, double,
+                               std::size_t, std::size_t);
+using FnHistograma = void (*)(const ColumnasSalario&, const FiltroSalario&, double, double,
+                              std::size_t, std::size_t, std::size_t*, int);
+
+struct TablaNucleos {
+    FnSuma suma;
+    FnCuadrados cuadrados;
+    FnHistograma histograma;
+};
+
+TablaNucleos tablaPara(NivelSimd nivel) {
+    switch (nivel) {
+#ifdef KERNELS_X86
+        case NivelSimd::AVX2:
+            return {bloqueSumaAvx2Desp, bloqueCuadradosAvx2Desp, histogramaAvx2};
+        case NivelSimd::SSE2:
+            return {bloqueSumaSse2Desp, bloqueCuadradosSse2Desp, histogramaSse2};
+#endif
+        default:
+            return {bloqueSumaEscalar, bloqueCuadradosEscalar, histogramaEscalar};
+    }
+}
+
+NivelSimd detectar() {
+#ifdef KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return NivelSimd::AVX2;
+    if (__builtin_cpu_supports("sse2")) return NivelSimd::SSE2;
+#endif
+    return NivelSimd::Escalar;
+}
+
+struct Despacho {
+    NivelSimd detectado = detectar();
+    NivelSimd activo = detectado;
+    TablaNucleos tabla = tablaPara(activo);
+};
+
+Despacho& despacho() {
+    static Despacho d;
+    return d;
+}
+
+} // namespace
+
+NivelSimd nivelDetectado() { return despacho().detectado; }
+NivelSimd nivelActivo() { return despacho().activo; }
+
+void forzarNivel(NivelSimd nivel) {
+    Despacho& d = despacho();
+    d.activo = std::min(nivel, d.detectado);
+    d.tabla = tablaPara(d.activo);
+}
+
+const char* nombreNivel(NivelSimd nivel) {
+    switch (nivel) {
+        case NivelSimd::AVX2: return "AVX2";
+        case NivelSimd::SSE2: return "SSE2";
+        default: return "escalar";
+    }
+}
+
+void ResumenParcial::combinar(const ResumenParcial& otro) {
+    cantidad += otro.cantidad;
+    minimo = std::min(minimo, otro.minimo);
+    maximo = std::max(maximo, otro.maximo);
+}
+
+void sumarBloques(const ColumnasSalario& c, const FiltroSalario& f,
+                  std::size_t primerBloque, std::size_t finBloque,
+                  double* sumas, ResumenParcial& resumen) {
+    FnSuma fn = despacho().tabla.suma;
+    for (std::size_t b = primerBloque; b < finBloque; ++b) {
+        std::size_t ini = b * ELEMENTOS_POR_BLOQUE;
+        std::size_t fin = std::min(ini + ELEMENTOS_POR_BLOQUE, c.n);
+        sumas[b - primerBloque] = fn(c, f, ini, fin, resumen);
+    }
+}
+
+void sumarCuadradosBloques(const ColumnasSalario& c, const FiltroSalario& f, double media,
+                           std::size_t primerBloque, std::size_t finBloque, double* sumas) {
+    FnCuadrados fn = despacho().tabla.cuadrados;
+    for (std::size_t b = primerBloque; b < finBloque; ++b) {
+        std::size_t ini = b * ELEMENTOS_POR_BLOQUE;
+        std::size_t fin = std::min(ini + ELEMENTOS_POR_BLOQUE, c.n);
+        sumas[b - primerBloque] = fn(c, f, media, ini, fin);
+    }
+}
+
+void acumularHistograma(const ColumnasSalario& c, const FiltroSalario& f,
+                        double minimo, double maximo, std::size_t inicio, std::size_t fin,
+                        std::size_t* cubetas, int numCubetas) {
+    double rango = maximo - minimo;
+    double escala = rango > 0.0 ? numCubetas / rango : 0.0;
+    despacho().tabla.histograma(c, f, minimo, escala, inicio, fin, cubetas, numCubetas);
+}
+
+double sumaPorParejas(const double* sumas, std::size_t cantidad) {
+    if (cantidad == 0) return 0.0;
+
+    // Nivel a nivel: (0,1), (2,3)...; un elemento impar sube sin tocar
+    std::vector<double> nivel(sumas, sumas + cantidad);
+    std::size_t m = cantidad;
+    while (m > 1) {
+        std::size_t k = 0;
+        for (std::size_t i = 0; i + 1 < m; i += 2) {
+            nivel[k++] = nivel[i] + nivel[i + 1];
+        }
+        if (m % 2 == 1) nivel[k++] = nivel[m - 1];
+        m = k;
+    }
+    return nivel[0];
+}
+
+namespace {
+
+// Reparte [0, bloques) en tramos contiguos y llama a tramo(primerBloque, finBloque, tarea).
+// Devuelve el número de tareas usadas, para dimensionar los parciales.
+std::size_t numeroTareas(std::size_t bloques, ThreadPool* pool) {
+    if (!pool || bloques < 2) return 1;
+    return std::min(bloques, static_cast<std::size_t>(pool->getTrabajadores() + 1) * 4);
+}
+
+void paraCadaTramo(std::size_t bloques, std::size_t tareas, ThreadPool* pool,
+                   const std::function<void(std::size_t, std::size_t, std::size_t)>& tramo) {
+    auto ejecutarTarea = [&](std::size_t t) {
+        tramo(bloques * t / tareas, bloques * (t + 1) / tareas, t);
+    };
+    if (tareas == 1) {
+        ejecutarTarea(0);
+    } else {
+        pool->ejecutar(tareas, ejecutarTarea);
+    }
+}
+
+// Suma de cada bloque y resumen combinado, en serie o repartido entre hilos
+ResumenParcial sumasDeBloques(const ColumnasSalario& c, const FiltroSalario& f,
+                              ThreadPool* pool, std::vector<double>& sumas) {
+    std::size_t bloques = numeroBloques(c.n);
+    std::size_t tareas = numeroTareas(bloques, pool);
+    sumas.assign(bloques, 0.0);
+    std::vector<ResumenParcial> parciales(tareas);
+
+    paraCadaTramo(bloques, tareas, pool, [&](std::size_t b0, std::size_t b1, std::size_t t) {
+        sumarBloques(c, f, b0, b1, sumas.data() + b0, parciales[t]);
+    });
+
+    ResumenParcial total;
+    for (const ResumenParcial& p : parciales) total.combinar(p);
+    return total;
+}
+
+void cuadradosDeBloques(const ColumnasSalario& c, const FiltroSalario& f, double media,
+                        ThreadPool* pool, std::vector<double>& sumas) {
+    std::size_t bloques = numeroBloques(c.n);
+    sumas.assign(bloques, 0.0);
+    paraCadaTramo(bloques, numeroTareas(bloques, pool), pool,
+                  [&](std::size_t b0, std::size_t b1, std::size_t) {
+                      sumarCuadradosBloques(c, f, media, b0, b1, sumas.data() + b0);
+                  });
+}
+
+} // namespace
+
+double sumaTotal(const ColumnasSalario& c, const FiltroSalario& f, ThreadPool* pool) {
+    std::vector<double> sumas;
+    sumasDeBloques(c, f, pool, sumas);
+    return sumaPorParejas(sumas.data(), sumas.size());
+}
+
+EstadisticasSalario calcularEstadisticas(const ColumnasSalario& c, const FiltroSalario& f,
+                                         ThreadPool* pool) {
+    std::vector<double> sumas;
+    ResumenParcial resumen = sumasDeBloques(c, f, pool, sumas);
+
+    EstadisticasSalario e;
+    if (resumen.cantidad == 0) return e;
+
+    e.cantidad = resumen.cantidad;
+    e.suma = sumaPorParejas(sumas.data(), sumas.size());
+    e.minimo = resumen.minimo;
+    e.maximo = resumen.maximo;
+    e.media = e.suma / e.cantidad;
+
+    // Segunda pasada sobre las desviaciones: más estable que sum(x²) - n·media²
+    cuadradosDeBloques(c, f, e.media, pool, sumas);
+    e.varianza = sumaPorParejas(sumas.data(), sumas.size()) / e.cantidad;
+    return e;
+}
+
+std::vector<std::size_t> calcularHistograma(const ColumnasSalario& c, const FiltroSalario& f,
+                                            double minimo, double maximo, int numCubetas,
+                                            ThreadPool* pool) {
+    if (numCubetas <= 0) return {};
+
+    std::size_t bloques = numeroBloques(c.n);
+    std::size_t tareas = numeroTareas(bloques, pool);
+    std::vector<std::vector<std::size_t>> parciales(tareas, std::vector<std::size_t>(numCubetas, 0));
+
+    paraCadaTramo(bloques, tareas, pool, [&](std::size_t b0, std::size_t b1, std::size_t t) {
+        acumularHistograma(c, f, minimo, maximo, b0 * ELEMENTOS_POR_BLOQUE,
+                           std::min(b1 * ELEMENTOS_POR_BLOQUE, c.n), parciales[t].data(), numCubetas);
+    });
+
+    std::vector<std::size_t> cubetas(numCubetas, 0);
+    for (const auto& parcial : parciales) {
+        for (int k = 0; k < numCubetas; ++k) cubetas[k] += parcial[k];
+    }
+    return cubetas;
+}
+
+namespace {
+
+inline uint32_t grupoDe(const ColumnasSalario& c, Agrupacion agrupacion, std::size_t i) {
+    return agrupacion == Agrupacion::PorTipo ? static_cast<uint32_t>(c.tipos[i]) : c.departamentos[i];
+}
+
+// Una pasada por bloque con 4 carriles de Kahan por grupo. Cada grupo ve la
+// misma secuencia de pasos que con un filtro, por eso el resultado coincide.
+// Con 'medias' suma (x - media)² en lugar de x.
+void bloquesPorGrupo(const ColumnasSalario& c, Agrupacion agrupacion, std::size_t numGrupos,
+                     const double* medias, std::size_t b0, std::size_t b1,
+                     double* sumas, ResumenParcial* resumenes) {
+    std::vector<Carriles> carriles(numGrupos);
+    for (std::size_t b = b0; b < b1; ++b) {
+        std::fill(carriles.begin(), carriles.end(), Carriles());
+        std::size_t ini = b * ELEMENTOS_POR_BLOQUE;
+        std::size_t fin = std::min(ini + ELEMENTOS_POR_BLOQUE, c.n);
+
+        for (std::size_t i = ini; i < fin; ++i) {
+            uint32_t g = grupoDe(c, agrupacion, i);
+            if (g >= numGrupos) continue;
+            double x = totalEscalar(c, i);
+            if (medias) {
+                double d = x - medias[g];
+                x = d * d;
+            } else {
+                ResumenParcial& r = resumenes[g];
+                r.cantidad++;
+                r.minimo = std::min(r.minimo, x);
+                r.maximo = std::max(r.maximo, x);
+            }
+            std::size_t carril = (i - ini) & 3;
+            pasoKahan(carriles[g].suma[carril], carriles[g].comp[carril], x);
+        }
+
+        for (std::size_t g = 0; g < numGrupos; ++g) {
+            sumas[b * numGrupos + g] = carriles[g].resultado();
+        }
+    }
+}
+
+} // namespace
+
+std::vector<EstadisticasSalario> estadisticasPorGrupo(const ColumnasSalario& c, Agrupacion agrupacion,
+                                                      std::size_t numGrupos, ThreadPool* pool) {
+    std::vector<EstadisticasSalario> resultado(numGrupos);
+    if (numGrupos == 0) return resultado;
+
+    std::size_t bloques = numeroBloques(c.n);
+    std::size_t tareas = numeroTareas(bloques, pool);
+    std::vector<double> sumas(bloques * numGrupos, 0.0);       // [bloque][grupo]
+    std::vector<ResumenParcial> parciales(tareas * numGrupos);  // [tarea][grupo]
+
+    paraCadaTramo(bloques, tareas, pool, [&](std::size_t b0, std::size_t b1, std::size_t t) {
+        bloquesPorGrupo(c, agrupacion, numGrupos, nullptr, b0, b1,
+                        sumas.data(), parciales.data() + t * numGrupos);
+    });
+
+    std::vector<double> columnaGrupo(bloques);
+    std::vector<double> medias(numGrupos, 0.0);
+    for (std::size_t g = 0; g < numGrupos; ++g) {
+        ResumenParcial r;
+        for (std::size_t t = 0; t < tareas; ++t) r.combinar(parciales[t * numGrupos + g]);
+        if (r.cantidad == 0) continue;
+
+        for (std::size_t b = 0; b < bloques; ++b) columnaGrupo[b] = sumas[b * numGrupos + g];
+        EstadisticasSalario& e = resultado[g];
+        e.cantidad = r.cantidad;
+        e.suma = sumaPorParejas(columnaGrupo.data(), bloques);
+        e.minimo = r.minimo;
+        e.maximo = r.maximo;
+        e.media = e.suma / e.cantidad;
+        medias[g] = e.media;
+    }
+
+    paraCadaTramo(bloques, tareas, pool, [&](std::size_t b0, std::size_t b1, std::size_t) {
+        bloquesPorGrupo(c, agrupacion, numGrupos, medias.data(), b0, b1, sumas.data(), nullptr);
+    });
+
+    for (std::size_t g = 0; g < numGrupos; ++g) {
+        EstadisticasSalario& e = resultado[g];
+        if (e.cantidad == 0) continue;
+        for (std::size_t b = 0; b < bloques; ++b) columnaGrupo[b] = sumas[b * numGrupos + g];
+        e.varianza = sumaPorParejas(columnaGrupo.data(), bloques) / e.cantidad;
+    }
+    return resultado;
+}
+
+void calcularMasivo(const ColumnasSalario& c, const FiltroMasivo& f, bool sobreBonus,
+                    double factor, double sumando, std::vector<uint32_t>& posiciones,
+                    std::vector<double>& valores, ThreadPool* pool) {
+    std::size_t bloques = numeroBloques(c.n);
+    std::size_t tareas = numeroTareas(bloques, pool);
+    std::vector<std::vector<uint32_t>> posicionesTarea(tareas);
+    std::vector<std::vector<double>> valoresTarea(tareas);
+    const double* campo = sobreBonus ? c.bonus : c.base;
+
+    paraCadaTramo(bloques, tareas, pool, [&](std::size_t b0, std::size_t b1, std::size_t t) {
+        const std::size_t ini = b0 * ELEMENTOS_POR_BLOQUE;
+        const std::size_t fin = std::min(b1 * ELEMENTOS_POR_BLOQUE, c.n);
+        std::vector<uint32_t>& pos = posicionesTarea[t];
+        std::vector<double>& val = valoresTarea[t];
+        pos.resize(fin - ini);
+        val.resize(fin - ini);
+
+        // Compactación sin saltos: se escribe siempre y solo avanza si coincide
+        std::size_t k = 0;
+        for (std::size_t i = ini; i < fin; ++i) {
+            const bool elegido = coincide(c, f.grupo, i) & (c.equipos[i] >= f.equipoMinimo) &
+                                 (c.base[i] >= f.baseMinima) & (c.base[i] <= f.baseMaxima);
+            pos[k] = static_cast<uint32_t>(i);
+            val[k] = std::max(0.0, campo[i] * factor + sumando);
+            k += elegido;
+        }
+        pos.resize(k);
+        val.resize(k);
+    });
+
+    std::size_t total = 0;
+    for (const auto& pos : posicionesTarea) total += pos.size();
+    posiciones.clear();
+    valores.clear();
+    posiciones.reserve(total);
+    valores.reserve(total);
+    for (std::size_t t = 0; t < tareas; ++t) {
+        posiciones.insert(posiciones.end(), posicionesTarea[t].begin(), posicionesTarea[t].end());
+        valores.insert(valores.end(), valoresTarea[t].begin(), valoresTarea[t].end());
+    }
+}
+
+} // namespace kernels
@@ -0,0 +1,362 @@
+#include "Snapshot.h"
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace snapshot {
+
+namespace {
+
+constexpr uint64_t FNV_BASE = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIMO = 1099511628211ull;
+constexpr std::size_t ALINEACION = 8;
+
+// La cabecera de la versión 1 no tiene la entrada de JEFES
+constexpr uint32_t VERSION_SIN_JEFES = 1;
+constexpr std::size_t TAMANO_CABECERA_V1 = offsetof(CabeceraSnapshot, secciones) + JEFES * sizeof(uint64_t);
+
+std::size_t alinear(std::size_t n) {
+    return (n + ALINEACION - 1) & ~(ALINEACION - 1);
+}
+
+// Copia una columna al final de la imagen, alineada, y devuelve su desplazamiento
+template <typename T>
+uint64_t anadirSeccion(std::vector<char>& imagen, const T* datos, std::size_t cantidad) {
+    std::size_t inicio = alinear(imagen.size());
+    imagen.resize(inicio + cantidad * sizeof(T));
+    if (cantidad > 0) std::memcpy(imagen.data() + inicio, datos, cantidad * sizeof(T));
+    return inicio;
+}
+
+template <typename T>
+const T* verSeccion(const char* base, uint64_t desplazamiento) {
+    return reinterpret_cast<const T*>(base + desplazamiento);
+}
+
+} // namespace
+
+bool esSnapshot(std::string_view datos) {
+    return datos.size() >= sizeof(MAGIA) && std::memcmp(datos.data(), MAGIA, sizeof(MAGIA)) == 0;
+}
+
+uint64_t checksum(const char* datos, std::size_t tamano) {
+    uint64_t h = FNV_BASE;
+    std::size_t i = 0;
+    for (; i + 8 <= tamano; i += 8) {
+        uint64_t palabra;
+        std::memcpy(&palabra, datos + i, 8);
+        h = (h ^ palabra) * FNV_PRIMO;
+    }
+    for (; i < tamano; ++i) {
+        h = (h ^ static_cast<unsigned char>(datos[i])) * FNV_PRIMO;
+    }
+    return h;
+}
+
+// ---------------------------------------------------------------- Escritor
+
+void Escritor::reservar(std::size_t empleados) {
+    ids.reserve(empleados);
+    tipos.reserve(empleados);
+    salariosBase.reserve(empleados);
+    bonus.reserve(empleados);
+    equipos.reserve(empleados);
+    nombres.reserve(empleados);
+    apellidos.reserve(empleados);
+    departamentos.reserve(empleados);
+    lengInicio.reserve(empleados + 1);
+    jefes.reserve(empleados);
+}
+
+void Escritor::agregar(const RegistroTexto& r) {
+    ids.push_back(r.id);
+    tipos.push_back(static_cast<uint8_t>(r.tipo));
+    salariosBase.push_back(r.salarioBase);
+    bonus.push_back(r.bonus);
+    equipos.push_back(r.equipo);
+    nombres.push_back(cadenas.internar(r.nombre));
+    apellidos.push_back(cadenas.internar(r.apellido));
+    departamentos.push_back(cadenas.internar(r.departamento));
+    jefes.push_back(r.jefe);
+    lengInicio.push_back(lengInicio.back());
+    paraCadaLenguaje(r.lenguajes, [&](std::string_view lang) { agregarLenguaje(lang); });
+}
+
+void Escritor::agregarLenguaje(std::string_view lenguaje) {
+    lenguajes.push_back(cadenas.internar(lenguaje));
+    ++lengInicio.back();
+}
+
+std::vector<char> Escritor::construirImagen(int siguienteId) const {
+    CabeceraSnapshot cabecera{};
+    std::memcpy(cabecera.magia, MAGIA, sizeof(MAGIA));
+    cabecera.version = VERSION;
+    cabecera.marcaOrden = MARCA_ORDEN;
+    cabecera.numEmpleados = ids.size();
+    cabecera.numCadenas = cadenas.size();
+    cabecera.numLenguajes = lenguajes.size();
+    cabecera.siguienteId = siguienteId;
+
+    std::vector<uint64_t> cadenasInicio;
+    cadenasInicio.reserve(cadenas.size() + 1);
+    cadenasInicio.push_back(0);
+    for (StringInterner::Simbolo s = 0; s < cadenas.size(); ++s) {
+        cadenasInicio.push_back(cadenasInicio.back() + cadenas.texto(s).size());
+    }
+
+    std::vector<char> imagen(sizeof(CabeceraSnapshot));
+    imagen.reserve(sizeof(CabeceraSnapshot) + ids.size() * 52 + cadenasInicio.back() * 2);
+
+    uint64_t* sec = cabecera.secciones;
+    sec[IDS] = anadirSeccion(imagen, ids.data(), ids.size());
+    sec[TIPOS] = anadirSeccion(imagen, tipos.data(), tipos.size());
+    sec[SALARIOS_BASE] = anadirSeccion(imagen, salariosBase.data(), salariosBase.size());
+    sec[BONUS] = anadirSeccion(imagen, bonus.data(), bonus.size());
+    sec[EQUIPOS] = anadirSeccion(imagen, equipos.data(), equipos.size());
+    sec[NOMBRES] = anadirSeccion(imagen, nombres.data(), nombres.size());
+    sec[APELLIDOS] = anadirSeccion(imagen, apellidos.data(), apellidos.size());
+    sec[DEPARTAMENTOS] = anadirSeccion(imagen, departamentos.data(), departamentos.size());
+    sec[LENG_INICIO] = anadirSeccion(imagen, lengInicio.data(), lengInicio.size());
+    sec[LENGUAJES] = anadirSeccion(imagen, lenguajes.data(), lenguajes.size());
+    sec[CADENAS_INICIO] = anadirSeccion(imagen, cadenasInicio.data(), cadenasInicio.size());
+
+    sec[CADENAS_DATOS] = imagen.size();
+    imagen.resize(imagen.size() + cadenasInicio.back());
+    char* destino = imagen.data() + sec[CADENAS_DATOS];
+    for (StringInterner::Simbolo s = 0; s < cadenas.size(); ++s) {
+        std::string_view texto = cadenas.texto(s);
+        if (!texto.empty()) std::memcpy(destino, texto.data(), texto.size());
+        destino += texto.size();
+    }
+    sec[JEFES] = anadirSeccion(imagen, jefes.data(), jefes.size());
+
+    cabecera.tamanoTotal = imagen.size();
+    cabecera.checksum = checksum(imagen.data() + sizeof(CabeceraSnapshot),
+                                 imagen.size() - sizeof(CabeceraSnapshot));
+    std::memcpy(imagen.data(), &cabecera, sizeof(cabecera));
+    return imagen;
+}
+
+bool Escritor::guardar(const std::string& ruta, int siguienteId, std::string& error) const {
+    std::vector<char> imagen = construirImagen(siguienteId);
+    std::string temporal = ruta + ".tmp";
+    std::FILE* archivo = std::fopen(temporal.c_str(), "wb");
+    if (!archivo) {
+        error = "no se pudo crear " + temporal;
+        return false;
+    }
+    bool escrito = std::fwrite(imagen.data(), 1, imagen.size(), archivo) == imagen.size() &&
+                   std::fflush(archivo) == 0;
+    // Los datos deben estar en disco antes del renombrado, o un corte podría dejar un archivo vacío
+#ifdef _WIN32
+    escrito = escrito && _commit(_fileno(archivo)) == 0;
+#else
+    escrito = escrito && ::fsync(::fileno(archivo)) == 0;
+#endif
+    std::fclose(archivo);
+    if (!escrito) {
+        error = "error de escritura en " + temporal;
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporal, ruta, ec);
+    if (ec) {
+        error = "no se pudo renombrar " + temporal + ": " + ec.message();
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------- Lector
+
+bool Lector::abrir(std::string_view imagen, std::string& error) {
+    if (imagen.size() < TAMANO_CABECERA_V1 || !esSnapshot(imagen)) {
+        error = "no es una instantánea válida";
+        return false;
+    }
+    cabecera = CabeceraSnapshot{};
+    std::memcpy(&cabecera, imagen.data(), TAMANO_CABECERA_V1);
+
+    if (cabecera.marcaOrden != MARCA_ORDEN) {
+        error = "orden de bytes incompatible";
+        return false;
+    }
+    if (cabecera.version != VERSION && cabecera.version != VERSION_SIN_JEFES) {
+        error = "versión " + std::to_string(cabecera.version) + " no soportada";
+        return false;
+    }
+    const uint32_t numSecciones = cabecera.version == VERSION_SIN_JEFES ? JEFES : NUM_SECCIONES;
+    const std::size_t tamanoCabecera = offsetof(CabeceraSnapshot, secciones) + numSecciones * sizeof(uint64_t);
+    if (imagen.size() < tamanoCabecera) {
+        error = "archivo truncado";
+        return false;
+    }
+    std::memcpy(&cabecera, imagen.data(), tamanoCabecera);
+    if (cabecera.tamanoTotal != imagen.size()) {
+        error = "archivo truncado";
+        return false;
+    }
+    if (reinterpret_cast<std::uintptr_t>(imagen.data()) % ALINEACION != 0) {
+        error = "imagen no alineada en memoria";
+        return false;
+    }
+
+    // Cotas previas para que los productos de abajo no desborden
+    if (cabecera.numEmpleados > imagen.size() || cabecera.numCadenas > imagen.size() ||
+        cabecera.numLenguajes > imagen.size()) {
+        error = "cabecera corrupta";
+        return false;
+    }
+
+    // Cada sección empieza alineada, en orden, y cabe antes de la siguiente
+    const uint64_t n = cabecera.numEmpleados;
+    const uint64_t tamanos[NUM_SECCIONES] = {
+        n * sizeof(int32_t), n * sizeof(uint8_t), n * sizeof(double), n * sizeof(double),
+        n * sizeof(int32_t), n * sizeof(uint32_t), n * sizeof(uint32_t), n * sizeof(uint32_t),
+        (n + 1) * sizeof(uint32_t), cabecera.numLenguajes * sizeof(uint32_t),
+        (cabecera.numCadenas + 1) * sizeof(uint64_t), 0, n * sizeof(int32_t)};
+    uint64_t limite = tamanoCabecera;
+    for (uint32_t s = 0; s < numSecciones; ++s) {
+        uint64_t inicio = cabecera.secciones[s];
+        if (inicio < limite || (inicio % ALINEACION != 0 && s != CADENAS_DATOS) ||
+            inicio > imagen.size() || tamanos[s] > imagen.size() - inicio) {
+            error = "sección " + std::to_string(s) + " fuera de rango";
+            return false;
+        }
+        limite = inicio + tamanos[s];
+    }
+
+    if (checksum(imagen.data() + tamanoCabecera, imagen.size() - tamanoCabecera) != cabecera.checksum) {
+        error = "checksum incorrecto";
+        return false;
+    }
+
+    base = imagen.data();
+    const uint64_t* sec = cabecera.secciones;
+    ids = verSeccion<int32_t>(base, sec[IDS]);
+    tipos = verSeccion<uint8_t>(base, sec[TIPOS]);
+    salariosBase = verSeccion<double>(base, sec[SALARIOS_BASE]);
+    bonus = verSeccion<double>(base, sec[BONUS]);
+    equipos = verSeccion<int32_t>(base, sec[EQUIPOS]);
+    nombres = verSeccion<uint32_t>(base, sec[NOMBRES]);
+    apellidos = verSeccion<uint32_t>(base, sec[APELLIDOS]);
+    departamentos = verSeccion<uint32_t>(base, sec[DEPARTAMENTOS]);
+    lengInicio = verSeccion<uint32_t>(base, sec[LENG_INICIO]);
+    lenguajes = verSeccion<uint32_t>(base, sec[LENGUAJES]);
+    cadenasInicio = verSeccion<uint64_t>(base, sec[CADENAS_INICIO]);
+    cadenasDatos = base + sec[CADENAS_DATOS];
+    jefes = numSecciones > JEFES ? verSeccion<int32_t>(base, sec[JEFES]) : nullptr;
+
+    // Los índices se comprueban una vez aquí para que los accesos no necesiten hacerlo
+    const uint64_t finCadenas = jefes ? sec[JEFES] : imagen.size();
+    const uint64_t datosCadenas = finCadenas - sec[CADENAS_DATOS];
+    for (uint64_t k = 0; k < cabecera.numCadenas; ++k) {
+        if (cadenasInicio[k] > cadenasInicio[k + 1] || cadenasInicio[k + 1] > datosCadenas) {
+            error = "tabla de cadenas corrupta";
+            return false;
+        }
+    }
+    if (cadenasInicio[0] != 0 || lengInicio[0] != 0 || lengInicio[n] != cabecera.numLenguajes) {
+        error = "índices de inicio corruptos";
+        return false;
+    }
+    for (uint64_t i = 0; i < n; ++i) {
+        if (tipos[i] > static_cast<uint8_t>(TipoEmpleado::Manager) || lengInicio[i] > lengInicio[i + 1] ||
+            nombres[i] >= cabecera.numCadenas || apellidos[i] >= cabecera.numCadenas ||
+            departamentos[i] >= cabecera.numCadenas) {
+            error = "registro " + std::to_string(i) + " corrupto";
+            return false;
+        }
+    }
+    for (uint64_t k = 0; k < cabecera.numLenguajes; ++k) {
+        if (lenguajes[k] >= cabecera.numCadenas) {
+            error = "lenguaje " + std::to_string(k) + " corrupto";
+            return false;
+        }
+    }
+    return true;
+}
+
+RegistroTexto Lector::registro(std::size_t i) const {
+    RegistroTexto r;
+    r.tipo = static_cast<TipoEmpleado>(tipos[i]);
+    r.id = ids[i];
+    r.nombre = cadena(nombres[i]);
+    r.apellido = cadena(apellidos[i]);
+    r.salarioBase = salariosBase[i];
+    r.departamento = cadena(departamentos[i]);
+    r.bonus = bonus[i];
+    r.equipo = equipos[i];
+    r.jefe = jefes ? jefes[i] : 0;
+    r.lenguajes = std::string_view();
+    r.linea = i + 1;
+    return r;
+}
+
+// ---------------------------------------------------------------- Conversores
+
+bool convertirTextoASnapshot(const std::string& rutaTexto, const std::string& rutaSnapshot, std::string& error) {
+    MappedFile archivo(rutaTexto);
+    if (!archivo.abierto()) {
+        error = "no se pudo abrir " + rutaTexto;
+        return false;
+    }
+
+    ResultadoAnalisis resultado = analizarEmpleados(archivo.contenido());
+    if (!resultado.errores.empty()) {
+        const ErrorLinea& e = resultado.errores.front();
+        error = rutaTexto + ", línea " + std::to_string(e.linea) + ": " + e.motivo;
+        return false;
+    }
+
+    Escritor escritor;
+    escritor.reservar(resultado.registros.size());
+    int siguienteId = 1;
+    for (const RegistroTexto& r : resultado.registros) {
+        escritor.agregar(r);
+        if (r.id >= siguienteId) siguienteId = r.id + 1;
+    }
+    return escritor.guardar(rutaSnapshot, siguienteId, error);
+}
+
+bool convertirSnapshotATexto(const std::string& rutaSnapshot, const std::string& rutaTexto, std::string& error) {
+    MappedFile archivo(rutaSnapshot);
+    if (!archivo.abierto()) {
+        error = "no se pudo abrir " + rutaSnapshot;
+        return false;
+    }
+
+    Lector lector;
+    if (!lector.abrir(archivo.contenido(), error)) return false;
+
+    std::string texto;
+    std::string lenguajes;
+    for (std::size_t i = 0; i < lector.size(); ++i) {
+        RegistroTexto r = lector.registro(i);
+        lenguajes.clear();
+        unirLenguajes([&](auto&& f) { lector.paraCadaLenguaje(i, f); }, lenguajes);
+        r.lenguajes = lenguajes;
+        formatearRegistro(r, texto);
+        texto += '\n';
+    }
+
+    std::ofstream salida(rutaTexto, std::ios::binary | std::ios::trunc);
+    if (!salida.is_open()) {
+        error = "no se pudo crear " + rutaTexto;
+        return false;
+    }
+    salida.write(texto.data(), static_cast<std::streamsize>(texto.size()));
+    return static_cast<bool>(salida);
+}
+
+} // namespace snapshot
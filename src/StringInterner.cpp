@@ -0,0 +1,18 @@
+#include "StringInterner.h"
+
+StringInterner::Simbolo StringInterner::internar(std::string_view texto) {
+    auto it = simbolos.find(texto);
+    if (it != simbolos.end()) {
+        return it->second;
+    }
+
+    Simbolo nuevo = static_cast<Simbolo>(textos.size());
+    textos.emplace_back(texto);
+    simbolos.emplace(textos.back(), nuevo);
+    return nuevo;
+}
+
+StringInterner::Simbolo StringInterner::buscar(std::string_view texto) const {
+    auto it = simbolos.find(texto);
+    return it == simbolos.end() ? NINGUNO : it->second;
+}
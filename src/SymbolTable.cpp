@@ -0,0 +1,52 @@
+#include "SymbolTable.h"
+
+SymbolTable& SymbolTable::global() {
+    // Nunca se destruye, para que los empleados estáticos puedan leerla al final
+    static SymbolTable* tabla = new SymbolTable();
+    return *tabla;
+}
+
+SymbolTable::SymbolTable()
+    : bloques(std::make_unique<std::atomic<std::string_view*>[]>(MAX_BLOQUES)) {
+    for (std::size_t i = 0; i < MAX_BLOQUES; ++i) {
+        bloques[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+SymbolTable::~SymbolTable() {
+    for (std::size_t i = 0; i < MAX_BLOQUES; ++i) {
+        delete[] bloques[i].load(std::memory_order_relaxed);
+    }
+}
+
+SymbolTable::Simbolo SymbolTable::internar(std::string_view texto) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = simbolos.find(texto);
+    if (it != simbolos.end()) {
+        return it->second;
+    }
+
+    Simbolo nuevo = static_cast<Simbolo>(cantidad.load(std::memory_order_relaxed));
+    std::string_view* bloque = bloques[nuevo >> BITS_BLOQUE].load(std::memory_order_relaxed);
+    if (!bloque) {
+        bloque = new std::string_view[MASCARA_BLOQUE + 1];
+        bloques[nuevo >> BITS_BLOQUE].store(bloque, std::memory_order_release);
+    }
+
+    std::string_view copia = textos.copiar(texto);
+    bloque[nuevo & MASCARA_BLOQUE] = copia;
+    simbolos.emplace(copia, nuevo);
+    cantidad.store(nuevo + 1, std::memory_order_release);
+    return nuevo;
+}
+
+SymbolTable::Simbolo SymbolTable::buscar(std::string_view texto) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = simbolos.find(texto);
+    return it == simbolos.end() ? NINGUNO : it->second;
+}
+
+std::size_t SymbolTable::bytesTextos() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return textos.bytesReservados();
+}
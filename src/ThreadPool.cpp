@@ -0,0 +1,105 @@
+#include "ThreadPool.h"
+#include <exception>
+
+ThreadPool::ThreadPool(unsigned trabajadores)
+    : pendientes(0), terminar(false) {
+    // Una cola más que trabajadores: la del hilo que llama a ejecutar()
+    for (unsigned i = 0; i <= trabajadores; ++i) {
+        colas.push_back(std::make_unique<Cola>());
+    }
+    for (unsigned i = 0; i < trabajadores; ++i) {
+        hilos.emplace_back(&ThreadPool::bucleTrabajador, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutexEspera);
+        terminar = true;
+    }
+    hayTrabajo.notify_all();
+    for (std::thread& hilo : hilos) {
+        hilo.join();
+    }
+}
+
+bool ThreadPool::ejecutarUna(std::size_t colaPropia) {
+    std::function<void()> tarea;
+
+    for (std::size_t k = 0; k < colas.size() && !tarea; ++k) {
+        Cola& cola = *colas[(colaPropia + k) % colas.size()];
+        std::lock_guard<std::mutex> lock(cola.mutex);
+        if (cola.tareas.empty()) continue;
+
+        // La cola propia se atiende por el final (LIFO), las ajenas se roban por el principio
+        if (k == 0) {
+            tarea = std::move(cola.tareas.back());
+            cola.tareas.pop_back();
+        } else {
+            tarea = std::move(cola.tareas.front());
+            cola.tareas.pop_front();
+        }
+    }
+
+    if (!tarea) return false;
+    pendientes--;
+    tarea();
+    return true;
+}
+
+void ThreadPool::bucleTrabajador(std::size_t indice) {
+    while (true) {
+        if (ejecutarUna(indice)) continue;
+
+        std::unique_lock<std::mutex> lock(mutexEspera);
+        hayTrabajo.wait(lock, [this] { return terminar || pendientes > 0; });
+        if (terminar && pendientes == 0) return;
+    }
+}
+
+void ThreadPool::ejecutar(std::size_t numTareas, const std::function<void(std::size_t)>& tarea) {
+    if (numTareas == 0) return;
+
+    struct Estado {
+        std::atomic<std::size_t> restantes;
+        std::mutex mutex;
+        std::condition_variable terminado;
+        std::exception_ptr error;
+    } estado;
+    estado.restantes = numTareas;
+
+    {
+        std::lock_guard<std::mutex> lock(mutexEspera);
+        pendientes += numTareas;
+    }
+
+    // Reparto inicial en bloques contiguos; el robo equilibra el resto
+    std::size_t porCola = (numTareas + colas.size() - 1) / colas.size();
+    for (std::size_t i = 0; i < numTareas; ++i) {
+        Cola& cola = *colas[i / porCola];
+        std::lock_guard<std::mutex> lock(cola.mutex);
+        cola.tareas.emplace_back([&estado, &tarea, i] {
+            try {
+                tarea(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lockError(estado.mutex);
+                if (!estado.error) estado.error = std::current_exception();
+            }
+            // Se descuenta bajo el mutex: el llamador no destruye 'estado'
+            // hasta poder tomarlo, es decir, hasta que la última tarea lo suelte
+            std::lock_guard<std::mutex> lockFin(estado.mutex);
+            if (--estado.restantes == 0) estado.terminado.notify_all();
+        });
+    }
+    hayTrabajo.notify_all();
+
+    // El llamador usa la última cola y ayuda hasta que no quede nada que robar
+    std::size_t colaLlamador = colas.size() - 1;
+    while (estado.restantes > 0) {
+        if (!ejecutarUna(colaLlamador)) break;
+    }
+
+    std::unique_lock<std::mutex> lock(estado.mutex);
+    estado.terminado.wait(lock, [&estado] { return estado.restantes == 0; });
+    if (estado.error) std::rethrow_exception(estado.error);
+}
@@ -0,0 +1,155 @@
+#include "VersionedStore.h"
+#include <algorithm>
+#include <limits>
+
+VersionedStore::Instantanea& VersionedStore::Instantanea::operator=(Instantanea&& otra) noexcept {
+    if (this != &otra) {
+        soltar();
+        version = otra.version;
+        ranura = otra.ranura;
+        otra.version = nullptr;
+        otra.ranura = nullptr;
+    }
+    return *this;
+}
+
+void VersionedStore::Instantanea::soltar() {
+    if (ranura) {
+        // 'release': las lecturas de la versión terminan antes de que el dueño vea la ranura libre
+        ranura->store(0, std::memory_order_release);
+    }
+    version = nullptr;
+    ranura = nullptr;
+}
+
+VersionedStore::VersionedStore() : ranuras(new std::atomic<uint64_t>[MAX_INSTANTANEAS]) {
+    for (std::size_t i = 0; i < MAX_INSTANTANEAS; ++i) ranuras[i].store(0, std::memory_order_relaxed);
+}
+
+VersionedStore::~VersionedStore() {
+    // Lo retirado no está en 'bloques' ni en 'ultima', así nada se libera dos veces
+    for (Bloque* b : bloques) delete b;
+    for (const Retirado& r : retirados) {
+        delete r.bloque;
+        delete r.version;
+    }
+    delete ultima;
+}
+
+void VersionedStore::cambiar() {
+    // La última publicada deja de ser la actual: se retira con su propia época
+    if (ultima) {
+        retirados.push_back({ultima->numero, nullptr, ultima});
+        ultima = nullptr;
+    }
+}
+
+VersionedStore::Registro& VersionedStore::escribible(std::size_t pos) {
+    cambiar();
+    const std::size_t k = pos / REGISTROS_POR_BLOQUE;
+    if (compartido[k]) {
+        Bloque* copia = new Bloque(*bloques[k]);
+        retirados.push_back({epoca, bloques[k], nullptr});
+        bloques[k] = copia;
+        compartido[k] = false;
+        ++copias;
+    }
+    return bloques[k]->registros[pos % REGISTROS_POR_BLOQUE];
+}
+
+void VersionedStore::agregar(const Registro& r) {
+    if (cantidad % REGISTROS_POR_BLOQUE == 0) {
+        cambiar();
+        bloques.push_back(new Bloque);
+        compartido.push_back(false);
+    }
+    escribible(cantidad) = r;
+    ++cantidad;
+}
+
+void VersionedStore::actualizar(std::size_t pos, const Registro& r) {
+    escribible(pos) = r;
+}
+
+void VersionedStore::quitar(std::size_t pos) {
+    const std::size_t ultimo = cantidad - 1;
+    if (pos != ultimo) {
+        const Registro movido = bloques[ultimo / REGISTROS_POR_BLOQUE]->registros[ultimo % REGISTROS_POR_BLOQUE];
+        escribible(pos) = movido;
+    } else {
+        cambiar();
+    }
+    --cantidad;
+
+    // El último bloque quedó vacío
+    if (cantidad % REGISTROS_POR_BLOQUE == 0) {
+        if (compartido.back()) {
+            retirados.push_back({epoca, bloques.back(), nullptr});
+        } else {
+            delete bloques.back();
+        }
+        bloques.pop_back();
+        compartido.pop_back();
+    }
+}
+
+void VersionedStore::setSiguienteId(int id) {
+    if (id == siguienteId) return;
+    cambiar();
+    siguienteId = id;
+}
+
+VersionedStore::Instantanea VersionedStore::fijar() {
+    recoger();
+    if (!ultima) {
+        Version* v = new Version{++epoca, cantidad, siguienteId, {}};
+        v->bloques.assign(bloques.begin(), bloques.end());
+        std::fill(compartido.begin(), compartido.end(), true);
+        ultima = v;
+    }
+
+    // Solo el dueño ocupa ranuras, así que no compite con nadie al elegir una
+    for (std::size_t i = 0; i < MAX_INSTANTANEAS; ++i) {
+        if (ranuras[i].load(std::memory_order_acquire) == 0) {
+            ranuras[i].store(ultima->numero, std::memory_order_relaxed);
+            return Instantanea(ultima, &ranuras[i]);
+        }
+    }
+    return Instantanea();
+}
+
+void VersionedStore::recoger() {
+    if (retirados.empty()) return;
+    uint64_t minima = std::numeric_limits<uint64_t>::max();
+    for (std::size_t i = 0; i < MAX_INSTANTANEAS; ++i) {
+        const uint64_t e = ranuras[i].load(std::memory_order_acquire);
+        if (e != 0) minima = std::min(minima, e);
+    }
+
+    // Retirado en la época e: lo ven como mucho las versiones <= e
+    auto libres = std::partition(retirados.begin(), retirados.end(),
+                                 [minima](const Retirado& r) { return r.epoca >= minima; });
+    for (auto it = libres; it != retirados.end(); ++it) {
+        delete it->bloque;
+        delete it->version;
+    }
+    retirados.erase(libres, retirados.end());
+}
+
+VersionedStore::Estadisticas VersionedStore::estadisticas() const {
+    Estadisticas e;
+    e.version = epoca;
+    for (std::size_t i = 0; i < MAX_INSTANTANEAS; ++i) {
+        e.instantaneasActivas += ranuras[i].load(std::memory_order_relaxed) != 0;
+    }
+    e.bloques = bloques.size();
+    e.bloquesCompartidos = static_cast<std::size_t>(std::count(compartido.begin(), compartido.end(), true));
+    e.copiasEnEscritura = copias;
+    e.retirados = retirados.size();
+    e.bytesActuales = bloques.size() * sizeof(Bloque) + bloques.capacity() * sizeof(Bloque*);
+    if (ultima) e.bytesActuales += sizeof(Version) + ultima->bloques.capacity() * sizeof(const Bloque*);
+    for (const Retirado& r : retirados) {
+        e.bytesRetenidos += r.bloque ? sizeof(Bloque) : sizeof(Version) + r.version->bloques.capacity() * sizeof(const Bloque*);
+    }
+    return e;
+}
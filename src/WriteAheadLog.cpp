@@ -0,0 +1,303 @@
+#include "WriteAheadLog.h"
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::size_t CABECERA_REGISTRO = 4 + 4 + 1;
+
+const std::array<uint32_t, 256>& tablaCrc() {
+    static const std::array<uint32_t, 256> tabla = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    return tabla;
+}
+
+uint32_t crc32(uint32_t crc, const char* datos, std::size_t tamano) {
+    const std::array<uint32_t, 256>& tabla = tablaCrc();
+    crc = ~crc;
+    for (std::size_t i = 0; i < tamano; ++i) {
+        crc = tabla[(crc ^ static_cast<unsigned char>(datos[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+bool sincronizarDisco(std::FILE* archivo) {
+    if (std::fflush(archivo) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(archivo)) == 0;
+#else
+    return ::fsync(::fileno(archivo)) == 0;
+#endif
+}
+
+} // namespace
+
+void EntradaDiario::leerValor(std::size_t i, int& idValor, double& valor) const {
+    int32_t id32;
+    const char* p = valores.data() + i * TAMANO_VALOR;
+    std::memcpy(&id32, p, 4);
+    std::memcpy(&valor, p + 4, 8);
+    idValor = id32;
+}
+
+WriteAheadLog::WriteAheadLog(const std::string& ruta, std::chrono::milliseconds intervalo)
+    : ruta(ruta), intervalo(intervalo) {
+    archivo = std::fopen(ruta.c_str(), "ab");
+    if (!archivo) return;
+
+    std::error_code ec;
+    const std::uintmax_t tamano = std::filesystem::file_size(ruta, ec);
+    anotados = durables = ec ? 0 : tamano;
+    escritor = std::thread(&WriteAheadLog::bucleEscritor, this);
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    // Tras una rotación que no pudo reabrir, el hilo sigue vivo sin archivo
+    if (escritor.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            terminar = true;
+        }
+        hayDatos.notify_one();
+        escritor.join();
+    }
+    if (archivo) std::fclose(archivo);
+}
+
+void WriteAheadLog::anotar(OperacionDiario operacion, const char* datos, std::size_t tamano) {
+    char cabecera[CABECERA_REGISTRO];
+    uint32_t longitud = static_cast<uint32_t>(tamano);
+    char tipo = static_cast<char>(operacion);
+    uint32_t crc = crc32(crc32(0, &tipo, 1), datos, tamano);
+    std::memcpy(cabecera, &longitud, 4);
+    std::memcpy(cabecera + 4, &crc, 4);
+    cabecera[8] = tipo;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!archivo || !errorEscritura.empty()) return;
+    pendiente.append(cabecera, CABECERA_REGISTRO);
+    pendiente.append(datos, tamano);
+    anotados += CABECERA_REGISTRO + tamano;
+}
+
+void WriteAheadLog::anotarPoner(std::string_view linea) {
+    anotar(OperacionDiario::Poner, linea.data(), linea.size());
+}
+
+void WriteAheadLog::anotarBorrado(int id) {
+    int32_t valor = id;
+    char datos[4];
+    std::memcpy(datos, &valor, 4);
+    anotar(OperacionDiario::Borrar, datos, sizeof(datos));
+}
+
+void WriteAheadLog::anotarSalario(int id, double salario) {
+    int32_t valor = id;
+    char datos[12];
+    std::memcpy(datos, &valor, 4);
+    std::memcpy(datos + 4, &salario, 8);
+    anotar(OperacionDiario::Salario, datos, sizeof(datos));
+}
+
+void WriteAheadLog::anotarJefe(int id, int jefe) {
+    int32_t valores[2] = {id, jefe};
+    char datos[8];
+    std::memcpy(datos, valores, 8);
+    anotar(OperacionDiario::Jefe, datos, sizeof(datos));
+}
+
+void WriteAheadLog::anotarDepartamento(int id, std::string_view departamento) {
+    anotarTexto(OperacionDiario::Departamento, id, departamento);
+}
+
+void WriteAheadLog::anotarLenguaje(int id, std::string_view lenguaje) {
+    anotarTexto(OperacionDiario::Lenguaje, id, lenguaje);
+}
+
+void WriteAheadLog::anotarTexto(OperacionDiario operacion, int id, std::string_view texto) {
+    int32_t valor = id;
+    std::string datos(4 + texto.size(), '\0');
+    std::memcpy(datos.data(), &valor, 4);
+    std::memcpy(datos.data() + 4, texto.data(), texto.size());
+    anotar(operacion, datos.data(), datos.size());
+}
+
+void WriteAheadLog::anotarMasiva(CampoMasivo campo, const int* ids, const double* valores, std::size_t cantidad) {
+    std::string datos(1 + cantidad * EntradaDiario::TAMANO_VALOR, '\0');
+    datos[0] = static_cast<char>(campo);
+    char* p = datos.data() + 1;
+    for (std::size_t i = 0; i < cantidad; ++i, p += EntradaDiario::TAMANO_VALOR) {
+        int32_t id = ids[i];
+        std::memcpy(p, &id, 4);
+        std::memcpy(p + 4, &valores[i], 8);
+    }
+    anotar(OperacionDiario::Masiva, datos.data(), datos.size());
+}
+
+bool WriteAheadLog::sincronizar(std::string& error) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!archivo) {
+        error = "diario no abierto";
+        return false;
+    }
+    const std::uint64_t objetivo = anotados;
+    while (durables < objetivo && errorEscritura.empty()) {
+        if (!escribiendo) {
+            volcar(lock);
+        } else {
+            escrito.wait(lock);
+        }
+    }
+    if (!errorEscritura.empty()) {
+        error = errorEscritura;
+        return false;
+    }
+    return true;
+}
+
+std::uint64_t WriteAheadLog::bytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return anotados;
+}
+
+bool WriteAheadLog::rotar(const std::string& destino, std::string& error) {
+    if (!archivo) {
+        error = "diario no abierto";
+        return false;
+    }
+    // Si falla, lo que no llegó al disco sigue en memoria y la instantánea
+    // que acompaña a la rotación lo incluye
+    std::string errorSincronizacion;
+    sincronizar(errorSincronizacion);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    escrito.wait(lock, [this] { return !escribiendo; });
+    std::fclose(archivo);
+    archivo = nullptr;
+
+    std::error_code ec;
+    std::filesystem::rename(ruta, destino, ec);
+    if (ec) error = "no se pudo renombrar " + ruta + ": " + ec.message();
+
+    // Tras un fallo se sigue anexando al mismo segmento
+    archivo = std::fopen(ruta.c_str(), "ab");
+    if (!archivo) {
+        error = "no se pudo reabrir " + ruta;
+        terminar = true;
+        hayDatos.notify_one();
+        return false;
+    }
+    if (!ec) {
+        anotados = durables = 0;
+        errorEscritura.clear();
+    }
+    return !ec;
+}
+
+void WriteAheadLog::volcar(std::unique_lock<std::mutex>& lock) {
+    // Se escribe fuera del cerrojo para que anotar() no espere al disco
+    std::string lote;
+    lote.swap(pendiente);
+    const std::uint64_t hasta = anotados;
+    escribiendo = true;
+    lock.unlock();
+
+    errno = 0;
+    bool ok = std::fwrite(lote.data(), 1, lote.size(), archivo) == lote.size() && sincronizarDisco(archivo);
+    const int codigo = errno;
+
+    lock.lock();
+    escribiendo = false;
+    if (ok) {
+        durables = hasta;
+    } else if (errorEscritura.empty()) {
+        // Lo anotado mientras tanto ya no puede ser durable en este segmento
+        errorEscritura = "error de escritura en " + ruta + (codigo ? ": " + std::string(std::strerror(codigo)) : "");
+        pendiente.clear();
+    }
+    escrito.notify_all();
+}
+
+void WriteAheadLog::bucleEscritor() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        hayDatos.wait_for(lock, intervalo, [this] { return terminar; });
+        if (!pendiente.empty() && !escribiendo && errorEscritura.empty()) {
+            volcar(lock);
+        }
+        if (terminar && pendiente.empty() && !escribiendo) return;
+    }
+}
+
+std::size_t WriteAheadLog::reproducir(std::string_view datos,
+                                      const std::function<void(const EntradaDiario&)>& aplicar) {
+    std::size_t pos = 0;
+    while (datos.size() - pos >= CABECERA_REGISTRO) {
+        uint32_t longitud, crc;
+        std::memcpy(&longitud, datos.data() + pos, 4);
+        std::memcpy(&crc, datos.data() + pos + 4, 4);
+        if (longitud > datos.size() - pos - CABECERA_REGISTRO) break;
+        if (crc32(0, datos.data() + pos + 8, 1 + longitud) != crc) break;
+
+        const char* cuerpo = datos.data() + pos + CABECERA_REGISTRO;
+        EntradaDiario entrada{static_cast<OperacionDiario>(datos[pos + 8]), 0, 0.0, 0, {}, CampoMasivo::SalarioBase, {}, {}};
+        int32_t id = 0;
+        switch (entrada.operacion) {
+            case OperacionDiario::Poner:
+                entrada.linea = std::string_view(cuerpo, longitud);
+                break;
+            case OperacionDiario::Borrar:
+                if (longitud != 4) return pos;
+                std::memcpy(&id, cuerpo, 4);
+                break;
+            case OperacionDiario::Salario:
+                if (longitud != 12) return pos;
+                std::memcpy(&id, cuerpo, 4);
+                std::memcpy(&entrada.salario, cuerpo + 4, 8);
+                break;
+            case OperacionDiario::Jefe: {
+                if (longitud != 8) return pos;
+                int32_t jefe;
+                std::memcpy(&id, cuerpo, 4);
+                std::memcpy(&jefe, cuerpo + 4, 4);
+                entrada.jefe = jefe;
+                break;
+            }
+            case OperacionDiario::Departamento:
+            case OperacionDiario::Lenguaje:
+                if (longitud < 4) return pos;
+                std::memcpy(&id, cuerpo, 4);
+                entrada.texto = std::string_view(cuerpo + 4, longitud - 4);
+                break;
+            case OperacionDiario::Masiva:
+                if (longitud < 1 || (longitud - 1) % EntradaDiario::TAMANO_VALOR != 0 ||
+                    static_cast<uint8_t>(cuerpo[0]) > static_cast<uint8_t>(CampoMasivo::Bonus)) {
+                    return pos;
+                }
+                entrada.campo = static_cast<CampoMasivo>(cuerpo[0]);
+                entrada.valores = std::string_view(cuerpo + 1, longitud - 1);
+                break;
+            default:
+                return pos;
+        }
+        entrada.id = id;
+        aplicar(entrada);
+        pos += CABECERA_REGISTRO + longitud;
+    }
+    return pos;
+}
@@ -1,8 +1,18 @@
 #include "EmployeeManager.h"
+#include "Snapshot.h"
+#include "Metrics.h"
+#include "BatchProcessor.h"
+#include "QueryServer.h"
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <limits>
 #include <vector>
 #include <iomanip>
+#include <thread>
 
 // Función para limpiar el buffer de entrada
 void limpiarBuffer() {
@@ -18,7 +28,7 @@ void mostrarMenu() {
     std::cout << "║  1. Agregar Developer                         ║\n";
     std::cout << "║  2. Agregar Manager                           ║\n";
     std::cout << "║  3. Listar todos los empleados                ║\n";
-    std::cout << "║  4. Buscar empleado por ID                    ║\n";
+    std::cout << "║  4. Buscar empleado por ID o nombre           ║\n";
     std::cout << "║  5. Modificar salario                         ║\n";
     std::cout << "║  6. Eliminar empleado                         ║\n";
     std::cout << "║  7. Ver empleados por departamento            ║\n";
@@ -31,7 +41,7 @@ void mostrarMenu() {
 void agregarDeveloper(EmployeeManager& manager) {
     std::string nombre, apellido, departamento, lenguaje;
     double salarioBase, bonus;
-    int numLenguajes;
+    int numLenguajes, jefe;
 
     std::cout << "\n--- Agregar Developer ---\n";
     std::cout << "Nombre: ";
@@ -57,14 +67,16 @@ void agregarDeveloper(EmployeeManager& manager) {
 
     std::cout << "Bonus por proyectos: $";
     std::cin >> bonus;
+    std::cout << "ID del jefe (0 = ninguno): ";
+    std::cin >> jefe;
 
-    manager.agregarDeveloper(nombre, apellido, salarioBase, departamento, lenguajes, bonus);
+    manager.agregarDeveloper(nombre, apellido, salarioBase, departamento, lenguajes, bonus, jefe);
 }
 
 void agregarManager(EmployeeManager& manager) {
     std::string nombre, apellido, departamento;
     double salarioBase, bonus;
-    int equipo;
+    int jefe;
 
     std::cout << "\n--- Agregar Manager ---\n";
     std::cout << "Nombre: ";
@@ -76,19 +88,37 @@ void agregarManager(EmployeeManager& manager) {
     limpiarBuffer();
     std::cout << "Departamento: ";
     std::getline(std::cin, departamento);
-    std::cout << "Personas en el equipo: ";
-    std::cin >> equipo;
     std::cout << "Bonus de gestión: $";
     std::cin >> bonus;
+    std::cout << "ID del jefe (0 = ninguno): ";
+    std::cin >> jefe;
 
-    manager.agregarManager(nombre, apellido, salarioBase, departamento, equipo, bonus);
+    manager.agregarManager(nombre, apellido, salarioBase, departamento, bonus, jefe);
 }
 
 void buscarEmpleado(EmployeeManager& manager) {
-    int id;
-    std::cout << "\nIngrese ID del empleado: ";
-    std::cin >> id;
-    manager.buscarEmpleado(id);
+    std::string consulta;
+    limpiarBuffer();
+    std::cout << "\nIngrese ID o nombre del empleado: ";
+    std::getline(std::cin, consulta);
+
+    char* fin = nullptr;
+    long id = std::strtol(consulta.c_str(), &fin, 10);
+    if (!consulta.empty() && *fin == '\0') {
+        manager.buscarEmpleado(static_cast<int>(id));
+        return;
+    }
+
+    // Por nombre: tolera acentos y erratas ("gonzales" encuentra a González)
+    auto coincidencias = manager.buscarPorNombre(consulta);
+    if (coincidencias.empty()) {
+        std::cout << "❌ No se encontraron empleados con el nombre '" << consulta << "'\n";
+        return;
+    }
+    for (const auto& [emp, puntuacion] : coincidencias) {
+        std::cout << "\n🔎 Coincidencia " << std::lround(puntuacion * 100) << "%\n";
+        emp->mostrarInfo();
+    }
 }
 
 void modificarSalario(EmployeeManager& manager) {
@@ -114,10 +144,179 @@ void calcularNomina(EmployeeManager& manager) {
     std::cout << "  NÓMINA TOTAL DE LA EMPRESA: $" << std::fixed << std::setprecision(2) << total << "\n";
     std::cout << "  Total de empleados: " << manager.getCantidadEmpleados() << "\n";
     std::cout << "═══════════════════════════════════════════════\n";
+    manager.informeEstadisticas();
+}
+
+// Conversión entre texto e instantánea sin abrir el menú:
+//   --a-snapshot <texto> <snapshot>   |   --a-texto <snapshot> <texto>
+int convertirFormato(const std::string& opcion, const std::string& origen, const std::string& destino) {
+    std::string error;
+    bool ok = (opcion == "--a-snapshot") ? snapshot::convertirTextoASnapshot(origen, destino, error)
+                                         : snapshot::convertirSnapshotATexto(origen, destino, error);
+    if (!ok) {
+        std::cerr << "❌ " << error << "\n";
+        return 1;
+    }
+    std::cout << "✅ " << origen << " -> " << destino << "\n";
+    return 0;
+}
+
+// Vuelca las métricas al salir: --metricas <archivo.prom|archivo.json|->
+void volcarMetricas(const std::string& destino) {
+    std::string error;
+    if (!metricas::volcar(destino, metricas::formatoPorRuta(destino), error)) {
+        std::cerr << "❌ Métricas: " << error << "\n";
+    }
+}
+
+// Modo sin menú: --lote <comandos|-> (ver BatchProcessor.h). Las respuestas
+// van a la salida estándar; avisos y el resumen de rendimiento, a la de error.
+int ejecutarLote(EmployeeManager& manager, const std::string& origen) {
+    std::FILE* entrada = (origen == "-") ? stdin : std::fopen(origen.c_str(), "rb");
+    if (!entrada) {
+        std::cerr << "❌ No se pudo abrir " << origen << "\n";
+        return 1;
+    }
+
+    BatchProcessor procesador(manager, stdout);
+    bool ok = procesador.ejecutar(entrada);
+    if (entrada != stdin) std::fclose(entrada);
+
+    const ResumenLote& r = procesador.getResumen();
+    for (const ErrorLinea& e : procesador.getErrores()) {
+        std::cerr << "⚠️  Línea " << e.linea << ": " << e.motivo << "\n";
+    }
+    std::cerr << "✅ " << r.operaciones << " operaciones en " << std::fixed << std::setprecision(3)
+              << r.segundos << " s (" << std::setprecision(0) << r.operacionesPorSegundo() << " ops/s)\n"
+              << "   altas " << r.altas << ", bajas " << r.bajas << ", salarios " << r.cambiosSalario
+              << ", consultas " << r.consultas << ", informes " << r.informes
+              << ", no encontrados " << r.noEncontrados << ", errores " << r.errores << "\n";
+    if (!ok) {
+        std::cerr << "❌ Error de lectura en " << origen << "\n";
+        return 1;
+    }
+    // Los cambios del lote solo cuentan si llegan al disco
+    if (!(manager.getCambiosSinGuardar() > 0 ? manager.guardarEnArchivo() : manager.esperarGuardado())) {
+        return 1;
+    }
+    return r.errores == 0 ? 0 : 2;
+}
+
+// Listado completo sin menú: --informe <tabla|csv|jsonl> (ver ReportWriter.h)
+int escribirInforme(const EmployeeManager& manager, const std::string& nombreFormato) {
+    FormatoInforme formato;
+    if (!formatoInformePorNombre(nombreFormato, formato)) {
+        std::cerr << "❌ Formato de informe desconocido '" << nombreFormato << "' (tabla, csv o jsonl)\n";
+        return 1;
+    }
+    ReportWriter informe(stdout, formato);
+    informe.empezar();
+    manager.escribirInforme(informe);
+    if (!informe.terminar()) {
+        std::cerr << "❌ Error al escribir el informe\n";
+        return 1;
+    }
+    return 0;
 }
 
-int main() {
-    EmployeeManager manager("data/empleados.txt");
+// Modo servidor: --servidor unix:/ruta | tcp:puerto (ver QueryServer.h)
+QueryServer* servidorActivo = nullptr;
+
+extern "C" void alRecibirSenal(int) {
+    if (servidorActivo) servidorActivo->detener();
+}
+
+int ejecutarServidor(EmployeeManager& manager, const std::string& direccion) {
+    QueryServer servidor(manager);
+    std::string error;
+    if (!servidor.escuchar(direccion, error)) {
+        std::cerr << "❌ " << error << "\n";
+        return 1;
+    }
+    servidorActivo = &servidor;
+    std::signal(SIGINT, alRecibirSenal);
+    std::signal(SIGTERM, alRecibirSenal);
+    std::cout << "🌐 Escuchando en " << direccion << " (Ctrl+C para terminar)" << std::endl;
+
+    bool ok = servidor.ejecutar(error);
+    servidorActivo = nullptr;
+    std::cout << "👋 Servidor detenido: " << servidor.getPeticiones() << " peticiones, "
+              << servidor.getConexiones() << " conexiones, "
+              << servidor.getSincronizaciones() << " sincronizaciones del diario\n";
+    if (!ok) {
+        std::cerr << "❌ " << error << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 4 && (std::string(argv[1]) == "--a-snapshot" || std::string(argv[1]) == "--a-texto")) {
+        return convertirFormato(argv[1], argv[2], argv[3]);
+    }
+
+    // Archivo de trabajo opcional; con una instantánea (.snap) se activa el diario
+    std::string archivo = "data/empleados.txt";
+    std::string destinoMetricas;
+    std::string origenLote;
+    std::string direccionServidor;
+    std::string formatoInforme;
+    long autoguardado = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--metricas" && i + 1 < argc) {
+            destinoMetricas = argv[++i];
+        } else if (arg == "--lote" && i + 1 < argc) {
+            origenLote = argv[++i];
+        } else if (arg == "--servidor" && i + 1 < argc) {
+            direccionServidor = argv[++i];
+        } else if (arg == "--autoguardado" && i + 1 < argc) {
+            autoguardado = std::strtol(argv[++i], nullptr, 10);
+        } else if (arg == "--informe" && i + 1 < argc) {
+            formatoInforme = argv[++i];
+        } else {
+            archivo = arg;
+        }
+    }
+
+    if (!origenLote.empty()) {
+        // La salida estándar queda solo para las respuestas
+        std::cout.rdbuf(std::cerr.rdbuf());
+        int codigo;
+        {
+            EmployeeManager manager(archivo, std::thread::hardware_concurrency());
+            manager.setAutoguardado(std::chrono::seconds(autoguardado));
+            codigo = ejecutarLote(manager, origenLote);
+        }
+        if (!destinoMetricas.empty()) volcarMetricas(destinoMetricas);
+        return codigo;
+    }
+
+    if (!formatoInforme.empty()) {
+        // Como en --lote, los mensajes de carga no se mezclan con el listado
+        std::cout.rdbuf(std::cerr.rdbuf());
+        int codigo;
+        {
+            EmployeeManager manager(archivo, std::thread::hardware_concurrency());
+            codigo = escribirInforme(manager, formatoInforme);
+        }
+        if (!destinoMetricas.empty()) volcarMetricas(destinoMetricas);
+        return codigo;
+    }
+
+    if (!direccionServidor.empty()) {
+        int codigo;
+        {
+            EmployeeManager manager(archivo, std::thread::hardware_concurrency());
+            manager.setAutoguardado(std::chrono::seconds(autoguardado));
+            codigo = ejecutarServidor(manager, direccionServidor);
+        }
+        if (!destinoMetricas.empty()) volcarMetricas(destinoMetricas);
+        return codigo;
+    }
+
+    EmployeeManager manager(archivo, std::thread::hardware_concurrency());
+    manager.setAutoguardado(std::chrono::seconds(autoguardado));
 
     int opcion;
     bool continuar = true;
@@ -162,7 +361,11 @@ int main() {
                 break;
             case 9:
                 std::cout << "\n💾 Guardando datos...\n";
-                manager.guardarEnArchivo();
+                if (!manager.guardarEnArchivo()) {
+                    std::cout << "⚠️  Los cambios siguen en memoria; pruebe de nuevo.\n";
+                    break;
+                }
+                if (!destinoMetricas.empty()) volcarMetricas(destinoMetricas);
                 std::cout << "👋 ¡Hasta luego!\n\n";
                 continuar = false;
                 break;